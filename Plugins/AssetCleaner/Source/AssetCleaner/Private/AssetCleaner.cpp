@@ -12,6 +12,7 @@
 #include "AssetViewUtils.h"
 #include "StatusBarSubsystem.h"
 #include "Subsystems/AssetCleanerSubsystem.h"
+#include "Libraries/MaterialStatsCache.h"
 
 #define LOCTEXT_NAMESPACE "FAssetCleanerModule"
 /* clang-format off */
@@ -83,6 +84,7 @@ TSharedRef<SDockTab> FAssetCleanerModule::CreateAssetCleanerTab(const TArray<TSh
 void FAssetCleanerModule::ShutdownModule()
 {
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner("AssetCleaner");
+	AssetCleaner::FMaterialStatsCache::SaveIfCreated();
 }
 
 void FAssetCleanerModule::OpenManagerTab()
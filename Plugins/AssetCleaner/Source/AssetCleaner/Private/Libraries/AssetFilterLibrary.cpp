@@ -3,15 +3,63 @@
 
 #include "Libraries/AssetFilterLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Texture2D.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "MaterialEditingLibrary.h"
+#include "UObject/MetaData.h"
+#include "Libraries/MaterialStatsCache.h"
+#include "Settings/AssetCleanerSettings.h"
+
+namespace AssetCleaner::Private
+{
+	bool IsTexture2D(const FAssetData& Asset)
+	{
+		static const FTopLevelAssetPath Texture2DClassPath = UTexture2D::StaticClass()->GetClassPathName();
+		return Asset.AssetClassPath == Texture2DClassPath;
+	}
+
+	bool IsMaterialAsset(const FAssetData& Asset)
+	{
+		// Class paths are compared instead of IsInstanceOf so this stays usable on worker threads
+		static const FTopLevelAssetPath MaterialClassPath = UMaterial::StaticClass()->GetClassPathName();
+		static const FTopLevelAssetPath MaterialInstanceClassPath = UMaterialInstanceConstant::StaticClass()->GetClassPathName();
+		return Asset.AssetClassPath == MaterialClassPath || Asset.AssetClassPath == MaterialInstanceClassPath;
+	}
+
+	bool IsPowerOfTwo(int32 Value)
+	{
+		return Value > 0 && (Value & (Value - 1)) == 0;
+	}
+
+	/** Enables the loading fallback of a registry scan when the project settings allow it. */
+	void ConfigureLoadingFallback(const TSharedRef<FAssetScanTask>& ScanTask, FAssetScanTask::FScanPredicate LoadPredicate)
+	{
+		const UAssetCleanerSettings* Settings = GetDefault<UAssetCleanerSettings>();
+		if(Settings && Settings->bAllowLoadingFallback)
+		{
+			ScanTask->SetLoadingFallback(MoveTemp(LoadPredicate), Settings->LoadingFallbackBatchSize);
+		}
+	}
+}
 
 TSet<FName> AssetCleaner::FAssetFilterLibrary::AssetsWithMetadata{};
 TSet<FName> AssetCleaner::FAssetFilterLibrary::TexturesWithoutCompression{};
 TSet<FName> AssetCleaner::FAssetFilterLibrary::AssetsWithInvalidReferences{};
 TSet<FName> AssetCleaner::FAssetFilterLibrary::TexturesWithWrongSize{};
-TSet<FName> AssetCleaner::FAssetFilterLibrary::FilteredMaterials{};
+TSet<FName> AssetCleaner::FAssetFilterLibrary::MaterialsWithTooManyInstructions{};
+TSet<FName> AssetCleaner::FAssetFilterLibrary::MaterialsWithTooManyExpressions{};
+AssetCleaner::FAssetReferenceIndex AssetCleaner::FAssetFilterLibrary::ReferenceIndex{};
+AssetCleaner::FCircularReferenceIndex AssetCleaner::FAssetFilterLibrary::CircularReferences{};
 
 bool AssetCleaner::FAssetFilterLibrary::IsAssetUnreferenced(const FAssetData& Asset)
 {
+	const int32 PackageIndex = ReferenceIndex.FindIndexedPackage(Asset.PackageName);
+	if(PackageIndex != INDEX_NONE)
+	{
+		return ReferenceIndex.IsUnreferenced(PackageIndex);
+	}
+
 	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
 
 	TArray<FName> Referencers;
@@ -22,6 +70,12 @@ bool AssetCleaner::FAssetFilterLibrary::IsAssetUnreferenced(const FAssetData& As
 
 bool AssetCleaner::FAssetFilterLibrary::IsAssetWithMissingReferences(const FAssetData& Asset)
 {
+	const int32 PackageIndex = ReferenceIndex.FindIndexedPackage(Asset.PackageName);
+	if(PackageIndex != INDEX_NONE)
+	{
+		return ReferenceIndex.HasMissingReferences(PackageIndex);
+	}
+
 	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
 
 	TArray<FAssetDependency> Dependencies;
@@ -52,146 +106,227 @@ bool AssetCleaner::FAssetFilterLibrary::IsAssetWithMissingReferences(const FAsse
 	return false;
 }
 
-void AssetCleaner::FAssetFilterLibrary::CollectMetadata(const TArray<TSharedPtr<FAssetData>>& InAssetList)
+bool AssetCleaner::FAssetFilterLibrary::IsAssetInCircularReference(const FAssetData& Asset)
+{
+	return CircularReferences.FindCycle(Asset.PackageName) != INDEX_NONE;
+}
+
+TSharedRef<AssetCleaner::FAssetScanTask> AssetCleaner::FAssetFilterLibrary::CollectMetadata(const TArray<TSharedPtr<FAssetData>>& InAssetList)
 {
 	AssetsWithMetadata.Empty();
+	return FAssetScanTask::Create(TEXT("Assets With Metadata"), InAssetList, &HasMetadata, EAssetScanThread::GameThread, AssetsWithMetadata);
+}
 
-	FScopedSlowTask SlowTask(InAssetList.Num(), FText::FromString(TEXT("Collecting assets with metadata...")));
-	SlowTask.MakeDialog(true);
+TSharedRef<AssetCleaner::FAssetScanTask> AssetCleaner::FAssetFilterLibrary::CollectAssetsWithInvalidReferences(const TArray<TSharedPtr<FAssetData>>& InAssetList)
+{
+	AssetsWithInvalidReferences.Empty();
+	return FAssetScanTask::Create(TEXT("Assets With Invalid References"), InAssetList, &HasInvalidReferences, EAssetScanThread::AnyThread, AssetsWithInvalidReferences);
+}
 
-	for(const TSharedPtr<FAssetData>& Asset : InAssetList)
-	{
-		SlowTask.EnterProgressFrame(1);
+TSharedRef<AssetCleaner::FAssetScanTask> AssetCleaner::FAssetFilterLibrary::CollectTexturesWithoutCompression(const TArray<TSharedPtr<FAssetData>>& InAssetList)
+{
+	TexturesWithoutCompression.Empty();
 
-		if(!Asset.IsValid()) continue;
+	TSharedRef<FAssetScanTask> ScanTask = FAssetScanTask::Create(TEXT("Textures Without Compression"), InAssetList, &CheckTextureCompressionTags, TexturesWithoutCompression);
+	Private::ConfigureLoadingFallback(ScanTask, &IsTextureWithoutCompression);
+	return ScanTask;
+}
 
-		FSoftObjectPath SoftPath = Asset->ToSoftObjectPath();
-		UObject* LoadedObject = SoftPath.ResolveObject();
+TSharedRef<AssetCleaner::FAssetScanTask> AssetCleaner::FAssetFilterLibrary::CollectTexturesWithWrongSize(const TArray<TSharedPtr<FAssetData>>& InAssetList)
+{
+	TexturesWithWrongSize.Empty();
 
-		if(!LoadedObject)
-		{
-			LoadedObject = SoftPath.TryLoad();
-		}
+	TSharedRef<FAssetScanTask> ScanTask = FAssetScanTask::Create(TEXT("Textures With Wrong Size (PoTwo Check)"), InAssetList, &CheckTextureSizeTags, TexturesWithWrongSize);
+	Private::ConfigureLoadingFallback(ScanTask, &IsTextureWithWrongSize);
+	return ScanTask;
+}
 
-		if(!LoadedObject || LoadedObject->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad))
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Skipping %s  not fully loaded."), *Asset->GetObjectPathString());
-			continue;
-		}
+TSharedRef<AssetCleaner::FAssetScanTask> AssetCleaner::FAssetFilterLibrary::CollectMaterialsWithTooManyInstructions(const TArray<TSharedPtr<FAssetData>>& InAssetList)
+{
+	MaterialsWithTooManyInstructions.Empty();
 
-		if(const TMap<FName, FString>* MetaMap = UMetaData::GetMapForObject(LoadedObject))
-		{
-			if(MetaMap->Num() > 0)
-			{
-				AssetsWithMetadata.Add(Asset->PackageName);
-			}
-		}
-	}
+	TSharedRef<FAssetScanTask> ScanTask = FAssetScanTask::Create(TEXT("Materials With Too Many Instructions"), InAssetList, &CheckMaterialInstructionStats, MaterialsWithTooManyInstructions);
+	Private::ConfigureLoadingFallback(ScanTask, &IsMaterialWithTooManyInstructions);
+	return ScanTask;
+}
 
-	UE_LOG(LogTemp, Warning, TEXT("Found %d assets with metadata."), AssetsWithMetadata.Num());
+TSharedRef<AssetCleaner::FAssetScanTask> AssetCleaner::FAssetFilterLibrary::CollectMaterialsWithTooManyExpressions(const TArray<TSharedPtr<FAssetData>>& InAssetList)
+{
+	MaterialsWithTooManyExpressions.Empty();
+
+	TSharedRef<FAssetScanTask> ScanTask = FAssetScanTask::Create(TEXT("Materials With Too Many Expressions"), InAssetList, &CheckMaterialExpressionStats, MaterialsWithTooManyExpressions);
+	Private::ConfigureLoadingFallback(ScanTask, &IsMaterialWithTooManyExpressions);
+	return ScanTask;
 }
 
-void AssetCleaner::FAssetFilterLibrary::CollectAssetsWithInvalidReferences(const TArray<TSharedPtr<FAssetData>>& InAssetList)
+AssetCleaner::EAssetScanResult AssetCleaner::FAssetFilterLibrary::CheckTextureCompressionTags(const FAssetData& Asset)
 {
-	AssetsWithInvalidReferences.Empty();
+	if(!Private::IsTexture2D(Asset)) return EAssetScanResult::NoMatch;
 
-	FScopedSlowTask SlowTask(InAssetList.Num(), FText::FromString(TEXT("Checking assets for invalid references...")));
-	SlowTask.MakeDialog(true);
+	FString CompressionValue;
+	if(!Asset.GetTagValue(GET_MEMBER_NAME_CHECKED(UTexture, CompressionSettings), CompressionValue))
+	{
+		return EAssetScanResult::NeedsLoad;
+	}
 
-	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	const int64 Compression = StaticEnum<TextureCompressionSettings>()->GetValueByNameString(CompressionValue);
+	if(Compression == INDEX_NONE)
+	{
+		return EAssetScanResult::NeedsLoad;
+	}
+
+	return Compression == TextureCompressionSettings::TC_VectorDisplacementmap || Compression == TextureCompressionSettings::TC_Grayscale
+		? EAssetScanResult::Match
+		: EAssetScanResult::NoMatch;
+}
 
-	for(const TSharedPtr<FAssetData>& Asset : InAssetList)
+AssetCleaner::EAssetScanResult AssetCleaner::FAssetFilterLibrary::CheckTextureSizeTags(const FAssetData& Asset)
+{
+	if(!Private::IsTexture2D(Asset)) return EAssetScanResult::NoMatch;
+
+	// Texture2D exports its size as "<Width>x<Height>"
+	FString Dimensions;
+	FString WidthString;
+	FString HeightString;
+	if(!Asset.GetTagValue(TEXT("Dimensions"), Dimensions) || !Dimensions.Split(TEXT("x"), &WidthString, &HeightString))
 	{
-		SlowTask.EnterProgressFrame(1.f);
+		return EAssetScanResult::NeedsLoad;
+	}
 
-		if(!Asset.IsValid()) continue;
+	const int32 Width = FCString::Atoi(*WidthString);
+	const int32 Height = FCString::Atoi(*HeightString);
 
-		TArray<FAssetIdentifier> References;
-		AssetRegistry.GetReferencers(Asset->GetPrimaryAssetId(),
-			References, UE::AssetRegistry::EDependencyCategory::All);
+	return !Private::IsPowerOfTwo(Width) || !Private::IsPowerOfTwo(Height)
+		? EAssetScanResult::Match
+		: EAssetScanResult::NoMatch;
+}
 
-		for(const FAssetIdentifier& Ref : References)
-		{
-			// ignore self-reference
-			if(Ref == Asset->GetPrimaryAssetId()) continue;
-
-			FString PackageName = Ref.PackageName.ToString();
-			if(!FPackageName::DoesPackageExist(PackageName))
-			{
-				AssetsWithInvalidReferences.Add(Asset->PackageName);
-				break;
-			}
-		}
+AssetCleaner::EAssetScanResult AssetCleaner::FAssetFilterLibrary::CheckMaterialInstructionStats(const FAssetData& Asset)
+{
+	if(!Private::IsMaterialAsset(Asset)) return EAssetScanResult::NoMatch;
+
+	FMaterialStatsCache::FEntry Entry;
+	if(!FMaterialStatsCache::Get().Find(Asset.PackageName, Entry) || Entry.NumPixelShaderInstructions == INDEX_NONE)
+	{
+		return EAssetScanResult::NeedsLoad;
 	}
 
+	return Entry.NumVertexShaderInstructions > MaterialInstructionLimit || Entry.NumPixelShaderInstructions > MaterialInstructionLimit
+		? EAssetScanResult::Match
+		: EAssetScanResult::NoMatch;
 }
 
-void AssetCleaner::FAssetFilterLibrary::CollectTexturesWithoutCompression(const TArray<TSharedPtr<FAssetData>>& InAssetList)
+AssetCleaner::EAssetScanResult AssetCleaner::FAssetFilterLibrary::CheckMaterialExpressionStats(const FAssetData& Asset)
 {
-	TexturesWithoutCompression.Empty();
+	static const FTopLevelAssetPath MaterialClassPath = UMaterial::StaticClass()->GetClassPathName();
+	if(Asset.AssetClassPath != MaterialClassPath) return EAssetScanResult::NoMatch;
 
-	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
-	FTopLevelAssetPath TextureClassPath(TEXT("/Script/Engine.Texture2D"));
+	FMaterialStatsCache::FEntry Entry;
+	if(!FMaterialStatsCache::Get().Find(Asset.PackageName, Entry) || Entry.NumExpressions == INDEX_NONE)
+	{
+		return EAssetScanResult::NeedsLoad;
+	}
 
-	TArray<FAssetData> AllTextures;
-	AssetRegistry.GetAssetsByClass(TextureClassPath, AllTextures);
+	return Entry.NumExpressions > MaterialExpressionLimit ? EAssetScanResult::Match : EAssetScanResult::NoMatch;
+}
 
-	FScopedSlowTask SlowTask(AllTextures.Num(), FText::FromString(TEXT("Scanning Textures Without Compression...")));
-	SlowTask.MakeDialog(true);
+bool AssetCleaner::FAssetFilterLibrary::HasMetadata(const FAssetData& Asset)
+{
+	FSoftObjectPath SoftPath = Asset.ToSoftObjectPath();
+	UObject* LoadedObject = SoftPath.ResolveObject();
 
-	for(const FAssetData& TextureAsset : AllTextures)
+	if(!LoadedObject)
 	{
-		SlowTask.EnterProgressFrame(1.f, FText::FromString(TextureAsset.AssetName.ToString()));
+		LoadedObject = SoftPath.TryLoad();
+	}
 
-		if(UTexture2D* Texture2D = Cast<UTexture2D>(TextureAsset.GetAsset()))
-		{
-			if(Texture2D->CompressionSettings == TextureCompressionSettings::TC_VectorDisplacementmap ||
-				Texture2D->CompressionSettings == TextureCompressionSettings::TC_Grayscale)
-			{
-				TexturesWithoutCompression.Add(TextureAsset.PackageName);
-			}
-		}
+	if(!LoadedObject || LoadedObject->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Skipping %s - not fully loaded."), *Asset.GetObjectPathString());
+		return false;
 	}
 
+	const TMap<FName, FString>* MetaMap = UMetaData::GetMapForObject(LoadedObject);
+	return MetaMap && MetaMap->Num() > 0;
 }
 
-void AssetCleaner::FAssetFilterLibrary::CollectTexturesWithWrongSize(const TArray<TSharedPtr<FAssetData>>& InAssetList)
+bool AssetCleaner::FAssetFilterLibrary::HasInvalidReferences(const FAssetData& Asset)
 {
-	TexturesWithWrongSize.Empty();
+	// Runs on worker threads: the module manager is game thread only, the registry singleton is not
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FAssetIdentifier> References;
+	AssetRegistry.GetReferencers(Asset.GetPrimaryAssetId(),
+		References, UE::AssetRegistry::EDependencyCategory::All);
 
-	TArray<TSharedPtr<FAssetData>> TextureAssets;
-	for(const TSharedPtr<FAssetData>& Asset : InAssetList)
+	for(const FAssetIdentifier& Ref : References)
 	{
-		if(Asset.IsValid() && Asset->AssetClassPath == UTexture2D::StaticClass()->GetClassPathName())
+		// ignore self-reference
+		if(Ref == Asset.GetPrimaryAssetId()) continue;
+
+		FString PackageName = Ref.PackageName.ToString();
+		if(!FPackageName::DoesPackageExist(PackageName))
 		{
-			TextureAssets.Add(Asset);
+			return true;
 		}
 	}
 
-	FScopedSlowTask SlowTask(TextureAssets.Num(), FText::FromString(TEXT("Scanning textures with wrong size (Non-Po2)...")));
-	SlowTask.MakeDialog(true);
+	return false;
+}
 
-	auto IsPowerOfTwo = [] (int32 Value) -> bool {
-		return Value > 0 && (Value & (Value - 1)) == 0;
-		};
+bool AssetCleaner::FAssetFilterLibrary::IsTextureWithoutCompression(const FAssetData& Asset)
+{
+	if(!Private::IsTexture2D(Asset)) return false;
 
-	for(const TSharedPtr<FAssetData>& Asset : TextureAssets)
+	if(UTexture2D* Texture2D = Cast<UTexture2D>(Asset.GetAsset()))
 	{
-		SlowTask.EnterProgressFrame(1);
+		return Texture2D->CompressionSettings == TextureCompressionSettings::TC_VectorDisplacementmap ||
+			Texture2D->CompressionSettings == TextureCompressionSettings::TC_Grayscale;
+	}
 
-		UObject* LoadedObject = Asset->GetAsset();
-		if(!LoadedObject) continue;
+	return false;
+}
 
-		if(UTexture2D* Texture = Cast<UTexture2D>(LoadedObject))
-		{
-			int32 Width = Texture->GetSizeX();
-			int32 Height = Texture->GetSizeY();
+bool AssetCleaner::FAssetFilterLibrary::IsTextureWithWrongSize(const FAssetData& Asset)
+{
+	if(!Private::IsTexture2D(Asset)) return false;
 
-			if(!IsPowerOfTwo(Width) || !IsPowerOfTwo(Height))
-			{
-				TexturesWithWrongSize.Add(Asset->PackageName);
-			}
-		}
+	if(UTexture2D* Texture = Cast<UTexture2D>(Asset.GetAsset()))
+	{
+		return !Private::IsPowerOfTwo(Texture->GetSizeX()) || !Private::IsPowerOfTwo(Texture->GetSizeY());
 	}
 
+	return false;
+}
+
+bool AssetCleaner::FAssetFilterLibrary::IsMaterialWithTooManyInstructions(const FAssetData& Asset)
+{
+	if(!Private::IsMaterialAsset(Asset)) return false;
+
+	UMaterialInterface* MaterialInterface = Cast<UMaterialInterface>(Asset.GetAsset());
+	if(!MaterialInterface) return false;
+
+	const FMaterialStatistics MaterialStats = UMaterialEditingLibrary::GetStatistics(MaterialInterface);
+
+	FMaterialStatsCache::FEntry Entry;
+	Entry.NumVertexShaderInstructions = MaterialStats.NumVertexShaderInstructions;
+	Entry.NumPixelShaderInstructions = MaterialStats.NumPixelShaderInstructions;
+	FMaterialStatsCache::Get().Store(Asset.PackageName, Entry);
+
+	return (MaterialStats.NumVertexShaderInstructions > MaterialInstructionLimit) ||
+		(MaterialStats.NumPixelShaderInstructions > MaterialInstructionLimit);
+}
+
+bool AssetCleaner::FAssetFilterLibrary::IsMaterialWithTooManyExpressions(const FAssetData& Asset)
+{
+	if(Asset.AssetClassPath != UMaterial::StaticClass()->GetClassPathName()) return false;
+
+	UMaterial* Material = Cast<UMaterial>(Asset.GetAsset());
+	if(!Material) return false;
+
+	FMaterialStatsCache::FEntry Entry;
+	Entry.NumExpressions = UMaterialEditingLibrary::GetNumMaterialExpressions(Material);
+	FMaterialStatsCache::Get().Store(Asset.PackageName, Entry);
+
+	return Entry.NumExpressions > MaterialExpressionLimit;
 }
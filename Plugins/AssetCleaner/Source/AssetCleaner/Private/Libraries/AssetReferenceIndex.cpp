@@ -0,0 +1,236 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Libraries/AssetReferenceIndex.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(AssetReferenceIndexLog, All, All)
+
+namespace AssetCleaner::Private
+{
+	const UE::AssetRegistry::FDependencyQuery HardDependencyQuery(UE::AssetRegistry::EDependencyQuery::Hard);
+}
+
+void AssetCleaner::FAssetReferenceIndex::Build(const TArray<TSharedPtr<FAssetData>>& InAssetList)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FAssetReferenceIndex::Build);
+	const double StartTime = FPlatformTime::Seconds();
+
+	Reset();
+
+	for(const TSharedPtr<FAssetData>& Asset : InAssetList)
+	{
+		if(Asset.IsValid())
+		{
+			FindOrAddPackage(Asset->PackageName);
+		}
+	}
+	NumIndexed = PackageNames.Num();
+
+	// Registry queries dominate the build and are safe to run concurrently
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	TArray<TArray<FName>> DependencyNames;
+	DependencyNames.SetNum(NumIndexed);
+	NumReferencers.SetNumZeroed(NumIndexed);
+
+	ParallelFor(NumIndexed, [this, &AssetRegistry, &DependencyNames] (int32 Index)
+		{
+			TArray<FName> Referencers;
+			AssetRegistry.GetReferencers(PackageNames[Index], Referencers);
+			NumReferencers[Index] = Referencers.Num();
+
+			AssetRegistry.GetDependencies(PackageNames[Index], DependencyNames[Index],
+				UE::AssetRegistry::EDependencyCategory::Package, Private::HardDependencyQuery);
+		});
+
+	DependencyOffsets.Reserve(NumIndexed + 1);
+	DependencyOffsets.Add(0);
+	for(int32 Index = 0; Index < NumIndexed; ++Index)
+	{
+		for(const FName& DependencyName : DependencyNames[Index])
+		{
+			Dependencies.Add(FindOrAddPackage(DependencyName));
+		}
+		DependencyOffsets.Add(Dependencies.Num());
+	}
+
+	// Existence is resolved once per distinct package instead of once per edge
+	const int32 NumPackages = PackageNames.Num();
+	TArray<bool> PackageExists;
+	PackageExists.SetNumZeroed(NumPackages);
+	ParallelFor(NumPackages, [this, &PackageExists] (int32 Index)
+		{
+			PackageExists[Index] = PackageHasAssets(PackageNames[Index], true);
+		});
+
+	// In-memory lookups are not allowed from the workers; recheck the few misses here so unsaved assets still count
+	for(int32 Index = 0; Index < NumPackages; ++Index)
+	{
+		if(!PackageExists[Index])
+		{
+			PackageExists[Index] = PackageHasAssets(PackageNames[Index]);
+		}
+	}
+
+	HasMissingDependency.Init(false, NumIndexed);
+	TArray<int32> NumDependents;
+	NumDependents.SetNumZeroed(NumPackages);
+
+	for(int32 Index = 0; Index < NumIndexed; ++Index)
+	{
+		for(int32 Edge = DependencyOffsets[Index]; Edge < DependencyOffsets[Index + 1]; ++Edge)
+		{
+			const int32 Dependency = Dependencies[Edge];
+			++NumDependents[Dependency];
+
+			if(!PackageExists[Dependency])
+			{
+				HasMissingDependency[Index] = true;
+			}
+		}
+	}
+
+	// Reverse edges: prefix sums give the offsets, then every edge is scattered into its slot
+	DependentOffsets.SetNumUninitialized(NumPackages + 1);
+	DependentOffsets[0] = 0;
+	for(int32 Index = 0; Index < NumPackages; ++Index)
+	{
+		DependentOffsets[Index + 1] = DependentOffsets[Index] + NumDependents[Index];
+	}
+
+	Dependents.SetNumUninitialized(Dependencies.Num());
+	TArray<int32> WriteCursor(DependentOffsets.GetData(), NumPackages);
+	for(int32 Index = 0; Index < NumIndexed; ++Index)
+	{
+		for(int32 Edge = DependencyOffsets[Index]; Edge < DependencyOffsets[Index + 1]; ++Edge)
+		{
+			Dependents[WriteCursor[Dependencies[Edge]]++] = Index;
+		}
+	}
+
+	UE_LOG(AssetReferenceIndexLog, Log, TEXT("Indexed %d packages (%d known, %d dependencies) in %.2f ms"),
+		NumIndexed, NumPackages, Dependencies.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void AssetCleaner::FAssetReferenceIndex::Reset()
+{
+	PackageNames.Reset();
+	PackageToIndex.Reset();
+	NumIndexed = 0;
+	DependencyOffsets.Reset();
+	Dependencies.Reset();
+	DependentOffsets.Reset();
+	Dependents.Reset();
+	NumReferencers.Reset();
+	HasMissingDependency.Empty();
+	RefreshedDependencies.Reset();
+}
+
+int32 AssetCleaner::FAssetReferenceIndex::FindIndexedPackage(FName PackageName) const
+{
+	const int32* Index = PackageToIndex.Find(PackageName);
+	return Index && *Index < NumIndexed ? *Index : INDEX_NONE;
+}
+
+void AssetCleaner::FAssetReferenceIndex::OnPackageChanged(FName PackageName)
+{
+	if(NumIndexed == 0) return;
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TSet<FName> Affected;
+	Affected.Add(PackageName);
+
+	// Current registry state: referencers lose or gain a dependency, dependencies lose or gain a referencer
+	TArray<FName> LiveNeighbours;
+	AssetRegistry.GetReferencers(PackageName, LiveNeighbours);
+	AssetRegistry.GetDependencies(PackageName, LiveNeighbours, UE::AssetRegistry::EDependencyCategory::Package, Private::HardDependencyQuery);
+	Affected.Append(LiveNeighbours);
+
+	// Previous state: on removal the registry no longer knows the edges of the package
+	if(const int32* Index = PackageToIndex.Find(PackageName))
+	{
+		if(*Index < NumIndexed)
+		{
+			for(int32 Edge = DependencyOffsets[*Index]; Edge < DependencyOffsets[*Index + 1]; ++Edge)
+			{
+				Affected.Add(PackageNames[Dependencies[Edge]]);
+			}
+		}
+
+		if(*Index + 1 < DependentOffsets.Num())
+		{
+			for(int32 Edge = DependentOffsets[*Index]; Edge < DependentOffsets[*Index + 1]; ++Edge)
+			{
+				Affected.Add(PackageNames[Dependents[Edge]]);
+			}
+		}
+	}
+
+	if(const TArray<FName>* RefreshedNames = RefreshedDependencies.Find(PackageName))
+	{
+		Affected.Append(*RefreshedNames);
+	}
+
+	for(const auto& Pair : RefreshedDependencies)
+	{
+		if(Pair.Value.Contains(PackageName))
+		{
+			Affected.Add(Pair.Key);
+		}
+	}
+
+	for(const FName& AffectedName : Affected)
+	{
+		const int32 Index = FindIndexedPackage(AffectedName);
+		if(Index != INDEX_NONE)
+		{
+			RefreshIndexedPackage(Index);
+		}
+	}
+}
+
+void AssetCleaner::FAssetReferenceIndex::RefreshIndexedPackage(int32 PackageIndex)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	const FName PackageName = PackageNames[PackageIndex];
+
+	TArray<FName> Referencers;
+	AssetRegistry.GetReferencers(PackageName, Referencers);
+	NumReferencers[PackageIndex] = Referencers.Num();
+
+	TArray<FName>& DependencyNames = RefreshedDependencies.FindOrAdd(PackageName);
+	DependencyNames.Reset();
+	AssetRegistry.GetDependencies(PackageName, DependencyNames, UE::AssetRegistry::EDependencyCategory::Package, Private::HardDependencyQuery);
+
+	bool bHasMissingDependency = false;
+	for(const FName& DependencyName : DependencyNames)
+	{
+		if(!PackageHasAssets(DependencyName))
+		{
+			bHasMissingDependency = true;
+			break;
+		}
+	}
+	HasMissingDependency[PackageIndex] = bHasMissingDependency;
+}
+
+int32 AssetCleaner::FAssetReferenceIndex::FindOrAddPackage(FName PackageName)
+{
+	if(const int32* Index = PackageToIndex.Find(PackageName))
+	{
+		return *Index;
+	}
+
+	const int32 Index = PackageNames.Add(PackageName);
+	PackageToIndex.Add(PackageName, Index);
+	return Index;
+}
+
+bool AssetCleaner::FAssetReferenceIndex::PackageHasAssets(FName PackageName, bool bIncludeOnlyOnDiskAssets)
+{
+	TArray<FAssetData> PackageAssets;
+	IAssetRegistry::GetChecked().GetAssetsByPackageName(PackageName, PackageAssets, bIncludeOnlyOnDiskAssets);
+	return PackageAssets.Num() > 0;
+}
@@ -0,0 +1,282 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Libraries/AssetScanTask.h"
+#include "Tasks/Task.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(AssetScanTaskLog, All, All)
+
+TSharedRef<AssetCleaner::FAssetScanTask> AssetCleaner::FAssetScanTask::Create(const FString& InScanName, const TArray<TSharedPtr<FAssetData>>& InAssetList, FScanPredicate InPredicate, EAssetScanThread InThread, TSet<FName>& InTargetSet)
+{
+	FRegistryPredicate RegistryPredicate = [Predicate = MoveTemp(InPredicate)] (const FAssetData& Asset)
+		{
+			return Predicate(Asset) ? EAssetScanResult::Match : EAssetScanResult::NoMatch;
+		};
+
+	TSharedRef<FAssetScanTask> ScanTask = Create(InScanName, InAssetList, MoveTemp(RegistryPredicate), InTargetSet);
+	ScanTask->Thread = InThread;
+
+	return ScanTask;
+}
+
+TSharedRef<AssetCleaner::FAssetScanTask> AssetCleaner::FAssetScanTask::Create(const FString& InScanName, const TArray<TSharedPtr<FAssetData>>& InAssetList, FRegistryPredicate InPredicate, TSet<FName>& InTargetSet)
+{
+	TSharedRef<FAssetScanTask> ScanTask = MakeShareable(new FAssetScanTask(InScanName, EAssetScanThread::AnyThread, InTargetSet));
+
+	ScanTask->State->Assets.Reserve(InAssetList.Num());
+	for(const TSharedPtr<FAssetData>& Asset : InAssetList)
+	{
+		if(Asset.IsValid())
+		{
+			ScanTask->State->Assets.Add(Asset);
+		}
+	}
+	ScanTask->State->Predicate = MoveTemp(InPredicate);
+
+	return ScanTask;
+}
+
+AssetCleaner::FAssetScanTask::FAssetScanTask(const FString& InScanName, EAssetScanThread InThread, TSet<FName>& InTargetSet)
+	: ScanName(InScanName)
+	, Thread(InThread)
+	, TargetSet(InTargetSet)
+	, State(MakeShared<FSharedState, ESPMode::ThreadSafe>())
+{
+}
+
+void AssetCleaner::FAssetScanTask::SetLoadingFallback(FScanPredicate InLoadPredicate, int32 InBatchSize)
+{
+	check(!bStarted);
+
+	LoadPredicate = MoveTemp(InLoadPredicate);
+	LoadBatchSize = FMath::Max(1, InBatchSize);
+	State->bHasLoadingFallback = true;
+}
+
+AssetCleaner::FAssetScanTask::~FAssetScanTask()
+{
+	State->bCancelled = true;
+
+	if(TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+void AssetCleaner::FAssetScanTask::Start()
+{
+	check(IsInGameThread());
+
+	if(bStarted) return;
+	bStarted = true;
+
+	UE_LOG(AssetScanTaskLog, Log, TEXT("Scan '%s' started: %d assets on %s."), *ScanName, State->Assets.Num(),
+		Thread == EAssetScanThread::AnyThread ? TEXT("worker threads") : TEXT("game thread"));
+
+	if(Thread == EAssetScanThread::AnyThread)
+	{
+		LaunchWorkerTasks();
+	}
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FAssetScanTask::Tick));
+}
+
+void AssetCleaner::FAssetScanTask::Cancel()
+{
+	State->bCancelled = true;
+}
+
+float AssetCleaner::FAssetScanTask::GetProgress() const
+{
+	// Deferred assets are evaluated twice: once from the registry, once by the loading fallback
+	const int32 NumSteps = State->Assets.Num() + (State->bHasLoadingFallback ? State->NumDeferred.load() : 0);
+	const int32 NumDone = State->NumProcessed.load() + NumLoaded;
+	return NumSteps == 0 ? 1.0f : static_cast<float>(NumDone) / NumSteps;
+}
+
+void AssetCleaner::FAssetScanTask::LaunchWorkerTasks()
+{
+	const int32 NumAssets = State->Assets.Num();
+
+	for(int32 ChunkStart = 0; ChunkStart < NumAssets; ChunkStart += ChunkSize)
+	{
+		const int32 ChunkEnd = FMath::Min(ChunkStart + ChunkSize, NumAssets);
+
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [SharedState = State, ChunkStart, ChunkEnd] ()
+			{
+				if(SharedState->bCancelled) return;
+
+				TArray<TSharedPtr<FAssetData>> Matches;
+				for(int32 Index = ChunkStart; Index < ChunkEnd; ++Index)
+				{
+					const TSharedPtr<FAssetData>& Asset = SharedState->Assets[Index];
+					const EAssetScanResult Result = SharedState->Predicate(*Asset);
+
+					if(Result == EAssetScanResult::Match)
+					{
+						Matches.Add(Asset);
+					}
+					else if(Result == EAssetScanResult::NeedsLoad)
+					{
+						if(SharedState->bHasLoadingFallback)
+						{
+							SharedState->DeferredAssets.Enqueue(Asset);
+						}
+						++SharedState->NumDeferred;
+					}
+				}
+
+				if(Matches.Num() > 0)
+				{
+					SharedState->CompletedChunks.Enqueue(MoveTemp(Matches));
+				}
+				SharedState->NumProcessed += ChunkEnd - ChunkStart;
+			});
+	}
+}
+
+void AssetCleaner::FAssetScanTask::ProcessGameThreadSlice()
+{
+	const double SliceEnd = FPlatformTime::Seconds() + GameThreadBudgetSeconds;
+	const int32 NumAssets = State->Assets.Num();
+
+	TArray<TSharedPtr<FAssetData>> Matches;
+
+	// At least one asset per tick, so a single slow load cannot stall the scan
+	do
+	{
+		if(NextGameThreadIndex >= NumAssets || State->bCancelled) break;
+
+		const TSharedPtr<FAssetData>& Asset = State->Assets[NextGameThreadIndex++];
+		if(State->Predicate(*Asset) == EAssetScanResult::Match)
+		{
+			Matches.Add(Asset);
+		}
+		++State->NumProcessed;
+	}
+	while(FPlatformTime::Seconds() < SliceEnd);
+
+	if(Matches.Num() > 0)
+	{
+		State->CompletedChunks.Enqueue(MoveTemp(Matches));
+	}
+}
+
+void AssetCleaner::FAssetScanTask::ProcessLoadingFallbackSlice()
+{
+	const double SliceEnd = FPlatformTime::Seconds() + GameThreadBudgetSeconds;
+
+	TArray<TSharedPtr<FAssetData>> Matches;
+	TSharedPtr<FAssetData> Asset;
+
+	while(!State->bCancelled && FPlatformTime::Seconds() < SliceEnd && State->DeferredAssets.Dequeue(Asset))
+	{
+		if(LoadPredicate(*Asset))
+		{
+			Matches.Add(Asset);
+		}
+		++NumLoaded;
+
+		if(++NumLoadsInBatch >= LoadBatchSize)
+		{
+			FlushLoadedAssets();
+			break;
+		}
+	}
+
+	if(Matches.Num() > 0)
+	{
+		State->CompletedChunks.Enqueue(MoveTemp(Matches));
+	}
+}
+
+void AssetCleaner::FAssetScanTask::FlushLoadedAssets()
+{
+	if(NumLoadsInBatch == 0) return;
+
+	// Only package names are kept, so everything loaded by this batch that nothing else references can go
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	NumLoadsInBatch = 0;
+}
+
+bool AssetCleaner::FAssetScanTask::Tick(float DeltaTime)
+{
+	// Delegates below may release the last external reference to this scan
+	const TSharedRef<FAssetScanTask> KeepAlive = AsShared();
+
+	if(State->bCancelled)
+	{
+		Finish(true);
+		return false;
+	}
+
+	if(Thread == EAssetScanThread::GameThread)
+	{
+		ProcessGameThreadSlice();
+	}
+	else if(State->bHasLoadingFallback)
+	{
+		ProcessLoadingFallbackSlice();
+	}
+
+	TArray<TSharedPtr<FAssetData>> MatchedThisTick;
+	TArray<TSharedPtr<FAssetData>> Chunk;
+	while(State->CompletedChunks.Dequeue(Chunk))
+	{
+		MatchedThisTick.Append(MoveTemp(Chunk));
+	}
+
+	if(MatchedThisTick.Num() > 0)
+	{
+		for(const TSharedPtr<FAssetData>& Asset : MatchedThisTick)
+		{
+			TargetSet.Add(Asset->PackageName);
+		}
+
+		OnChunkCompleted.ExecuteIfBound(MatchedThisTick);
+	}
+
+	if(State->bCancelled)
+	{
+		Finish(true);
+		return false;
+	}
+
+	const bool bRegistryPassDone = State->NumProcessed.load() >= State->Assets.Num();
+	const bool bLoadingPassDone = !State->bHasLoadingFallback || NumLoaded >= State->NumDeferred.load();
+
+	if(bRegistryPassDone && bLoadingPassDone && State->CompletedChunks.IsEmpty())
+	{
+		Finish(false);
+		return false;
+	}
+
+	return true;
+}
+
+void AssetCleaner::FAssetScanTask::Finish(bool bWasCancelled)
+{
+	if(bFinished) return;
+	bFinished = true;
+
+	// Returning false from Tick removes the ticker, the handle is only kept for the destructor
+	TickerHandle.Reset();
+
+	if(State->bHasLoadingFallback)
+	{
+		FlushLoadedAssets();
+	}
+
+	UE_LOG(AssetScanTaskLog, Log, TEXT("Scan '%s' %s: %d matches."), *ScanName,
+		bWasCancelled ? TEXT("cancelled") : TEXT("finished"), TargetSet.Num());
+
+	if(!State->bHasLoadingFallback && State->NumDeferred.load() > 0)
+	{
+		UE_LOG(AssetScanTaskLog, Warning, TEXT("Scan '%s' skipped %d assets without registry data. Enable the loading fallback in AssetCleaner settings to include them."),
+			*ScanName, State->NumDeferred.load());
+	}
+
+	OnFinished.ExecuteIfBound(bWasCancelled);
+}
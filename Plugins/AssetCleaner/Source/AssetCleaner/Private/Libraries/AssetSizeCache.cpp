@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Libraries/AssetSizeCache.h"
+#include "Async/Async.h"
+#include "Misc/PackageName.h"
+#include "Tasks/Task.h"
+
+DEFINE_LOG_CATEGORY_STATIC(AssetSizeCacheLog, All, All)
+
+AssetCleaner::FAssetSizeCache& AssetCleaner::FAssetSizeCache::Get()
+{
+	static FAssetSizeCache Instance;
+	return Instance;
+}
+
+bool AssetCleaner::FAssetSizeCache::Find(FName PackageName, int64& OutSize) const
+{
+	FReadScopeLock ReadLock(Lock);
+
+	const int64* Size = Sizes.Find(PackageName);
+	if(!Size) return false;
+
+	OutSize = *Size;
+	return true;
+}
+
+int64 AssetCleaner::FAssetSizeCache::GetSize(FName PackageName) const
+{
+	int64 Size = INDEX_NONE;
+	Find(PackageName, Size);
+	return Size;
+}
+
+int64 AssetCleaner::FAssetSizeCache::FindOrComputeSize(FName PackageName)
+{
+	int64 Size = INDEX_NONE;
+	if(Find(PackageName, Size)) return Size;
+
+	Size = StatPackageFile(PackageName);
+
+	FWriteScopeLock WriteLock(Lock);
+	Sizes.Add(PackageName, Size);
+	return Size;
+}
+
+void AssetCleaner::FAssetSizeCache::RequestSizes(TArray<FName> PackageNames, FSimpleDelegate OnCompleted)
+{
+	{
+		FReadScopeLock ReadLock(Lock);
+		PackageNames.RemoveAllSwap([this] (const FName& PackageName) { return Sizes.Contains(PackageName); });
+	}
+
+	if(PackageNames.Num() == 0) return;
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, PackageNames = MoveTemp(PackageNames), OnCompleted = MoveTemp(OnCompleted)] ()
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(FAssetSizeCache::RequestSizes);
+			const double StartTime = FPlatformTime::Seconds();
+
+			TArray<int64> PackageSizes;
+			PackageSizes.SetNumUninitialized(PackageNames.Num());
+			for(int32 Index = 0; Index < PackageNames.Num(); ++Index)
+			{
+				PackageSizes[Index] = StatPackageFile(PackageNames[Index]);
+			}
+
+			{
+				FWriteScopeLock WriteLock(Lock);
+				for(int32 Index = 0; Index < PackageNames.Num(); ++Index)
+				{
+					Sizes.Add(PackageNames[Index], PackageSizes[Index]);
+				}
+			}
+
+			UE_LOG(AssetSizeCacheLog, Verbose, TEXT("Cached sizes of %d packages in %.2f ms"),
+				PackageNames.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+			AsyncTask(ENamedThreads::GameThread, [OnCompleted] ()
+				{
+					OnCompleted.ExecuteIfBound();
+				});
+		});
+}
+
+void AssetCleaner::FAssetSizeCache::Invalidate(FName PackageName)
+{
+	FWriteScopeLock WriteLock(Lock);
+	Sizes.Remove(PackageName);
+}
+
+FString AssetCleaner::FAssetSizeCache::FormatSize(int64 SizeInBytes)
+{
+	if(SizeInBytes == INDEX_NONE)
+	{
+		return TEXT("Unknown");
+	}
+
+	const double SizeInKb = static_cast<double>(SizeInBytes) / 1024.0;
+	if(SizeInKb >= 1024)
+	{
+		const double SizeInMb = SizeInKb / 1024.0;
+		return FString::Printf(TEXT("%.1f Mb"), SizeInMb);
+	}
+
+	return FString::Printf(TEXT("%.1f Kb"), SizeInKb);
+}
+
+int64 AssetCleaner::FAssetSizeCache::StatPackageFile(FName PackageName)
+{
+	FString PackageFileName;
+	if(!FPackageName::DoesPackageExist(PackageName.ToString(), &PackageFileName))
+	{
+		return INDEX_NONE;
+	}
+
+	return IFileManager::Get().FileSize(*PackageFileName);
+}
@@ -0,0 +1,287 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Libraries/CircularReferenceIndex.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Misc/PackageName.h"
+#include "Tasks/Task.h"
+
+DEFINE_LOG_CATEGORY_STATIC(CircularReferenceIndexLog, All, All)
+
+void AssetCleaner::FCircularReferenceIndex::BuildAsync(TFunction<void()> OnCompleted)
+{
+	check(IsInGameThread());
+
+	PendingCallbacks.Add(MoveTemp(OnCompleted));
+	if(bIsBuilding) return;
+
+	bIsBuilding = true;
+	PackagesChangedWhileBuilding.Reset();
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [this] ()
+		{
+			TSharedRef<FGraph> NewGraph = MakeShared<FGraph>();
+			BuildGraph(*NewGraph);
+
+			AsyncTask(ENamedThreads::GameThread, [this, NewGraph] ()
+				{
+					Graph = MoveTemp(*NewGraph);
+					bIsValid = true;
+					bIsBuilding = false;
+
+					// Changes the registry reported during the build may not be in its graph
+					for(const FName& PackageName : PackagesChangedWhileBuilding)
+					{
+						OnPackageChanged(PackageName);
+					}
+					PackagesChangedWhileBuilding.Reset();
+
+					TArray<TFunction<void()>> Callbacks = MoveTemp(PendingCallbacks);
+					for(const TFunction<void()>& Callback : Callbacks)
+					{
+						Callback();
+					}
+				});
+		});
+}
+
+void AssetCleaner::FCircularReferenceIndex::BuildGraph(FGraph& OutGraph)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCircularReferenceIndex::BuildGraph);
+	const double StartTime = FPlatformTime::Seconds();
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	const auto FindOrAddNode = [&OutGraph] (FName PackageName) -> int32
+		{
+			if(const int32* Node = OutGraph.PackageToNode.Find(PackageName))
+			{
+				return *Node;
+			}
+
+			const int32 Node = OutGraph.NodePackageNames.Add(PackageName);
+			OutGraph.PackageToNode.Add(PackageName, Node);
+			return Node;
+		};
+
+	// In-memory assets can only be enumerated on the game thread, and their dependencies come from disk anyway
+	TArray<FAssetData> ProjectAssets;
+	AssetRegistry.GetAssetsByPath(TEXT("/Game"), ProjectAssets, true, true);
+	for(const FAssetData& Asset : ProjectAssets)
+	{
+		FindOrAddNode(Asset.PackageName);
+	}
+
+	// Discover the graph level by level; the registry queries of a level run concurrently
+	const UE::AssetRegistry::FDependencyQuery HardDependencyQuery(UE::AssetRegistry::EDependencyQuery::Hard);
+	TArray<TArray<FName>> DependencyNames;
+	int32 LevelBegin = 0;
+
+	while(LevelBegin < OutGraph.NodePackageNames.Num())
+	{
+		const int32 LevelEnd = OutGraph.NodePackageNames.Num();
+		DependencyNames.SetNum(LevelEnd);
+
+		ParallelFor(LevelEnd - LevelBegin, [&] (int32 Offset)
+			{
+				const int32 Node = LevelBegin + Offset;
+				AssetRegistry.GetDependencies(OutGraph.NodePackageNames[Node], DependencyNames[Node],
+					UE::AssetRegistry::EDependencyCategory::Package, HardDependencyQuery);
+			});
+
+		for(int32 Node = LevelBegin; Node < LevelEnd; ++Node)
+		{
+			for(const FName& DependencyName : DependencyNames[Node])
+			{
+				if(!FPackageName::IsScriptPackage(DependencyName.ToString()))
+				{
+					FindOrAddNode(DependencyName);
+				}
+			}
+		}
+
+		LevelBegin = LevelEnd;
+	}
+
+	const int32 NumNodes = OutGraph.NodePackageNames.Num();
+	OutGraph.NodeOffsets.Reserve(NumNodes + 1);
+	OutGraph.NodeOffsets.Add(0);
+
+	for(int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		for(const FName& DependencyName : DependencyNames[Node])
+		{
+			if(const int32* Dependency = OutGraph.PackageToNode.Find(DependencyName))
+			{
+				OutGraph.NodeEdges.Add(*Dependency);
+			}
+		}
+		OutGraph.NodeOffsets.Add(OutGraph.NodeEdges.Num());
+	}
+
+	TArray<TArray<int32>> Components;
+	FindCyclicComponents(OutGraph.NodeOffsets, OutGraph.NodeEdges, Components);
+
+	OutGraph.Cycles.Reserve(Components.Num());
+	for(const TArray<int32>& Component : Components)
+	{
+		const int32 CycleIndex = OutGraph.Cycles.AddDefaulted();
+		TArray<FName>& Members = OutGraph.Cycles[CycleIndex];
+		Members.Reserve(Component.Num());
+
+		for(const int32 Node : Component)
+		{
+			Members.Add(OutGraph.NodePackageNames[Node]);
+			OutGraph.PackageToCycle.Add(OutGraph.NodePackageNames[Node], CycleIndex);
+		}
+
+		Members.Sort(FNameLexicalLess());
+	}
+
+	UE_LOG(CircularReferenceIndexLog, Log, TEXT("Found %d circular reference groups in %d packages (%d dependencies) in %.2f ms"),
+		OutGraph.Cycles.Num(), NumNodes, OutGraph.NodeEdges.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void AssetCleaner::FCircularReferenceIndex::OnPackageChanged(FName PackageName)
+{
+	if(bIsBuilding)
+	{
+		PackagesChangedWhileBuilding.Add(PackageName);
+		return;
+	}
+
+	if(!bIsValid) return;
+
+	TArray<FName> DependencyNames;
+	IAssetRegistry::GetChecked().GetDependencies(PackageName, DependencyNames, UE::AssetRegistry::EDependencyCategory::Package,
+		UE::AssetRegistry::FDependencyQuery(UE::AssetRegistry::EDependencyQuery::Hard));
+
+	TSet<FName> CurrentDependencies;
+	for(const FName& DependencyName : DependencyNames)
+	{
+		if(!FPackageName::IsScriptPackage(DependencyName.ToString()))
+		{
+			CurrentDependencies.Add(DependencyName);
+		}
+	}
+
+	// A package the graph does not know can only close a cycle through dependencies of its own
+	const int32* Node = Graph.PackageToNode.Find(PackageName);
+	if(!Node)
+	{
+		bIsValid = CurrentDependencies.Num() == 0;
+		return;
+	}
+
+	TSet<FName> BuiltDependencies;
+	for(int32 Edge = Graph.NodeOffsets[*Node]; Edge < Graph.NodeOffsets[*Node + 1]; ++Edge)
+	{
+		BuiltDependencies.Add(Graph.NodePackageNames[Graph.NodeEdges[Edge]]);
+	}
+
+	// Saves that keep the hard dependencies cannot change any cycle
+	if(CurrentDependencies.Num() != BuiltDependencies.Num() || !CurrentDependencies.Includes(BuiltDependencies))
+	{
+		bIsValid = false;
+	}
+}
+
+int32 AssetCleaner::FCircularReferenceIndex::FindCycle(FName PackageName) const
+{
+	const int32* CycleIndex = Graph.PackageToCycle.Find(PackageName);
+	return CycleIndex ? *CycleIndex : INDEX_NONE;
+}
+
+void AssetCleaner::FCircularReferenceIndex::FindCyclicComponents(const TArray<int32>& Offsets, const TArray<int32>& Edges, TArray<TArray<int32>>& OutComponents)
+{
+	const int32 NumNodes = Offsets.Num() - 1;
+
+	TArray<int32> DiscoveryIndex;
+	TArray<int32> LowLink;
+	DiscoveryIndex.Init(INDEX_NONE, NumNodes);
+	LowLink.Init(INDEX_NONE, NumNodes);
+	TBitArray<> OnStack(false, NumNodes);
+
+	TArray<int32> ComponentStack;
+
+	// Explicit call stack: the node being visited and the next edge to follow
+	struct FFrame
+	{
+		int32 Node;
+		int32 NextEdge;
+	};
+	TArray<FFrame> CallStack;
+	int32 NextDiscoveryIndex = 0;
+
+	const auto Visit = [&] (int32 Node)
+		{
+			DiscoveryIndex[Node] = NextDiscoveryIndex;
+			LowLink[Node] = NextDiscoveryIndex;
+			++NextDiscoveryIndex;
+
+			ComponentStack.Push(Node);
+			OnStack[Node] = true;
+			CallStack.Add({ Node, Offsets[Node] });
+		};
+
+	for(int32 Root = 0; Root < NumNodes; ++Root)
+	{
+		if(DiscoveryIndex[Root] != INDEX_NONE) continue;
+
+		Visit(Root);
+
+		while(CallStack.Num() > 0)
+		{
+			const int32 FrameIndex = CallStack.Num() - 1;
+			const int32 Node = CallStack[FrameIndex].Node;
+
+			if(CallStack[FrameIndex].NextEdge < Offsets[Node + 1])
+			{
+				const int32 Successor = Edges[CallStack[FrameIndex].NextEdge++];
+
+				if(DiscoveryIndex[Successor] == INDEX_NONE)
+				{
+					Visit(Successor);
+				}
+				else if(OnStack[Successor])
+				{
+					LowLink[Node] = FMath::Min(LowLink[Node], DiscoveryIndex[Successor]);
+				}
+				continue;
+			}
+
+			CallStack.Pop(EAllowShrinking::No);
+
+			if(CallStack.Num() > 0)
+			{
+				const int32 Parent = CallStack.Last().Node;
+				LowLink[Parent] = FMath::Min(LowLink[Parent], LowLink[Node]);
+			}
+
+			if(LowLink[Node] != DiscoveryIndex[Node]) continue;
+
+			TArray<int32> Component;
+			int32 Member;
+			do
+			{
+				Member = ComponentStack.Pop(EAllowShrinking::No);
+				OnStack[Member] = false;
+				Component.Add(Member);
+			}
+			while(Member != Node);
+
+			bool bIsCycle = Component.Num() > 1;
+			for(int32 Edge = Offsets[Node]; !bIsCycle && Edge < Offsets[Node + 1]; ++Edge)
+			{
+				bIsCycle = Edges[Edge] == Node;
+			}
+
+			if(bIsCycle)
+			{
+				OutComponents.Add(MoveTemp(Component));
+			}
+		}
+	}
+}
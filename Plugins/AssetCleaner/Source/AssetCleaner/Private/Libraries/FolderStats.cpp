@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Libraries/FolderStats.h"
+#include "Libraries/AssetSizeCache.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Tasks/Task.h"
+
+DEFINE_LOG_CATEGORY_STATIC(FolderStatsLog, All, All)
+
+const AssetCleaner::FFolderStats& AssetCleaner::FFolderStatsSnapshot::FindStats(const FString& FolderPath) const
+{
+	static const FFolderStats EmptyStats;
+
+	const FFolderStats* Stats = StatsByPath.Find(FolderPath);
+	return Stats ? *Stats : EmptyStats;
+}
+
+TSharedRef<AssetCleaner::FFolderStatsSnapshot> AssetCleaner::FFolderStatsSnapshot::Build(const FString& InRootPath)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FFolderStatsSnapshot::Build);
+	const double StartTime = FPlatformTime::Seconds();
+
+	TSharedRef<FFolderStatsSnapshot> Snapshot = MakeShared<FFolderStatsSnapshot>();
+	Snapshot->RootPath = InRootPath;
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FString> FolderPaths;
+	AssetRegistry.GetSubPaths(InRootPath, FolderPaths, true);
+	FolderPaths.Add(InRootPath);
+
+	Snapshot->StatsByPath.Reserve(FolderPaths.Num());
+	for(const FString& FolderPath : FolderPaths)
+	{
+		Snapshot->StatsByPath.Add(FolderPath);
+		if(FolderPath != InRootPath)
+		{
+			Snapshot->SubPathsByPath.FindOrAdd(FPaths::GetPath(FolderPath)).Add(FolderPath);
+		}
+	}
+
+	// On-disk data only: in-memory lookups are not allowed off the game thread
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByPath(FName(*InRootPath), Assets, true, true);
+
+	TArray<FFolderStats> AssetStats;
+	AssetStats.SetNum(Assets.Num());
+
+	ParallelFor(Assets.Num(), [&Assets, &AssetStats, &AssetRegistry] (int32 Index)
+		{
+			const FAssetData& Asset = Assets[Index];
+
+			TArray<FName> Referencers;
+			AssetRegistry.GetReferencers(Asset.PackageName, Referencers);
+			Referencers.Remove(Asset.PackageName);
+
+			FFolderStats& Stats = AssetStats[Index];
+			Stats.NumAssetsTotal = 1;
+
+			if(Referencers.Num() > 0)
+			{
+				Stats.NumAssetsUsed = 1;
+			}
+			else
+			{
+				Stats.NumAssetsUnused = 1;
+				Stats.SizeAssetsUnused = FMath::Max<int64>(FAssetSizeCache::Get().FindOrComputeSize(Asset.PackageName), 0);
+			}
+		});
+
+	for(int32 Index = 0; Index < Assets.Num(); ++Index)
+	{
+		Snapshot->StatsByPath.FindOrAdd(Assets[Index].PackagePath.ToString()) += AssetStats[Index];
+	}
+
+	// Fold every folder into its parent, deepest level first, so each folder is visited once
+	TArray<TArray<const FString*>> FoldersByDepth;
+	for(const auto& Pair : Snapshot->StatsByPath)
+	{
+		int32 Depth = 0;
+		for(const TCHAR Character : Pair.Key)
+		{
+			Depth += Character == TEXT('/') ? 1 : 0;
+		}
+
+		if(FoldersByDepth.Num() <= Depth)
+		{
+			FoldersByDepth.SetNum(Depth + 1);
+		}
+		FoldersByDepth[Depth].Add(&Pair.Key);
+	}
+
+	for(int32 Depth = FoldersByDepth.Num() - 1; Depth > 0; --Depth)
+	{
+		for(const FString* FolderPath : FoldersByDepth[Depth])
+		{
+			if(*FolderPath == InRootPath) continue;
+
+			const FString ParentPath = FPaths::GetPath(*FolderPath);
+			if(FFolderStats* ParentStats = Snapshot->StatsByPath.Find(ParentPath))
+			{
+				*ParentStats += Snapshot->StatsByPath.FindChecked(*FolderPath);
+			}
+		}
+	}
+
+	UE_LOG(FolderStatsLog, Log, TEXT("Aggregated %d assets into %d folders in %.2f ms"),
+		Assets.Num(), Snapshot->StatsByPath.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return Snapshot;
+}
+
+void AssetCleaner::FFolderStatsSnapshot::BuildAsync(const FString& InRootPath, TFunction<void(TSharedRef<FFolderStatsSnapshot>)> OnCompleted)
+{
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [InRootPath, OnCompleted = MoveTemp(OnCompleted)] () mutable
+		{
+			TSharedRef<FFolderStatsSnapshot> Snapshot = Build(InRootPath);
+
+			AsyncTask(ENamedThreads::GameThread, [Snapshot, OnCompleted = MoveTemp(OnCompleted)] ()
+				{
+					OnCompleted(Snapshot);
+				});
+		});
+}
@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Libraries/MaterialStatsCache.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(MaterialStatsCacheLog, All, All)
+
+namespace MaterialStatsCache
+{
+	/** Set once the singleton is constructed, so shutdown can skip a cache nobody used. */
+	static std::atomic<bool> bIsCreated(false);
+}
+
+AssetCleaner::FMaterialStatsCache& AssetCleaner::FMaterialStatsCache::Get()
+{
+	static FMaterialStatsCache Instance;
+	return Instance;
+}
+
+AssetCleaner::FMaterialStatsCache::FMaterialStatsCache()
+{
+	Load();
+	MaterialStatsCache::bIsCreated = true;
+}
+
+void AssetCleaner::FMaterialStatsCache::SaveIfCreated()
+{
+	if(MaterialStatsCache::bIsCreated)
+	{
+		Get().Save();
+	}
+}
+
+bool AssetCleaner::FMaterialStatsCache::Find(FName PackageName, FEntry& OutEntry) const
+{
+	{
+		FReadScopeLock ReadLock(Lock);
+
+		const FEntry* Entry = Entries.Find(PackageName);
+		if(!Entry) return false;
+
+		OutEntry = *Entry;
+	}
+
+	return OutEntry.PackageTimestamp == GetPackageTimestamp(PackageName);
+}
+
+void AssetCleaner::FMaterialStatsCache::Store(FName PackageName, const FEntry& Entry)
+{
+	const FDateTime PackageTimestamp = GetPackageTimestamp(PackageName);
+
+	FWriteScopeLock WriteLock(Lock);
+
+	FEntry& CachedEntry = Entries.FindOrAdd(PackageName);
+	if(CachedEntry.PackageTimestamp != PackageTimestamp)
+	{
+		CachedEntry = FEntry();
+		CachedEntry.PackageTimestamp = PackageTimestamp;
+	}
+
+	if(Entry.NumVertexShaderInstructions != INDEX_NONE) CachedEntry.NumVertexShaderInstructions = Entry.NumVertexShaderInstructions;
+	if(Entry.NumPixelShaderInstructions != INDEX_NONE) CachedEntry.NumPixelShaderInstructions = Entry.NumPixelShaderInstructions;
+	if(Entry.NumExpressions != INDEX_NONE) CachedEntry.NumExpressions = Entry.NumExpressions;
+
+	bDirty = true;
+}
+
+void AssetCleaner::FMaterialStatsCache::Save()
+{
+	TArray<uint8> Bytes;
+
+	{
+		FWriteScopeLock WriteLock(Lock);
+		if(!bDirty) return;
+
+		FMemoryWriter Writer(Bytes);
+
+		int32 Version = CacheVersion;
+		int32 NumEntries = Entries.Num();
+		Writer << Version << NumEntries;
+
+		for(auto& Pair : Entries)
+		{
+			FString PackageName = Pair.Key.ToString();
+			Writer << PackageName << Pair.Value;
+		}
+
+		bDirty = false;
+	}
+
+	if(!FFileHelper::SaveArrayToFile(Bytes, *GetCacheFilename()))
+	{
+		UE_LOG(MaterialStatsCacheLog, Warning, TEXT("Failed to save material stats cache to %s"), *GetCacheFilename());
+	}
+}
+
+void AssetCleaner::FMaterialStatsCache::Load()
+{
+	TArray<uint8> Bytes;
+	if(!FFileHelper::LoadFileToArray(Bytes, *GetCacheFilename(), FILEREAD_Silent)) return;
+
+	FMemoryReader Reader(Bytes);
+
+	int32 Version = 0;
+	int32 NumEntries = 0;
+	Reader << Version << NumEntries;
+
+	if(Version != CacheVersion || NumEntries < 0)
+	{
+		UE_LOG(MaterialStatsCacheLog, Log, TEXT("Discarding material stats cache with version %d"), Version);
+		return;
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	Entries.Reserve(NumEntries);
+
+	for(int32 Index = 0; Index < NumEntries && !Reader.IsError(); ++Index)
+	{
+		FString PackageName;
+		FEntry Entry;
+		Reader << PackageName << Entry;
+
+		Entries.Add(FName(*PackageName), Entry);
+	}
+
+	if(Reader.IsError())
+	{
+		UE_LOG(MaterialStatsCacheLog, Warning, TEXT("Material stats cache is corrupted, starting from scratch"));
+		Entries.Reset();
+	}
+}
+
+FString AssetCleaner::FMaterialStatsCache::GetCacheFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("AssetCleaner") / TEXT("MaterialStats.bin");
+}
+
+FDateTime AssetCleaner::FMaterialStatsCache::GetPackageTimestamp(FName PackageName)
+{
+	FString Filename;
+	if(!FPackageName::DoesPackageExist(PackageName.ToString(), &Filename))
+	{
+		return FDateTime::MinValue();
+	}
+
+	return IFileManager::Get().GetTimeStamp(*Filename);
+}
@@ -112,8 +112,12 @@ TSharedRef<SWidget> SAssetCleanerTableRow::GenerateWidgetForColumn(const FName&
 	}
 	else if(ColumnId.IsEqual(AssetCleanerListColumns::ColumnID_DiskSize))
 	{
+		// Bound as an attribute so the row picks up the size once the background stat completes
 		return SNew(STextBlock)
-			.Text(FText::FromString(AssetCleaner::Private::GetAssetDiskSize(Item.ToSharedRef().Get())));
+			.Text_Lambda([AssetItem = Item] ()
+				{
+					return FText::FromString(AssetCleaner::Private::GetAssetDiskSize(*AssetItem));
+				});
 	}
 	else if(ColumnId.IsEqual(AssetCleanerListColumns::ColumnID_Path))
 	{
@@ -33,9 +33,13 @@
 #include "UI/SFilterContainerWidget.h"
 
 #include "Libraries/AssetFilterLibrary.h"
+#include "Libraries/AssetSizeCache.h"
+#include "Libraries/FolderStats.h"
 #include "Subsystems/AssetCleanerSubsystem.h"
 #include "UI/SFolderTreeItem.h"
 #include "AssetCleanerTypes.h"
+#include "Logging/MessageLog.h"
+#include "Misc/UObjectToken.h"
 
 DEFINE_LOG_CATEGORY_STATIC(SAssetCleanerWidgetLog, All, All)
 DEFINE_LOG_CATEGORY_STATIC(SAssetCleanerTableRowLog, All, All)
@@ -48,6 +52,7 @@ void SAssetCleanerWidget::Construct(const FArguments& InArgs)
 	bCanSupportFocus = true;
 	SelectedDirectory = InArgs._CurrentSelectedFolder;
 
+	SubscribeToAssetRegistryEvent();
 	LoadAssets();
 	UpdateFilteredAssetList();
 	InitializeAssetTypeComboBox(FilteredDataAssets);
@@ -176,8 +181,39 @@ void SAssetCleanerWidget::Construct(const FArguments& InArgs)
 		.FillHeight(0.6f)
 		.AutoHeight()
 		[
-			SNew(STextBlock)
-			.Text_Lambda([this] () { return GetSelectedTextBlockInfo(); })
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text_Lambda([this] () { return GetSelectedTextBlockInfo(); })
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(4.0f, 0.0f)
+			[
+				SNew(STextBlock)
+				.Text(this, &SAssetCleanerWidget::GetScanProgressText)
+				.Visibility(this, &SAssetCleanerWidget::GetScanProgressVisibility)
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("CancelScans", "Cancel"))
+				.ToolTipText(LOCTEXT("CancelScansTooltip", "Cancel running advanced filter scans"))
+				.Visibility(this, &SAssetCleanerWidget::GetScanProgressVisibility)
+				.OnClicked_Lambda([this] ()
+					{
+						CancelAllAdvancedFilterScans();
+						return FReply::Handled();
+					})
+			]
 		];
 
 	TSharedPtr<SSplitter> Splitter = 
@@ -254,6 +290,27 @@ void SAssetCleanerWidget::Construct(const FArguments& InArgs)
 
 }
 
+SAssetCleanerWidget::~SAssetCleanerWidget()
+{
+	if(const FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(AssetCleaner::ModuleName::AssetRegistry))
+	{
+		const auto SafeRemove = [&] (FDelegateHandle& Handle, auto&& Event)
+			{
+				if(Handle.IsValid())
+				{
+					Event.Remove(Handle);
+					Handle.Reset();
+				}
+			};
+
+		SafeRemove(AssetAddedDelegateHandle, AssetRegistryModule->Get().OnAssetAdded());
+		SafeRemove(AssetRemovedDelegateHandle, AssetRegistryModule->Get().OnAssetRemoved());
+		SafeRemove(AssetRenamedDelegateHandle, AssetRegistryModule->Get().OnAssetRenamed());
+		SafeRemove(AssetUpdateDelegateHandle, AssetRegistryModule->Get().OnAssetUpdated());
+		SafeRemove(FilesLoadedHandle, AssetRegistryModule->Get().OnFilesLoaded());
+	}
+}
+
 void SAssetCleanerWidget::InitializeColumns()
 {
 	ColumnOrder.Add(AssetCleanerListColumns::ColumnID_RC);
@@ -279,6 +336,14 @@ void SAssetCleanerWidget::OnTreeSelectionChanged(TSharedPtr<FAssetTreeFolderNode
 	}
 	
 	LoadAssets();
+
+	// Result sets were computed for the previous folder, rescan the active ones
+	CancelAllAdvancedFilterScans();
+	for(const FString& FilterName : ActiveAdvancedFilters)
+	{
+		LaunchAdvancedFilterScan(FilterName);
+	}
+
 	UpdateFilteredAssetList();
 	InitializeAssetTypeComboBox(FilteredDataAssets);
 }
@@ -288,87 +353,156 @@ void SAssetCleanerWidget::OnFilterChanged(const FString& FilterName, bool bIsEna
 {
 	UE_LOG(SAssetCleanerWidgetLog, Warning, TEXT("Filter Changed: %s -> %s"), *FilterName, bIsEnabled ? TEXT("Enabled") : TEXT("Disabled"));
 
-	using namespace AssetCleaner;
 	if(bIsEnabled)
 	{
 		ActiveAdvancedFilters.Add(FilterName);
-
-		if(FilterName == TEXT("Assets With Metadata"))
-		{
-			FAssetFilterLibrary::CollectMetadata(StoredAssetList);
-		}
-		if(FilterName == TEXT("Textures Without Compression"))
-		{
-			FAssetFilterLibrary::CollectTexturesWithoutCompression(StoredAssetList);
-		}
-		if(FilterName == TEXT("Assets With Invalid References"))
-		{
-			FAssetFilterLibrary::CollectAssetsWithInvalidReferences(StoredAssetList);
-		}
-		if(FilterName == TEXT("Textures With Wrong Size (PoTwo Check)"))
-		{
-			FAssetFilterLibrary::CollectTexturesWithWrongSize(StoredAssetList);
-			UpdateFilteredAssetList();
-			return;
-		}
-		if(FilterName == TEXT("Materials With Too Many Instructions"))
-		{
-			CollectMaterialsInfoManyInstruction();
-		}
-		if(FilterName == TEXT("Materials With Too Many Expressions"))
-		{
-			CollectMaterialsInfoManyExpression();
-		}
+		LaunchAdvancedFilterScan(FilterName);
 	}
 	else
 	{
 		ActiveAdvancedFilters.Remove(FilterName);
+		CancelAdvancedFilterScan(FilterName);
 	}
 
 	UpdateFilteredAssetList();
 }
 
-bool SAssetCleanerWidget::TreeItemContainsSearchText(const TSharedPtr<FAssetTreeFolderNode>& Item) const
+void SAssetCleanerWidget::LaunchAdvancedFilterScan(const FString& FilterName)
+{
+	const auto* Collector = AdvancedFilterCollectors.Find(FilterName);
+	if(!Collector) return;
+
+	CancelAdvancedFilterScan(FilterName);
+
+	TSharedRef<AssetCleaner::FAssetScanTask> ScanTask = (*Collector)(StoredAssetList);
+	ScanTask->OnChunkCompleted.BindSP(this, &SAssetCleanerWidget::OnAdvancedFilterScanChunk);
+	ScanTask->OnFinished.BindSP(this, &SAssetCleanerWidget::OnAdvancedFilterScanFinished, FilterName);
+	ActiveScans.Add(FilterName, ScanTask);
+
+	// Matches are only delivered from the core ticker, so the list can be rebuilt by the caller after this
+	ScanTask->Start();
+}
+
+void SAssetCleanerWidget::CancelAdvancedFilterScan(const FString& FilterName)
 {
-	TArray<FString> SubPaths;
-	UAssetCleanerSubsystem::GetAssetRegistryModule().Get().GetSubPaths(Item->FolderPath, SubPaths, true);
-	for(const auto& Path : SubPaths)
+	TSharedPtr<AssetCleaner::FAssetScanTask> ScanTask;
+	if(ActiveScans.RemoveAndCopyValue(FilterName, ScanTask) && ScanTask.IsValid())
 	{
-		if(Path.Contains(TreeSearchText.ToString()))
-		{
-			return true;
-		}
+		ScanTask->OnChunkCompleted.Unbind();
+		ScanTask->OnFinished.Unbind();
+		ScanTask->Cancel();
 	}
+}
 
-	return false;
+void SAssetCleanerWidget::CancelAllAdvancedFilterScans()
+{
+	TArray<FString> ScanNames;
+	ActiveScans.GetKeys(ScanNames);
+
+	for(const FString& ScanName : ScanNames)
+	{
+		CancelAdvancedFilterScan(ScanName);
+	}
 }
 
-bool SAssetCleanerWidget::TreeItemIsExpanded(const TSharedPtr<FAssetTreeFolderNode>& Item, const TSet<TSharedPtr<FAssetTreeFolderNode>>& CachedItems) const
+void SAssetCleanerWidget::OnAdvancedFilterScanChunk(const TArray<TSharedPtr<FAssetData>>& MatchedAssets)
 {
-	if(!TreeSearchText.IsEmpty() && TreeItemContainsSearchText(Item))
+	bool bListChanged = false;
+
+	for(const TSharedPtr<FAssetData>& Asset : MatchedAssets)
 	{
-		auto CurrentItem = Item;
-		while(CurrentItem.IsValid())
+		if(!Asset.IsValid() || DisplayedPackageNames.Contains(Asset->PackageName)) continue;
+		if(!PassesSearchAndTypeFilters(*Asset)) continue;
+
+		DisplayedPackageNames.Add(Asset->PackageName);
+		FilteredDataAssets.Add(Asset);
+		bListChanged = true;
+	}
+
+	if(bListChanged && AssetListView.IsValid())
+	{
+		AssetListView->RequestListRefresh();
+	}
+}
+
+void SAssetCleanerWidget::OnAdvancedFilterScanFinished(bool bWasCancelled, FString FilterName)
+{
+	ActiveScans.Remove(FilterName);
+
+	if(!bWasCancelled && CurrentSortColumn != NAME_None)
+	{
+		SortAssetList();
+	}
+
+	if(AssetListView.IsValid())
+	{
+		AssetListView->RequestListRefresh();
+	}
+}
+
+FText SAssetCleanerWidget::GetScanProgressText() const
+{
+	TArray<FString> ProgressEntries;
+	for(const auto& Pair : ActiveScans)
+	{
+		if(Pair.Value.IsValid() && Pair.Value->IsRunning())
 		{
-			CurrentItem->bIsExpanded = true;
-			TreeListView->SetItemExpansion(CurrentItem, CurrentItem->bIsExpanded);
-			CurrentItem = CurrentItem->Parent;
+			ProgressEntries.Add(FString::Printf(TEXT("%s %d%%"), *Pair.Key, FMath::FloorToInt(Pair.Value->GetProgress() * 100.0f)));
 		}
+	}
 
-		return true;
+	if(ProgressEntries.IsEmpty())
+	{
+		return FText::GetEmpty();
 	}
 
-	for(const auto& ExpandedItem : CachedItems)
+	return FText::FromString(FString::Printf(TEXT("Scanning: %s"), *FString::Join(ProgressEntries, TEXT(", "))));
+}
+
+EVisibility SAssetCleanerWidget::GetScanProgressVisibility() const
+{
+	return ActiveScans.IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible;
+}
+
+void SAssetCleanerWidget::UpdateTreeSearchMatches()
+{
+	TreeSearchMatches.Reset();
+
+	const FString SearchString = TreeSearchText.ToString();
+	if(SearchString.IsEmpty() || !FolderStats.IsValid()) return;
+
+	// Every matching folder marks its ancestors; the walk stops at the first ancestor already marked,
+	// so each folder is inserted at most once per query
+	for(const auto& Pair : FolderStats->StatsByPath)
 	{
-		if(!ExpandedItem.IsValid()) continue;
+		if(!Pair.Key.Contains(SearchString)) continue;
 
-		if(ExpandedItem->FolderPath.Equals(Item->FolderPath))
+		FString AncestorPath = FPaths::GetPath(Pair.Key);
+		while(!AncestorPath.IsEmpty())
 		{
-			return true;
+			bool bAlreadyMarked = false;
+			TreeSearchMatches.Add(AncestorPath, &bAlreadyMarked);
+			if(bAlreadyMarked) break;
+
+			AncestorPath = FPaths::GetPath(AncestorPath);
 		}
 	}
+}
 
-	return false;
+bool SAssetCleanerWidget::TreeItemContainsSearchText(const TSharedPtr<FAssetTreeFolderNode>& Item) const
+{
+	return TreeSearchMatches.Contains(Item->FolderPath);
+}
+
+bool SAssetCleanerWidget::TreeItemIsExpanded(const TSharedPtr<FAssetTreeFolderNode>& Item, const TSet<FString>& ExpandedPaths) const
+{
+	// Ancestors of a match contain the match too, so they are expanded before the item is reached
+	if(!TreeSearchText.IsEmpty() && TreeItemContainsSearchText(Item))
+	{
+		return true;
+	}
+
+	return ExpandedPaths.Contains(Item->FolderPath);
 }
 
 TSharedPtr<SWidget> SAssetCleanerWidget::GetTreeContextMenu()
@@ -397,7 +531,11 @@ void SAssetCleanerWidget::UpdateFolderTree()
 {
 	if(!TreeListView.IsValid()) return;
 
-	const FString PathContentDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir());
+	if(!FolderStats.IsValid())
+	{
+		RequestFolderStats();
+	}
+
 	RootItem.Reset();
 	RootItem = MakeShareable(new FAssetTreeFolderNode);
 	if(!RootItem.IsValid()) return;
@@ -405,28 +543,48 @@ void SAssetCleanerWidget::UpdateFolderTree()
 	TSet<TSharedPtr<FAssetTreeFolderNode>> CachedExpandedItems;
 	TreeListView->GetExpandedItems(CachedExpandedItems);
 
+	TSet<FString> ExpandedPaths;
+	ExpandedPaths.Reserve(CachedExpandedItems.Num());
+	for(const TSharedPtr<FAssetTreeFolderNode>& ExpandedItem : CachedExpandedItems)
+	{
+		if(ExpandedItem.IsValid())
+		{
+			ExpandedPaths.Add(ExpandedItem->FolderPath);
+		}
+	}
+
+	UpdateTreeSearchMatches();
+
+	const auto ApplyFolderStats = [this] (FAssetTreeFolderNode& Item)
+		{
+			if(!FolderStats.IsValid()) return;
+
+			const AssetCleaner::FFolderStats& Stats = FolderStats->FindStats(Item.FolderPath);
+			Item.NumAssetsTotal = Stats.NumAssetsTotal;
+			Item.NumAssetsUsed = Stats.NumAssetsUsed;
+			Item.NumAssetsUnused = Stats.NumAssetsUnused;
+			Item.SizeAssetsUnused = Stats.SizeAssetsUnused;
+			Item.bIsEmpty = Stats.NumAssetsTotal == 0;
+			Item.PercentageUnused = Item.NumAssetsTotal == 0 ? 0 : Item.NumAssetsUnused * 100.0f / Item.NumAssetsTotal;
+			Item.PercentageUnusedNormalized = FMath::GetMappedRangeValueClamped(FVector2D{ 0.0f, 100.0f }, FVector2D{ 0.0f, 1.0f }, Item.PercentageUnused);
+		};
 
 	RootItem->FolderPath = AssetCleaner::PathRoot.ToString();
 	RootItem->FolderName = TEXT("Content");
 	RootItem->bIsDev = false;
 	RootItem->bIsRoot = true;
-	RootItem->bIsEmpty = false;
 	//RootItem->bIsExcluded = UPjcSubsystem::FolderIsExcluded(PathContentDir);
 	RootItem->bIsExpanded = true;
 	RootItem->bIsVisible = true;
-	RootItem->NumAssetsTotal = 103223;// AssetsAll.Num();
-	RootItem->NumAssetsUsed = 233;// AssetsUsed.Num();
-	RootItem->NumAssetsUnused = 7232;// AssetsUnused.Num();
-	RootItem->SizeAssetsUnused = 6334;// UPjcSubsystem::GetAssetsTotalSize(AssetsUnused);
-	RootItem->PercentageUnused = RootItem->NumAssetsTotal == 0 ? 0 : RootItem->NumAssetsUnused * 100.0f / RootItem->NumAssetsTotal;
-	RootItem->PercentageUnusedNormalized = FMath::GetMappedRangeValueClamped(FVector2D{ 0.0f, 100.0f }, FVector2D{ 0.0f, 1.0f }, RootItem->PercentageUnused);
+	ApplyFolderStats(*RootItem);
+	RootItem->bIsEmpty = false;
 	RootItem->Parent = nullptr;
 
-	// filling whole tree
+	// filling whole tree from the aggregated folder hierarchy, every folder is visited once
 	TArray<TSharedPtr<FAssetTreeFolderNode>> Stack;
 	Stack.Push(RootItem);
 
-	while(Stack.Num() > 0)
+	while(Stack.Num() > 0 && FolderStats.IsValid())
 	{
 		const auto CurrentItem = Stack.Pop(EAllowShrinking::No);
 
@@ -437,11 +595,10 @@ void SAssetCleanerWidget::UpdateFolderTree()
 			TreeListView->SetItemSelection(CurrentItem, true, ESelectInfo::Direct);
 		}
 
-		TArray<FString> SubPaths;
-		//const auto& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-		UAssetCleanerSubsystem::GetAssetRegistryModule().Get().GetSubPaths(CurrentItem->FolderPath, SubPaths, false);
+		const TArray<FString>* SubPaths = FolderStats->SubPathsByPath.Find(CurrentItem->FolderPath);
+		if(!SubPaths) continue;
 
-		for( const auto& SubPath : SubPaths)
+		for(const auto& SubPath : *SubPaths)
 		{
 			if(UAssetCleanerSubsystem::FolderIsExternal(SubPath)) continue;
 
@@ -452,16 +609,10 @@ void SAssetCleanerWidget::UpdateFolderTree()
 			SubItem->FolderName = FPaths::GetPathLeaf(SubItem->FolderPath);
 			SubItem->bIsDev = SubItem->FolderPath.StartsWith(AssetCleaner::PathDevelopers.ToString());
 			SubItem->bIsRoot = false;
-			SubItem->bIsEmpty = UAssetCleanerSubsystem::FolderIsEmpty(SubItem->FolderPath);
 			//SubItem->bIsExcluded = AssetCleaner::Private::FolderIsExcluded(SubItem->FolderPath);
-			//SubItem->NumAssetsTotal = MapNumAssetsAllByPath.Contains(SubItem->FolderPath) ? MapNumAssetsAllByPath[SubItem->FolderPath] : 0;
-			//SubItem->NumAssetsUsed = MapNumAssetsUsedByPath.Contains(SubItem->FolderPath) ? MapNumAssetsUsedByPath[SubItem->FolderPath] : 0;
-			//SubItem->NumAssetsUnused = MapNumAssetsUnusedByPath.Contains(SubItem->FolderPath) ? MapNumAssetsUnusedByPath[SubItem->FolderPath] : 0;
-			//SubItem->SizeAssetsUnused = MapSizeAssetsUnusedByPath.Contains(SubItem->FolderPath) ? MapSizeAssetsUnusedByPath[SubItem->FolderPath] : 0.0f;
-			//SubItem->PercentageUnused = SubItem->NumAssetsTotal == 0 ? 0 : SubItem->NumAssetsUnused * 100.0f / SubItem->NumAssetsTotal;
-			SubItem->PercentageUnusedNormalized = FMath::GetMappedRangeValueClamped(FVector2D{ 0.0f, 100.0f }, FVector2D{ 0.0f, 1.0f }, SubItem->PercentageUnused);
+			ApplyFolderStats(*SubItem);
 			SubItem->Parent = CurrentItem;
-			SubItem->bIsExpanded = TreeItemIsExpanded(SubItem, CachedExpandedItems);
+			SubItem->bIsExpanded = TreeItemIsExpanded(SubItem, ExpandedPaths);
 			SubItem->bIsVisible = true;//TreeItemIsVisible(SubItem);
 
 			CurrentItem->SubItems.Emplace(SubItem);
@@ -476,6 +627,57 @@ void SAssetCleanerWidget::UpdateFolderTree()
 	TreeListView->RebuildList();
 }
 
+void SAssetCleanerWidget::RequestFolderStats()
+{
+	if(bFolderStatsPending) return;
+	bFolderStatsPending = true;
+
+	TWeakPtr<SAssetCleanerWidget> WeakWidget = SharedThis(this);
+	AssetCleaner::FFolderStatsSnapshot::BuildAsync(AssetCleaner::PathRoot.ToString(),
+		[WeakWidget] (TSharedRef<AssetCleaner::FFolderStatsSnapshot> Snapshot)
+		{
+			const TSharedPtr<SAssetCleanerWidget> Widget = WeakWidget.Pin();
+			if(!Widget.IsValid()) return;
+
+			Widget->bFolderStatsPending = false;
+			Widget->FolderStats = Snapshot;
+			Widget->UpdateFolderTree();
+		});
+}
+
+void SAssetCleanerWidget::ScheduleFolderStatsRefresh()
+{
+	if(FolderStatsRefreshTimer.IsValid()) return;
+
+	constexpr float RefreshDelaySeconds = 1.0f;
+	FolderStatsRefreshTimer = RegisterActiveTimer(RefreshDelaySeconds, FWidgetActiveTimerDelegate::CreateSP(this, &SAssetCleanerWidget::HandleFolderStatsRefreshTimer));
+}
+
+EActiveTimerReturnType SAssetCleanerWidget::HandleFolderStatsRefreshTimer(double InCurrentTime, float InDeltaTime)
+{
+	// An aggregation still running may have missed the change, try again once it is done
+	if(bFolderStatsPending) return EActiveTimerReturnType::Continue;
+
+	FolderStatsRefreshTimer.Reset();
+	RequestFolderStats();
+	return EActiveTimerReturnType::Stop;
+}
+
+void SAssetCleanerWidget::ScheduleFilteredAssetListRefresh()
+{
+	if(FilteredAssetListRefreshTimer.IsValid()) return;
+
+	constexpr float RefreshDelaySeconds = 0.25f;
+	FilteredAssetListRefreshTimer = RegisterActiveTimer(RefreshDelaySeconds, FWidgetActiveTimerDelegate::CreateSP(this, &SAssetCleanerWidget::HandleFilteredAssetListRefreshTimer));
+}
+
+EActiveTimerReturnType SAssetCleanerWidget::HandleFilteredAssetListRefreshTimer(double InCurrentTime, float InDeltaTime)
+{
+	FilteredAssetListRefreshTimer.Reset();
+	UpdateFilteredAssetList();
+	return EActiveTimerReturnType::Stop;
+}
+
 void SAssetCleanerWidget::SortTreeItems(const bool UpdateSortingOrder)
 {
 	auto SortTreeItems = [&] (auto& SortMode, auto SortFunc)
@@ -690,26 +892,52 @@ void SAssetCleanerWidget::SubscribeToAssetRegistryEvent()
 
 void SAssetCleanerWidget::OnAssetAdded(const FAssetData& NewAssetData)
 {
-	//LoadAssets();
-	//UpdateFilteredAssetList();
+	HandlePackageChanged(NewAssetData.PackageName);
 }
 
 void SAssetCleanerWidget::OnAssetRemoved(const FAssetData& AssetToRemoved)
 {
-	//LoadAssets();
-	//UpdateFilteredAssetList();
+	HandlePackageChanged(AssetToRemoved.PackageName);
 }
 
 void SAssetCleanerWidget::OnAssetRenamed(const FAssetData& NewAssetData, const FString& Name)
 {
-	//LoadAssets();
-	//UpdateFilteredAssetList();
+	// Name is the old object path: the old package lost the asset, the new one gained it
+	HandlePackageChanged(FName(*FPackageName::ObjectPathToPackageName(Name)));
+	HandlePackageChanged(NewAssetData.PackageName);
 }
 
 void SAssetCleanerWidget::OnAssetUpdated(const FAssetData& AssetData)
 {
-	// LoadAssets();
-	// UpdateFilteredAssetList();
+	HandlePackageChanged(AssetData.PackageName);
+}
+
+void SAssetCleanerWidget::HandlePackageChanged(FName PackageName)
+{
+	AssetCleaner::FAssetFilterLibrary::ReferenceIndex.OnPackageChanged(PackageName);
+
+	// Cycles are project wide and rebuilt in the background, but only when the hard dependencies of the package changed
+	AssetCleaner::FCircularReferenceIndex& CircularReferences = AssetCleaner::FAssetFilterLibrary::CircularReferences;
+	CircularReferences.OnPackageChanged(PackageName);
+
+	if(!CircularReferences.IsValid() && ActiveAdvancedFilters.Contains(TEXT("Assets With Circular References")))
+	{
+		// The re-filter starts the rebuild, and re-filters again once it is done
+		ScheduleFilteredAssetListRefresh();
+	}
+
+	AssetCleaner::FAssetSizeCache::Get().Invalidate(PackageName);
+	ScheduleFolderStatsRefresh();
+
+	if(DisplayedPackageNames.Contains(PackageName))
+	{
+		AssetCleaner::FAssetSizeCache::Get().RequestSizes({ PackageName }, FSimpleDelegate::CreateSP(this, &SAssetCleanerWidget::OnAssetSizesCached));
+	}
+
+	if(ActiveAdvancedFilters.Contains(TEXT("Assets Without References")) || ActiveAdvancedFilters.Contains(TEXT("Assets With Missing References")))
+	{
+		ScheduleFilteredAssetListRefresh();
+	}
 }
 
 void SAssetCleanerWidget::OnSearchTextChanged(const FText& InText)
@@ -824,175 +1052,78 @@ void SAssetCleanerWidget::InitializeAssetTypeComboBox(TArray<TSharedPtr<FAssetDa
 	UE_LOG(LogTemp, Warning, TEXT("%s FilteredDataAssets: %i"), *FString(__FUNCTION__), FilteredDataAssets.Num());
 }
 
-bool SAssetCleanerWidget::HasCycle(const FAssetData& Asset)
+void SAssetCleanerWidget::OnAssetSizesCached()
 {
-	IAssetRegistry& AssetRegistry = UAssetCleanerSubsystem::GetAssetRegistryModule().Get();
-	const FAssetIdentifier StartId(Asset.PackageName);
-
-	TSet<FAssetIdentifier> TempVisited;
-	TArray<FAssetIdentifier> AllIdentifiersToScan;
-
-	TFunction<void(const FAssetIdentifier&)> CollectAllDeps;
-	CollectAllDeps = [&] (const FAssetIdentifier& CurrentId)
-		{
-			if(TempVisited.Contains(CurrentId)) return;
-			TempVisited.Add(CurrentId);
-			AllIdentifiersToScan.Add(CurrentId);
-
-			TArray<FAssetDependency> Deps;
-			if(AssetRegistry.GetDependencies(CurrentId, Deps,
-				UE::AssetRegistry::EDependencyCategory::Package,
-				UE::AssetRegistry::FDependencyQuery(UE::AssetRegistry::EDependencyQuery::Hard)))
-			{
-				for(const FAssetDependency& Dep : Deps)
-				{
-					CollectAllDeps(Dep.AssetId);
-				}
-			}
-		};
-	CollectAllDeps(StartId);
-
-	FScopedSlowTask SlowTask((float)AllIdentifiersToScan.Num(), FText::FromString(TEXT("Scanning for circular references...")));
-	SlowTask.MakeDialog(true);
-
-	TSet<FAssetIdentifier> Visited;
-	TSet<FAssetIdentifier> RecursionStack;
-
-	TFunction<bool(const FAssetIdentifier&)> HasCycle;
-	HasCycle = [&] (const FAssetIdentifier& CurrentId) -> bool
-		{
-			if(RecursionStack.Contains(CurrentId)) return true;
-			if(Visited.Contains(CurrentId)) return false;
-
-			Visited.Add(CurrentId);
-			RecursionStack.Add(CurrentId);
-
-			TArray<FAssetDependency> Dependencies;
-			if(AssetRegistry.GetDependencies(CurrentId, Dependencies,
-				UE::AssetRegistry::EDependencyCategory::Package,
-				UE::AssetRegistry::FDependencyQuery(UE::AssetRegistry::EDependencyQuery::Hard)))
-			{
-				for(const FAssetDependency& Dep : Dependencies)
-				{
-					if(HasCycle(Dep.AssetId))
-					{
-						return true;
-					}
-				}
-			}
-
-			RecursionStack.Remove(CurrentId);
-			return false;
-		};
-
-	for(const FAssetIdentifier& Id : AllIdentifiersToScan)
+	if(CurrentSortColumn == AssetCleanerListColumns::ColumnID_DiskSize)
 	{
-		if(SlowTask.ShouldCancel()) break;
-
-		SlowTask.EnterProgressFrame(1.f, FText::FromString(Id.ToString()));
-
-
-		Visited.Reset();
-		RecursionStack.Reset();
-
-		if(HasCycle(Id))
-		{
-			return true;
-		}
+		SortAssetList();
 	}
 
-	return false;
+	if(AssetListView.IsValid())
+	{
+		AssetListView->RequestListRefresh();
+	}
 }
 
-void SAssetCleanerWidget::CollectAssetsWithInvalidReferences()
+void SAssetCleanerWidget::ShowCircularReferenceReport()
 {
-	AssetsWithInvalidReferences.Empty();
-
-	FScopedSlowTask SlowTask(StoredAssetList.Num(), FText::FromString(TEXT("Checking assets for invalid references...")));
-	SlowTask.MakeDialog(true);
-
-	IAssetRegistry& AssetRegistry = UAssetCleanerSubsystem::GetAssetRegistryModule().Get();
-
-	for(const TSharedPtr<FAssetData>& Asset : StoredAssetList)
+	AssetCleaner::FCircularReferenceIndex& CircularReferences = AssetCleaner::FAssetFilterLibrary::CircularReferences;
+	if(CircularReferences.IsValid())
 	{
-		SlowTask.EnterProgressFrame(1.f);
-
-		if(!Asset.IsValid()) continue;
-
-		TArray<FAssetIdentifier> References;
-		AssetRegistry.GetReferencers(Asset->GetPrimaryAssetId(),
-			References, UE::AssetRegistry::EDependencyCategory::All);
+		WriteCircularReferenceReport();
+		return;
+	}
 
-		for(const FAssetIdentifier& Ref : References)
+	TWeakPtr<SAssetCleanerWidget> WeakWidget = SharedThis(this);
+	CircularReferences.BuildAsync([WeakWidget] ()
 		{
-			// ignore self-reference
-			if(Ref == Asset->GetPrimaryAssetId()) continue;
-
-			FString PackageName = Ref.PackageName.ToString();
-			if(!FPackageName::DoesPackageExist(PackageName))
+			if(const TSharedPtr<SAssetCleanerWidget> Widget = WeakWidget.Pin())
 			{
-				AssetsWithInvalidReferences.Add(Asset->PackageName);
-				break;
+				Widget->WriteCircularReferenceReport();
 			}
-		}
-	}
+		});
 }
 
-void SAssetCleanerWidget::CollectMaterialsInfoManyInstruction()
+void SAssetCleanerWidget::WriteCircularReferenceReport()
 {
-	FilteredMaterials.Empty();
+	const AssetCleaner::FCircularReferenceIndex& CircularReferences = AssetCleaner::FAssetFilterLibrary::CircularReferences;
 
-	FScopedSlowTask SlowTask(StoredAssetList.Num(),FText::FromString(TEXT("Scanning Materials With Too Many Instructions...")));
-	SlowTask.MakeDialog(true);
+	FMessageLog AssetCheckLog("AssetCheck");
+	AssetCheckLog.NewPage(LOCTEXT("CircularReferenceReportPage", "Circular References"));
 
-	constexpr int32 InstructionLimit = 500;
-
-	for(const TSharedPtr<FAssetData>& Asset : StoredAssetList)
+	const TArray<TArray<FName>>& Cycles = CircularReferences.GetCycles();
+	for(int32 CycleIndex = 0; CycleIndex < Cycles.Num(); ++CycleIndex)
 	{
-		SlowTask.EnterProgressFrame(1.f, FText::FromString(Asset.Get()->AssetName.ToString()));
-		if(!Asset.IsValid()) continue;
+		const TSharedRef<FTokenizedMessage> Message = AssetCheckLog.Warning(FText::Format(
+			LOCTEXT("CircularReferenceGroup", "Circular reference group {0} ({1} packages):"), CycleIndex + 1, Cycles[CycleIndex].Num()));
 
-		UObject* LoadedObject = Asset.Get()->GetAsset();
-		UMaterialInterface* MaterialInterface = Cast<UMaterialInterface>(LoadedObject);
-
-		if(!MaterialInterface) continue;
-		const FMaterialStatistics MaterialStats = UMaterialEditingLibrary::GetStatistics(MaterialInterface);
-
-		if((MaterialStats.NumVertexShaderInstructions > InstructionLimit) ||
-			(MaterialStats.NumPixelShaderInstructions > InstructionLimit))
+		for(const FName& PackageName : Cycles[CycleIndex])
 		{
-			FilteredMaterials.Add(Asset->PackageName);
+			Message->AddToken(FAssetNameToken::Create(PackageName.ToString()));
 		}
 	}
 
-}
-void SAssetCleanerWidget::CollectMaterialsInfoManyExpression()
-{
-	FilteredMaterials.Empty();
-
-	FScopedSlowTask SlowTask(StoredAssetList.Num(),FText::FromString(TEXT("Scanning Materials With Too Many Samplers...")));
-	SlowTask.MakeDialog(true);
-
-	constexpr int32 ExpressionLimit = 100;
-
-	for(const TSharedPtr<FAssetData>& Asset : StoredAssetList)
+	if(Cycles.Num() == 0)
 	{
-		SlowTask.EnterProgressFrame(1.f, FText::FromString(Asset.Get()->AssetName.ToString()));
-		if(!Asset.IsValid()) continue;
+		AssetCheckLog.Info(LOCTEXT("NoCircularReferences", "No circular references found."));
+	}
 
-		UObject* LoadedObject = Asset.Get()->GetAsset();
-		UMaterial* Material = Cast<UMaterial>(LoadedObject);
-		if(!Material) continue;
+	AssetCheckLog.Open(EMessageSeverity::Info, true);
+}
 
-		const int32 MaterialExpressionCount = UMaterialEditingLibrary::GetNumMaterialExpressions(Material);
-		if(MaterialExpressionCount > ExpressionLimit)
+void SAssetCleanerWidget::RequestCircularReferences()
+{
+	TWeakPtr<SAssetCleanerWidget> WeakWidget = SharedThis(this);
+	AssetCleaner::FAssetFilterLibrary::CircularReferences.BuildAsync([WeakWidget] ()
 		{
-			FilteredMaterials.Add(Asset->PackageName);
-		}
-	}
+			const TSharedPtr<SAssetCleanerWidget> Widget = WeakWidget.Pin();
+			if(Widget.IsValid() && Widget->ActiveAdvancedFilters.Contains(TEXT("Assets With Circular References")))
+			{
+				Widget->UpdateFilteredAssetList();
+			}
+		});
 }
 
-
 void SAssetCleanerWidget::InitializeAdvancedFilters()
 {
 	using namespace AssetCleaner;
@@ -1029,8 +1160,8 @@ void SAssetCleanerWidget::InitializeAdvancedFilters()
 		{ TEXT("Assets With Invalid References"), [] (const FAssetData& Asset) -> bool {
 			return FAssetFilterLibrary::AssetsWithInvalidReferences.Contains(Asset.PackageName);
 		}},
-		{ TEXT("Assets With Circular References"), [this] (const FAssetData& Asset) -> bool {
-			return HasCycle(Asset);
+		{ TEXT("Assets With Circular References"), [] (const FAssetData& Asset) -> bool {
+			return FAssetFilterLibrary::IsAssetInCircularReference(Asset);
 		}},
 		{ TEXT("Assets With Default Name"), [] (const FAssetData& Asset) -> bool {
 			const FString Name = Asset.AssetName.ToString();
@@ -1047,14 +1178,14 @@ void SAssetCleanerWidget::InitializeAdvancedFilters()
 			return Asset.TagsAndValues.Num() == 0;
 		}},
 		{ TEXT("Materials With Too Many Instructions"), [this] (const FAssetData& Asset) -> bool {
-			return FilteredMaterials.Contains(Asset.PackageName);
+			return FAssetFilterLibrary::MaterialsWithTooManyInstructions.Contains(Asset.PackageName);
 		}},
 		{ TEXT("Materials Without Usage Flags"), [] (const FAssetData& Asset) -> bool {
 			return false;
 		}},
 
 		{ TEXT("Materials With Too Many Expressions"), [this] (const FAssetData& Asset) -> bool {
-			return FilteredMaterials.Contains(Asset.PackageName);
+			return FAssetFilterLibrary::MaterialsWithTooManyExpressions.Contains(Asset.PackageName);
 		}},
 
 		{ TEXT("Skeletal Meshes Without Physics Asset"), [] (const FAssetData& Asset) -> bool {
@@ -1122,39 +1253,20 @@ void SAssetCleanerWidget::InitializeAdvancedFilters()
 			return false;
 		}}
 	};
-}
-
-
-
-void SAssetCleanerWidget::CollectTexturesWithoutCompression()
-{
-	TexturesWithoutCompression.Empty();
 
-	IAssetRegistry& AssetRegistry = UAssetCleanerSubsystem::GetAssetRegistryModule().Get();
-	FTopLevelAssetPath TextureClassPath(TEXT("/Script/Engine.Texture2D"));
-
-	TArray<FAssetData> AllTextures;
-	AssetRegistry.GetAssetsByClass(TextureClassPath, AllTextures);
-
-	FScopedSlowTask SlowTask(AllTextures.Num(), FText::FromString(TEXT("Scanning Textures Without Compression...")));
-	SlowTask.MakeDialog(true);
-
-	for(const FAssetData& TextureAsset : AllTextures)
+	AdvancedFilterCollectors =
 	{
-		SlowTask.EnterProgressFrame(1.f, FText::FromString(TextureAsset.AssetName.ToString()));
-
-		if(UTexture2D* Texture2D = Cast<UTexture2D>(TextureAsset.GetAsset()))
-		{
-			if(Texture2D->CompressionSettings == TextureCompressionSettings::TC_VectorDisplacementmap ||
-				Texture2D->CompressionSettings == TextureCompressionSettings::TC_Grayscale)
-			{
-				TexturesWithoutCompression.Add(TextureAsset.PackageName);
-			}
-		}
-	}
+		{ TEXT("Assets With Metadata"), &FAssetFilterLibrary::CollectMetadata },
+		{ TEXT("Assets With Invalid References"), &FAssetFilterLibrary::CollectAssetsWithInvalidReferences },
+		{ TEXT("Textures Without Compression"), &FAssetFilterLibrary::CollectTexturesWithoutCompression },
+		{ TEXT("Textures With Wrong Size (PoTwo Check)"), &FAssetFilterLibrary::CollectTexturesWithWrongSize },
+		{ TEXT("Materials With Too Many Instructions"), &FAssetFilterLibrary::CollectMaterialsWithTooManyInstructions },
+		{ TEXT("Materials With Too Many Expressions"), &FAssetFilterLibrary::CollectMaterialsWithTooManyExpressions }
+	};
 }
 
 
+
 TArray<TSharedPtr<FAssetData>> SAssetCleanerWidget::GetAssetListSelectedItem() const
 {
 	TArray<TSharedPtr<FAssetData>> SelectedItems;
@@ -1318,8 +1430,39 @@ TSharedRef<SDockTab> SAssetCleanerWidget::SpawnAssetsAndFiltersTab(const FSpawnT
 		.FillHeight(0.6f)
 		.AutoHeight()
 		[
-			SNew(STextBlock)
-			.Text_Lambda([this] () { return GetSelectedTextBlockInfo(); })
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text_Lambda([this] () { return GetSelectedTextBlockInfo(); })
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(4.0f, 0.0f)
+			[
+				SNew(STextBlock)
+				.Text(this, &SAssetCleanerWidget::GetScanProgressText)
+				.Visibility(this, &SAssetCleanerWidget::GetScanProgressVisibility)
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("CancelScans", "Cancel"))
+				.ToolTipText(LOCTEXT("CancelScansTooltip", "Cancel running advanced filter scans"))
+				.Visibility(this, &SAssetCleanerWidget::GetScanProgressVisibility)
+				.OnClicked_Lambda([this] ()
+					{
+						CancelAllAdvancedFilterScans();
+						return FReply::Handled();
+					})
+			]
 		];
 
 	TSharedPtr<SSplitter> Splitter = SNew(SSplitter)
@@ -1419,25 +1562,48 @@ void SAssetCleanerWidget::LoadAssets()
 			return A->AssetName.LexicalLess(B->AssetName);
 		});
 
+	AssetCleaner::FAssetFilterLibrary::ReferenceIndex.Build(StoredAssetList);
+
+	TArray<FName> PackageNames;
+	PackageNames.Reserve(StoredAssetList.Num());
+	for(const TSharedPtr<FAssetData>& Asset : StoredAssetList)
+	{
+		PackageNames.Add(Asset->PackageName);
+	}
+	AssetCleaner::FAssetSizeCache::Get().RequestSizes(MoveTemp(PackageNames), FSimpleDelegate::CreateSP(this, &SAssetCleanerWidget::OnAssetSizesCached));
+
 	UE_LOG(SAssetCleanerWidgetLog, Log, TEXT("Found %d assets in directory: %s"), StoredAssetList.Num(), *SelectedDirectory);
 }
 
+bool SAssetCleanerWidget::PassesSearchAndTypeFilters(const FAssetData& AssetData) const
+{
+	const FString SearchString = SearchText.Get().ToString();
+	if(!SearchString.IsEmpty() && !AssetData.AssetName.ToString().Contains(SearchString))
+	{
+		return false;
+	}
+
+	return ActiveFilters.Num() == 0 || ActiveFilters.Contains(AssetData.AssetClassPath.GetAssetName().ToString());
+}
+
 void SAssetCleanerWidget::UpdateFilteredAssetList()
 {
 	FilteredDataAssets.Empty();
-	const FString SearchString = SearchText.Get().ToString();
-	const bool bFilterByType = ActiveFilters.Num() > 0;
+	DisplayedPackageNames.Empty();
 	const bool bHasAdvancedFilters = ActiveAdvancedFilters.Num() > 0;
 
+	// The predicate reads the cached groups only, the list is filtered again when the build completes
+	const AssetCleaner::FCircularReferenceIndex& CircularReferences = AssetCleaner::FAssetFilterLibrary::CircularReferences;
+	if(!CircularReferences.IsValid() && !CircularReferences.IsBuilding() && ActiveAdvancedFilters.Contains(TEXT("Assets With Circular References")))
+	{
+		RequestCircularReferences();
+	}
+
 	for(const TSharedPtr<FAssetData>& AssetData : StoredAssetList)
 	{
 		if(!AssetData.IsValid()) continue;
 
-		const FString& AssetName = AssetData->AssetName.ToString();
-		const FString AssetClassName = AssetData->AssetClassPath.GetAssetName().ToString();
-
-		const bool bNameMatches = SearchString.IsEmpty() || AssetName.Contains(SearchString);
-		const bool bTypeMatches = !bFilterByType || ActiveFilters.Contains(AssetClassName);
+		if(!PassesSearchAndTypeFilters(*AssetData)) continue;
 
 		// Advanced filters now use OR logic
 		bool bAdvancedMatches = !bHasAdvancedFilters;
@@ -1455,9 +1621,10 @@ void SAssetCleanerWidget::UpdateFilteredAssetList()
 			}
 		}
 
-		if(bNameMatches && bTypeMatches && bAdvancedMatches)
+		if(bAdvancedMatches)
 		{
 			FilteredDataAssets.Add(AssetData);
+			DisplayedPackageNames.Add(AssetData->PackageName);
 		}
 	}
 
@@ -1566,8 +1733,8 @@ void SAssetCleanerWidget::SortAssetList()
 	{
 		FilteredDataAssets.Sort([this] (const TSharedPtr<FAssetData>& A, const TSharedPtr<FAssetData>& B)
 			{
-				const int64 SizeA = UAssetCleanerSubsystem::ParseSizeString(AssetCleaner::Private::GetAssetDiskSize(*A));
-				const int64 SizeB = UAssetCleanerSubsystem::ParseSizeString(AssetCleaner::Private::GetAssetDiskSize(*B));
+				const int64 SizeA = AssetCleaner::FAssetSizeCache::Get().GetSize(A->PackageName);
+				const int64 SizeB = AssetCleaner::FAssetSizeCache::Get().GetSize(B->PackageName);
 				return (CurrentSortMode == EColumnSortMode::Ascending) ? (SizeA < SizeB) : (SizeA > SizeB);
 			});
 	}
@@ -1929,6 +2096,12 @@ void SAssetCleanerWidget::CreateContextMenuFromDataAsset(const FGeometry& InGeom
 				FSlateIcon(AssetCleaner::Icons::Audit),
 				FUIAction(FExecuteAction::CreateSP(this, &SAssetCleanerWidget::OpenAuditAsset)));
 
+			MenuBuilder.AddMenuEntry(
+				LOCTEXT("CircularReferenceReportMenuEntry", "Circular Reference Report..."),
+				LOCTEXT("CircularReferenceReportMenuTooltip", "List every circular reference group of the project in the message log"),
+				FSlateIcon(AssetCleaner::Icons::ReferenceViewer),
+				FUIAction(FExecuteAction::CreateSP(this, &SAssetCleanerWidget::ShowCircularReferenceReport)));
+
 		}
 		MenuBuilder.EndSection();
 
@@ -84,7 +84,7 @@ struct FAssetTreeFolderNode
 	int32 NumAssetsTotal = 0;
 	int32 NumAssetsUsed = 0;
 	int32 NumAssetsUnused = 0;
-	float SizeAssetsUnused = 0.0f;
+	int64 SizeAssetsUnused = 0;
 	float PercentageUnused = 0.0f;
 	float PercentageUnusedNormalized = 0.0f;
 
@@ -3,27 +3,74 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Libraries/AssetScanTask.h"
+#include "Libraries/AssetReferenceIndex.h"
+#include "Libraries/CircularReferenceIndex.h"
 
 /**
- * 
+ *
  */
 namespace AssetCleaner
 {
 	class ASSETCLEANER_API FAssetFilterLibrary
 	{
 	public:
+		/**
+		 * Answered from ReferenceIndex when the package is indexed, otherwise by querying the asset registry.
+		 */
 		static bool IsAssetUnreferenced(const FAssetData& Asset);
 		static bool IsAssetWithMissingReferences(const FAssetData& Asset);
-		static void CollectMetadata(const TArray<TSharedPtr<FAssetData>>& InAssetList);
-		static void CollectAssetsWithInvalidReferences(const TArray<TSharedPtr<FAssetData>>& InAssetList);
-		static void CollectTexturesWithoutCompression(const TArray<TSharedPtr<FAssetData>>& InAssetList);
-		static void CollectTexturesWithWrongSize(const TArray<TSharedPtr<FAssetData>>& InAssetList);
+
+		/** Referencer/dependency index of the assets listed by the Asset Cleaner, rebuilt on every asset list load. */
+		static FAssetReferenceIndex ReferenceIndex;
+
+		/** Answers from the cached circular reference groups only, build them with CircularReferences.BuildAsync() first. */
+		static bool IsAssetInCircularReference(const FAssetData& Asset);
+
+		/** Circular reference groups of the project, invalidated by asset registry changes. */
+		static FCircularReferenceIndex CircularReferences;
+
+		/**
+		 * Collectors below reset their result set and return a scan task that is not started yet.
+		 * Bind the scan task delegates to receive streamed matches, then call Start().
+		 */
+		static TSharedRef<FAssetScanTask> CollectMetadata(const TArray<TSharedPtr<FAssetData>>& InAssetList);
+		static TSharedRef<FAssetScanTask> CollectAssetsWithInvalidReferences(const TArray<TSharedPtr<FAssetData>>& InAssetList);
+		static TSharedRef<FAssetScanTask> CollectTexturesWithoutCompression(const TArray<TSharedPtr<FAssetData>>& InAssetList);
+		static TSharedRef<FAssetScanTask> CollectTexturesWithWrongSize(const TArray<TSharedPtr<FAssetData>>& InAssetList);
+		static TSharedRef<FAssetScanTask> CollectMaterialsWithTooManyInstructions(const TArray<TSharedPtr<FAssetData>>& InAssetList);
+		static TSharedRef<FAssetScanTask> CollectMaterialsWithTooManyExpressions(const TArray<TSharedPtr<FAssetData>>& InAssetList);
+
+		/**
+		 * Registry-only checks used by the texture and material collectors, safe on any thread.
+		 * They read asset registry tags (Dimensions, CompressionSettings) or the material stats cache,
+		 * and answer NeedsLoad when neither is available.
+		 */
+		static EAssetScanResult CheckTextureCompressionTags(const FAssetData& Asset);
+		static EAssetScanResult CheckTextureSizeTags(const FAssetData& Asset);
+		static EAssetScanResult CheckMaterialInstructionStats(const FAssetData& Asset);
+		static EAssetScanResult CheckMaterialExpressionStats(const FAssetData& Asset);
+
+		/**
+		 * Per-asset predicates used by the collectors. Only HasInvalidReferences is safe off the game thread,
+		 * the others load the asset and serve as the opt-in loading fallback of the registry checks.
+		 */
+		static bool HasMetadata(const FAssetData& Asset);
+		static bool HasInvalidReferences(const FAssetData& Asset);
+		static bool IsTextureWithoutCompression(const FAssetData& Asset);
+		static bool IsTextureWithWrongSize(const FAssetData& Asset);
+		static bool IsMaterialWithTooManyInstructions(const FAssetData& Asset);
+		static bool IsMaterialWithTooManyExpressions(const FAssetData& Asset);
 
 		static TSet<FName> AssetsWithMetadata;
 		static TSet<FName> TexturesWithoutCompression;
 		static TSet<FName> AssetsWithInvalidReferences;
 		static TSet<FName> TexturesWithWrongSize;
-		static TSet<FName> FilteredMaterials;
+		static TSet<FName> MaterialsWithTooManyInstructions;
+		static TSet<FName> MaterialsWithTooManyExpressions;
+
+		static constexpr int32 MaterialInstructionLimit = 500;
+		static constexpr int32 MaterialExpressionLimit = 100;
 	};
 
 
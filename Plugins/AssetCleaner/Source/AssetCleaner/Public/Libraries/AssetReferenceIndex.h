@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace AssetCleaner
+{
+	/**
+	 * In-memory referencer/dependency index over the packages currently listed by the Asset Cleaner.
+	 *
+	 * Built once per asset list from the asset registry, it answers "unreferenced" and "has missing
+	 * hard dependencies" in O(1) per package, so re-filtering the list never queries the registry.
+	 *
+	 * Packages are numbered; indexed packages take [0, NumIndexed) and packages only reached through
+	 * dependencies follow. Hard package dependencies of indexed packages are stored in CSR form
+	 * (offset array + flat edge array), together with the reverse edges used to find the packages
+	 * affected by a registry change.
+	 *
+	 * Game thread only; the build itself queries the registry from worker threads.
+	 */
+	class ASSETCLEANER_API FAssetReferenceIndex
+	{
+	public:
+		/**
+		 * Rebuilds the index from scratch.
+		 *
+		 * @param InAssetList Assets whose packages are indexed.
+		 */
+		void Build(const TArray<TSharedPtr<FAssetData>>& InAssetList);
+
+		/** Drops all indexed data. */
+		void Reset();
+
+		/**
+		 * @param PackageName Package to look up.
+		 * @return Package number usable with the queries below, INDEX_NONE if the package is not indexed.
+		 */
+		int32 FindIndexedPackage(FName PackageName) const;
+
+		/** @return true if no package references the indexed package. */
+		bool IsUnreferenced(int32 PackageIndex) const { return NumReferencers[PackageIndex] == 0; }
+
+		/** @return true if a hard dependency of the indexed package has no assets in the registry. */
+		bool HasMissingReferences(int32 PackageIndex) const { return HasMissingDependency[PackageIndex]; }
+
+		/**
+		 * Refreshes the packages whose answers may change because a package was added, removed or resaved.
+		 * Only the package itself, its dependencies and its referencers are re-queried.
+		 *
+		 * @param PackageName Package reported by the registry event.
+		 */
+		void OnPackageChanged(FName PackageName);
+
+	private:
+		/** Re-queries the registry for an indexed package. */
+		void RefreshIndexedPackage(int32 PackageIndex);
+
+		/** @return Package number, adding a non-indexed entry if the package is unknown. */
+		int32 FindOrAddPackage(FName PackageName);
+
+		/**
+		 * @param bIncludeOnlyOnDiskAssets Skips in-memory assets, required off the game thread.
+		 * @return True if the registry knows assets in the package, created but unsaved ones included unless skipped.
+		 */
+		static bool PackageHasAssets(FName PackageName, bool bIncludeOnlyOnDiskAssets = false);
+
+		TArray<FName> PackageNames;
+		TMap<FName, int32> PackageToIndex;
+		int32 NumIndexed = 0;
+
+		/** Hard package dependencies of indexed packages, CSR over [0, NumIndexed). */
+		TArray<int32> DependencyOffsets;
+		TArray<int32> Dependencies;
+
+		/** Indexed packages depending on each package, CSR over all package numbers known at build time. */
+		TArray<int32> DependentOffsets;
+		TArray<int32> Dependents;
+
+		/** Per indexed package answers. */
+		TArray<int32> NumReferencers;
+		TBitArray<> HasMissingDependency;
+
+		/** Live dependencies of packages refreshed after the build; the CSR arrays keep the build-time edges. */
+		TMap<FName, TArray<FName>> RefreshedDependencies;
+	};
+}
@@ -0,0 +1,166 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+/**
+ * Fired on the game thread with the assets that matched the scan predicate since the previous notification.
+ */
+DECLARE_DELEGATE_OneParam(FOnAssetScanChunkCompleted, const TArray<TSharedPtr<FAssetData>>& /*MatchedAssets*/);
+
+/**
+ * Fired on the game thread once the scan has processed every asset or has been cancelled.
+ */
+DECLARE_DELEGATE_OneParam(FOnAssetScanFinished, bool /*bWasCancelled*/);
+
+namespace AssetCleaner
+{
+	/**
+	 * Describes where a scan predicate is allowed to run.
+	 */
+	enum class EAssetScanThread : uint8
+	{
+		/** Predicate only reads registry data and may run on any worker thread. */
+		AnyThread,
+
+		/** Predicate needs UObjects (loading, metadata) and must run on the game thread. */
+		GameThread
+	};
+
+	/**
+	 * Outcome of a registry-only check.
+	 */
+	enum class EAssetScanResult : uint8
+	{
+		NoMatch,
+		Match,
+
+		/** Registry tags and caches have no answer, the asset has to be loaded to decide. */
+		NeedsLoad
+	};
+
+	/**
+	 * Non-modal, cancellable scan of an asset list.
+	 *
+	 * The list is split into fixed-size chunks. Registry-only predicates run on the task graph, one task per chunk;
+	 * predicates that need UObjects are time-sliced on the game thread from the core ticker so the editor stays responsive.
+	 * Matches are written into the target set and streamed to OnChunkCompleted on the game thread as chunks finish.
+	 *
+	 * Registry predicates may answer EAssetScanResult::NeedsLoad. Those assets are skipped unless a loading fallback is set,
+	 * in which case they are loaded on the game thread and garbage is collected after every batch so peak memory stays flat.
+	 *
+	 * Destroying the scan task cancels it. Worker tasks that are already running finish their current chunk and drop the result.
+	 */
+	class ASSETCLEANER_API FAssetScanTask : public TSharedFromThis<FAssetScanTask>
+	{
+	public:
+		using FScanPredicate = TFunction<bool(const FAssetData&)>;
+		using FRegistryPredicate = TFunction<EAssetScanResult(const FAssetData&)>;
+
+		/** Number of assets processed by a single worker task. */
+		static constexpr int32 ChunkSize = 256;
+
+		/** Game thread time slice per tick for EAssetScanThread::GameThread predicates, in seconds. */
+		static constexpr double GameThreadBudgetSeconds = 0.008;
+
+		/**
+		 * Creates a scan task that is not started yet. Bind the delegates and call Start().
+		 *
+		 * @param InScanName Display name of the scan, used for progress text and logging.
+		 * @param InAssetList Assets to scan. The shared pointers are copied so the caller may rebuild its list meanwhile.
+		 * @param InPredicate Predicate deciding whether an asset matches.
+		 * @param InThread Where the predicate is allowed to run.
+		 * @param InTargetSet Set that receives the package names of matching assets. Must outlive the scan task.
+		 * @return The new scan task.
+		 */
+		static TSharedRef<FAssetScanTask> Create(const FString& InScanName, const TArray<TSharedPtr<FAssetData>>& InAssetList, FScanPredicate InPredicate, EAssetScanThread InThread, TSet<FName>& InTargetSet);
+
+		/**
+		 * Creates a scan task running a registry-only predicate on worker threads. Bind the delegates and call Start().
+		 *
+		 * @param InScanName Display name of the scan, used for progress text and logging.
+		 * @param InAssetList Assets to scan.
+		 * @param InPredicate Registry-only predicate, must be safe to call from any thread.
+		 * @param InTargetSet Set that receives the package names of matching assets. Must outlive the scan task.
+		 * @return The new scan task.
+		 */
+		static TSharedRef<FAssetScanTask> Create(const FString& InScanName, const TArray<TSharedPtr<FAssetData>>& InAssetList, FRegistryPredicate InPredicate, TSet<FName>& InTargetSet);
+
+		/**
+		 * Enables loading of assets the registry predicate could not decide. Must be called before Start().
+		 *
+		 * @param InLoadPredicate Game thread predicate that may load the asset.
+		 * @param InBatchSize Number of loads between garbage collection passes.
+		 */
+		void SetLoadingFallback(FScanPredicate InLoadPredicate, int32 InBatchSize);
+
+		~FAssetScanTask();
+
+		/** Starts processing. Calling Start() on a running or finished scan does nothing. */
+		void Start();
+
+		/** Requests cancellation. OnFinished is broadcast with bWasCancelled = true on the next tick. */
+		void Cancel();
+
+		/** @return true while the scan has been started and has not finished or been cancelled. */
+		bool IsRunning() const { return bStarted && !bFinished; }
+
+		/** @return Fraction of processed assets in the [0, 1] range. */
+		float GetProgress() const;
+
+		/** @return Display name passed on creation. */
+		const FString& GetScanName() const { return ScanName; }
+
+		FOnAssetScanChunkCompleted OnChunkCompleted;
+		FOnAssetScanFinished OnFinished;
+
+	private:
+		/** State shared with worker tasks, kept alive by them even if the scan task is destroyed mid-flight. */
+		struct FSharedState
+		{
+			TArray<TSharedPtr<FAssetData>> Assets;
+			FRegistryPredicate Predicate;
+			TQueue<TArray<TSharedPtr<FAssetData>>, EQueueMode::Mpsc> CompletedChunks;
+			TQueue<TSharedPtr<FAssetData>, EQueueMode::Mpsc> DeferredAssets;
+			std::atomic<int32> NumProcessed{ 0 };
+			std::atomic<int32> NumDeferred{ 0 };
+			std::atomic<bool> bCancelled{ false };
+			bool bHasLoadingFallback = false;
+		};
+
+		FAssetScanTask(const FString& InScanName, EAssetScanThread InThread, TSet<FName>& InTargetSet);
+
+		void LaunchWorkerTasks();
+		void ProcessGameThreadSlice();
+		void ProcessLoadingFallbackSlice();
+		void FlushLoadedAssets();
+		bool Tick(float DeltaTime);
+		void Finish(bool bWasCancelled);
+
+		FString ScanName;
+		EAssetScanThread Thread;
+		TSet<FName>& TargetSet;
+		TSharedRef<FSharedState, ESPMode::ThreadSafe> State;
+		FTSTicker::FDelegateHandle TickerHandle;
+
+		/** Next asset to evaluate when running on the game thread. */
+		int32 NextGameThreadIndex = 0;
+
+		/** Game thread predicate for assets the registry predicate deferred. */
+		FScanPredicate LoadPredicate;
+
+		/** Loads between garbage collection passes. */
+		int32 LoadBatchSize = 0;
+
+		/** Loads since the last garbage collection pass. */
+		int32 NumLoadsInBatch = 0;
+
+		/** Deferred assets evaluated by the loading fallback so far. */
+		int32 NumLoaded = 0;
+
+		bool bStarted = false;
+		bool bFinished = false;
+	};
+}
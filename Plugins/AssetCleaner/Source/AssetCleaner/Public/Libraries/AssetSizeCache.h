@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace AssetCleaner
+{
+	/**
+	 * Package file sizes in bytes, keyed by package name.
+	 *
+	 * Sizes are stat'ed in bulk on a background task and kept until the package is invalidated by an
+	 * asset registry event, so sorting and drawing the disk size column never touch the file system.
+	 * Formatting to a display string only happens through FormatSize.
+	 *
+	 * All methods are thread safe.
+	 */
+	class ASSETCLEANER_API FAssetSizeCache
+	{
+	public:
+		/** @return The cache singleton. */
+		static FAssetSizeCache& Get();
+
+		/**
+		 * @param PackageName Package to look up.
+		 * @param OutSize Receives the package file size in bytes, INDEX_NONE if the package has no file.
+		 * @return true if the size is cached.
+		 */
+		bool Find(FName PackageName, int64& OutSize) const;
+
+		/** @return Cached size in bytes, INDEX_NONE if the size is unknown or the package has no file. */
+		int64 GetSize(FName PackageName) const;
+
+		/** @return Size in bytes, stat'ed and cached on the calling thread if it is unknown. INDEX_NONE if the package has no file. */
+		int64 FindOrComputeSize(FName PackageName);
+
+		/**
+		 * Computes the sizes of the packages that are not cached yet on a background task.
+		 *
+		 * @param PackageNames Packages to stat.
+		 * @param OnCompleted Executed on the game thread once the sizes are stored, not executed if everything was cached.
+		 */
+		void RequestSizes(TArray<FName> PackageNames, FSimpleDelegate OnCompleted);
+
+		/** Forgets the cached size of a package, the next request stats it again. */
+		void Invalidate(FName PackageName);
+
+		/** @return Size formatted as Kb/Mb, "Unknown" for INDEX_NONE. */
+		static FString FormatSize(int64 SizeInBytes);
+
+	private:
+		FAssetSizeCache() = default;
+
+		static int64 StatPackageFile(FName PackageName);
+
+		mutable FRWLock Lock;
+		TMap<FName, int64> Sizes;
+	};
+}
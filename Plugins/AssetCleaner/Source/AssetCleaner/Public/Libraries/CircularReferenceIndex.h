@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace AssetCleaner
+{
+	/**
+	 * Circular reference groups of the project package dependency graph.
+	 *
+	 * The graph is discovered from the packages under /Game by following hard package dependencies
+	 * (native /Script packages are skipped), then split into strongly connected components with an
+	 * iterative Tarjan pass. Every component with more than one package, or a package depending on
+	 * itself, is a circular reference group.
+	 *
+	 * Builds run on a background task and the previous groups stay readable meanwhile, so filters only read
+	 * the cached result. The result is kept until Invalidate() is called or OnPackageChanged() sees a changed
+	 * dependency. Game thread only.
+	 */
+	class ASSETCLEANER_API FCircularReferenceIndex
+	{
+	public:
+		/**
+		 * Rebuilds the circular reference groups of the whole project on a background task. If a build is
+		 * already running, only the callback is added to it.
+		 *
+		 * @param OnCompleted Called on the game thread once the new groups are in place.
+		 */
+		void BuildAsync(TFunction<void()> OnCompleted);
+
+		/** Marks the cached groups as outdated, the next BuildAsync() replaces them. */
+		void Invalidate() { bIsValid = false; }
+
+		/**
+		 * Invalidates the groups if the hard dependencies of the package no longer match the graph they were built from.
+		 * Call it for every added, removed, renamed or saved package instead of invalidating unconditionally.
+		 */
+		void OnPackageChanged(FName PackageName);
+
+		/** @return true if the cached groups reflect the current asset registry state. */
+		bool IsValid() const { return bIsValid; }
+
+		/** @return true while a BuildAsync() task is running. */
+		bool IsBuilding() const { return bIsBuilding; }
+
+		/**
+		 * @param PackageName Package to look up.
+		 * @return Index into GetCycles() of the group containing the package, INDEX_NONE if it is not part of a cycle.
+		 */
+		int32 FindCycle(FName PackageName) const;
+
+		/** @return Member packages of every circular reference group, sorted by name. */
+		const TArray<TArray<FName>>& GetCycles() const { return Graph.Cycles; }
+
+	private:
+		/** Package graph of a build in CSR form, kept to tell which registry changes affect it, and its groups. */
+		struct FGraph
+		{
+			TArray<FName> NodePackageNames;
+			TMap<FName, int32> PackageToNode;
+			TArray<int32> NodeOffsets;
+			TArray<int32> NodeEdges;
+
+			TArray<TArray<FName>> Cycles;
+			TMap<FName, int32> PackageToCycle;
+		};
+
+		/** Discovers the graph from the registry and finds its groups. Runs on any thread. */
+		static void BuildGraph(FGraph& OutGraph);
+
+		/**
+		 * Tarjan strongly connected components over a graph in CSR form.
+		 *
+		 * @param Offsets Edge range of every node, Offsets.Num() == number of nodes + 1.
+		 * @param Edges Flat successor array.
+		 * @param OutComponents Receives the nodes of every component that forms a cycle.
+		 */
+		static void FindCyclicComponents(const TArray<int32>& Offsets, const TArray<int32>& Edges, TArray<TArray<int32>>& OutComponents);
+
+		FGraph Graph;
+		bool bIsValid = false;
+		bool bIsBuilding = false;
+
+		/** Callbacks of the running build. */
+		TArray<TFunction<void()>> PendingCallbacks;
+
+		/** Packages changed while a build was running, checked against its graph once it is in place. */
+		TSet<FName> PackagesChangedWhileBuilding;
+	};
+}
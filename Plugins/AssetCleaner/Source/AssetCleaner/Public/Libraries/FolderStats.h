@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace AssetCleaner
+{
+	/** Recursive asset statistics of a content folder. */
+	struct FFolderStats
+	{
+		int32 NumAssetsTotal = 0;
+		int32 NumAssetsUsed = 0;
+		int32 NumAssetsUnused = 0;
+		int64 SizeAssetsUnused = 0;
+
+		FFolderStats& operator+=(const FFolderStats& Other)
+		{
+			NumAssetsTotal += Other.NumAssetsTotal;
+			NumAssetsUsed += Other.NumAssetsUsed;
+			NumAssetsUnused += Other.NumAssetsUnused;
+			SizeAssetsUnused += Other.SizeAssetsUnused;
+			return *this;
+		}
+	};
+
+	/**
+	 * Folder hierarchy and statistics of a content root, computed in a single pass over the asset registry.
+	 *
+	 * Every asset is attributed to its own folder, then the folders are folded into their parents from
+	 * the deepest level up, so each folder ends up with the totals of its whole subtree. An asset is
+	 * used when another package references it.
+	 */
+	struct ASSETCLEANER_API FFolderStatsSnapshot
+	{
+		/** Root content path the snapshot was built for. */
+		FString RootPath;
+
+		/** Recursive statistics of every folder below and including the root. */
+		TMap<FString, FFolderStats> StatsByPath;
+
+		/** Direct sub folders of every folder that has any. */
+		TMap<FString, TArray<FString>> SubPathsByPath;
+
+		/** @return Statistics of a folder, empty statistics if the folder is unknown. */
+		const FFolderStats& FindStats(const FString& FolderPath) const;
+
+		/**
+		 * Builds a snapshot on the calling thread. Only thread safe asset registry queries are used.
+		 *
+		 * @param InRootPath Content root to aggregate, e.g. /Game.
+		 */
+		static TSharedRef<FFolderStatsSnapshot> Build(const FString& InRootPath);
+
+		/**
+		 * Builds a snapshot on a background task.
+		 *
+		 * @param InRootPath Content root to aggregate.
+		 * @param OnCompleted Receives the snapshot on the game thread.
+		 */
+		static void BuildAsync(const FString& InRootPath, TFunction<void(TSharedRef<FFolderStatsSnapshot>)> OnCompleted);
+	};
+}
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace AssetCleaner
+{
+	/**
+	 * Persistent cache of material statistics that are not exported as asset registry tags.
+	 *
+	 * Entries are keyed by package name and remember the package file timestamp they were computed from,
+	 * so a resaved material is treated as unknown again. The cache lives in Saved/AssetCleaner and is
+	 * filled by the loading fallback of the material filters.
+	 *
+	 * All methods are thread safe.
+	 */
+	class ASSETCLEANER_API FMaterialStatsCache
+	{
+	public:
+		struct FEntry
+		{
+			FDateTime PackageTimestamp;
+			int32 NumVertexShaderInstructions = INDEX_NONE;
+			int32 NumPixelShaderInstructions = INDEX_NONE;
+			int32 NumExpressions = INDEX_NONE;
+
+			friend FArchive& operator<<(FArchive& Ar, FEntry& Entry)
+			{
+				return Ar << Entry.PackageTimestamp << Entry.NumVertexShaderInstructions << Entry.NumPixelShaderInstructions << Entry.NumExpressions;
+			}
+		};
+
+		/** @return The cache singleton, loaded from disk on first access. */
+		static FMaterialStatsCache& Get();
+
+		/**
+		 * Looks up an entry that is still valid for the package on disk.
+		 *
+		 * @param PackageName Package of the material.
+		 * @param OutEntry Receives the cached entry.
+		 * @return true if a valid entry exists.
+		 */
+		bool Find(FName PackageName, FEntry& OutEntry) const;
+
+		/**
+		 * Stores statistics for a package. Fields left at INDEX_NONE keep the previously cached value.
+		 *
+		 * @param PackageName Package of the material.
+		 * @param Entry Statistics to merge in. The package timestamp is filled in automatically.
+		 */
+		void Store(FName PackageName, const FEntry& Entry);
+
+		/** Writes the cache to disk if it changed since the last save. */
+		void Save();
+
+		/** Saves the cache only if something accessed it this session, without creating and loading it otherwise. */
+		static void SaveIfCreated();
+
+	private:
+		FMaterialStatsCache();
+
+		void Load();
+
+		static FString GetCacheFilename();
+		static FDateTime GetPackageTimestamp(FName PackageName);
+
+		static constexpr int32 CacheVersion = 1;
+
+		mutable FRWLock Lock;
+		TMap<FName, FEntry> Entries;
+		bool bDirty = false;
+	};
+}
@@ -26,4 +26,15 @@ public:
 	 */
 	virtual FText GetSectionText() const override;
 #endif
+
+	/**
+	 * Load textures and materials when asset registry tags or cached statistics cannot answer an advanced filter.
+	 * Disabled by default: loading is slow and memory hungry on large projects.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Scan")
+	bool bAllowLoadingFallback = false;
+
+	/** Number of assets loaded by the fallback between two garbage collection passes. */
+	UPROPERTY(Config, EditAnywhere, Category = "Scan", meta = (EditCondition = "bAllowLoadingFallback", ClampMin = "1", ClampMax = "1024"))
+	int32 LoadingFallbackBatchSize = 64;
 };
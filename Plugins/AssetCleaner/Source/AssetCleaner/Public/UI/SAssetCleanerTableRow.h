@@ -5,33 +5,22 @@
 #include "CoreMinimal.h"
 #include "ISourceControlModule.h"
 #include "ISourceControlProvider.h"
+#include "Libraries/AssetSizeCache.h"
 
 
 // TODO !!! move in function library in future
 namespace AssetCleaner::Private
 {
+	/** @return Cached package size formatted for display, an ellipsis while the size is still being computed. */
 	FORCEINLINE FString GetAssetDiskSize(const FAssetData& AssetData)
 	{
-		FString PackageFileName;
-		if(FPackageName::DoesPackageExist(AssetData.PackageName.ToString(), &PackageFileName))
+		int64 SizeInBytes = INDEX_NONE;
+		if(!FAssetSizeCache::Get().Find(AssetData.PackageName, SizeInBytes))
 		{
-			const int64 FileSize = IFileManager::Get().FileSize(*PackageFileName);
-
-			if(FileSize == INDEX_NONE)
-			{
-				return TEXT("Unknown");
-			}
-
-			const double SizeInKb = static_cast<double>(FileSize) / 1024.0;
-			if(SizeInKb >= 1024)
-			{
-				const double SizeInMb = SizeInKb / 1024.0;
-				return FString::Printf(TEXT("%.1f Mb"), SizeInMb);
-			}
-
-			return FString::Printf(TEXT("%.1f Kb"), SizeInKb);
+			return TEXT("...");
 		}
-		return TEXT("Unknown");
+
+		return FAssetSizeCache::FormatSize(SizeInBytes);
 	}
 }
 
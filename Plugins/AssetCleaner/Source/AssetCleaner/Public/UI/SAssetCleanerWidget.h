@@ -8,6 +8,8 @@
 #include "ClassViewerFilter.h"
 #include "SAssetSearchBox.h"
 #include "AssetCleanerTypes.h"
+#include "Libraries/AssetScanTask.h"
+#include "Libraries/FolderStats.h"
 
 
 enum class EAssetCleanerViewMode : uint8
@@ -108,6 +110,7 @@ class ASSETCLEANER_API SAssetCleanerWidget final : public SCompoundWidget
 	SLATE_END_ARGS()
 public:
 	void Construct(const FArguments& InArgs);
+	virtual ~SAssetCleanerWidget() override;
 
 	TSharedRef<ITableRow> OnTreeGenerateRow(TSharedPtr<FAssetTreeFolderNode> Item, const TSharedRef<STableViewBase>& OwnerTable) const;
 
@@ -127,6 +130,28 @@ public:
 	void OnTreeSelectionChanged(TSharedPtr<FAssetTreeFolderNode> Selection, ESelectInfo::Type SelectInfo);
 	void UpdateFolderTree();
 
+	/** Aggregates the folder statistics of the project on a background task and rebuilds the tree once they are ready. */
+	void RequestFolderStats();
+
+	/** Folder hierarchy and statistics the tree is built from, null until the first aggregation completes. */
+	TSharedPtr<AssetCleaner::FFolderStatsSnapshot> FolderStats;
+	bool bFolderStatsPending = false;
+
+	/**
+	 * Re-aggregates the folder statistics a moment after the last registry change, so a burst of
+	 * adds, removes or saves refreshes the tree once. The current statistics stay visible meanwhile.
+	 */
+	void ScheduleFolderStatsRefresh();
+	EActiveTimerReturnType HandleFolderStatsRefreshTimer(double InCurrentTime, float InDeltaTime);
+
+	TSharedPtr<FActiveTimerHandle> FolderStatsRefreshTimer;
+
+	/** Re-filters the asset list a moment after the last registry change, so a bulk import filters once. */
+	void ScheduleFilteredAssetListRefresh();
+	EActiveTimerReturnType HandleFilteredAssetListRefreshTimer(double InCurrentTime, float InDeltaTime);
+
+	TSharedPtr<FActiveTimerHandle> FilteredAssetListRefreshTimer;
+
 	void InitializeColumns();
 
 	TSet<FName> SelectedPaths;
@@ -141,9 +166,16 @@ public:
 
 	void SortTreeItems(const bool UpdateSortingOrder);
 
-	bool TreeItemIsExpanded(const TSharedPtr<FAssetTreeFolderNode>& Item, const TSet<TSharedPtr<FAssetTreeFolderNode>>& CachedItems) const;
+	bool TreeItemIsExpanded(const TSharedPtr<FAssetTreeFolderNode>& Item, const TSet<FString>& ExpandedPaths) const;
 
+	/** @return true if a folder below the item matches the tree search text. */
 	bool TreeItemContainsSearchText(const TSharedPtr<FAssetTreeFolderNode>& Item) const;
+
+	/** Recomputes TreeSearchMatches for the current tree search text in one pass over the folder paths. */
+	void UpdateTreeSearchMatches();
+
+	/** Folders with a matching descendant for the current tree search text. */
+	TSet<FString> TreeSearchMatches;
 	TSharedPtr<SWidget> GetTreeContextMenu();
 	void OnTreeExpansionChanged(TSharedPtr<FAssetTreeFolderNode> Item, bool bIsExpanded);
 private:
@@ -199,29 +231,95 @@ private:
 
 	void OnFilterChanged(const FString& FilterName, bool bIsEnabled);
 	void InitializeAdvancedFilters();
-	void CollectTexturesWithoutCompression();
-	void CollectAssetsWithInvalidReferences();
-	void CollectMaterialsInfoManyInstruction();
-	void CollectMaterialsInfoManyExpression();
 	void SubscribeToAssetRegistryEvent();
 	void OnAssetAdded(const FAssetData& AssetToRemoved);
 	void OnAssetRemoved(const FAssetData& AssetToRemoved);
 	void OnAssetRenamed(const FAssetData& NewAssetData, const FString& Name);
 	void OnAssetUpdated(const FAssetData& AssetData);
-	bool HasCycle(const FAssetData& Asset);
 	void EditSelectionInPropertyMatrix();
 
+	/** Lists the member packages of every circular reference group of the project in the message log, building them first if needed. */
+	void ShowCircularReferenceReport();
+	void WriteCircularReferenceReport();
+
+	/** Starts a background build of the circular reference groups, then re-filters the list if their filter is active. */
+	void RequestCircularReferences();
+
+	/**
+	 * Updates the reference indices and the size cache for a package reported by an asset registry event
+	 * and re-filters the list if a reference based filter is active.
+	 *
+	 * @param PackageName Package that was added, removed, renamed or updated.
+	 */
+	void HandlePackageChanged(FName PackageName);
+
+	/** Re-sorts by disk size if needed once a batch of package sizes has been cached. */
+	void OnAssetSizesCached();
+
+	/**
+	 * Starts (or restarts) the background scan backing an advanced filter.
+	 * Filters that are plain predicates have no collector and are ignored.
+	 *
+	 * @param FilterName Advanced filter display name.
+	 */
+	void LaunchAdvancedFilterScan(const FString& FilterName);
+
+	/**
+	 * Cancels the background scan of an advanced filter, if one is running. No completion callback is fired.
+	 *
+	 * @param FilterName Advanced filter display name.
+	 */
+	void CancelAdvancedFilterScan(const FString& FilterName);
+
+	/** Cancels every running advanced filter scan. */
+	void CancelAllAdvancedFilterScans();
+
+	/**
+	 * Appends streamed scan matches to the list view without rebuilding it.
+	 *
+	 * @param MatchedAssets Assets matched since the previous notification.
+	 */
+	void OnAdvancedFilterScanChunk(const TArray<TSharedPtr<FAssetData>>& MatchedAssets);
+
+	/**
+	 * Drops the finished scan and re-applies the current sort order.
+	 *
+	 * @param bWasCancelled Whether the scan was cancelled before processing every asset.
+	 * @param FilterName Advanced filter display name the scan belongs to.
+	 */
+	void OnAdvancedFilterScanFinished(bool bWasCancelled, FString FilterName);
+
+	/**
+	 * Checks the search text and asset type filters, i.e. everything except advanced filters.
+	 *
+	 * @param AssetData Asset to check.
+	 * @return true if the asset passes.
+	 */
+	bool PassesSearchAndTypeFilters(const FAssetData& AssetData) const;
+
+	/** @return Progress text of running scans, empty if nothing is running. */
+	FText GetScanProgressText() const;
+
+	/** @return Visible while at least one advanced filter scan is running. */
+	EVisibility GetScanProgressVisibility() const;
+
 
 	TSet<FString> ActiveFilters;
 
 	TMap<FString, TFunction<bool(const FAssetData&)>> AdvancedFilterPredicates;
 	TSet<FString> ActiveAdvancedFilters;
 
-	TSet<FName> AssetsWithMetadata;
-	TSet<FName> TexturesWithoutCompression;
-	TSet<FName> AssetsWithInvalidReferences;
-	TSet<FName> TexturesWithWrongSize;
-	TSet<FName> FilteredMaterials;
+	/**
+	 * Collectors for advanced filters whose predicate reads a precomputed result set.
+	 * Each collector resets its set and returns an unstarted scan task over the given asset list.
+	 */
+	TMap<FString, TFunction<TSharedRef<AssetCleaner::FAssetScanTask>(const TArray<TSharedPtr<FAssetData>>&)>> AdvancedFilterCollectors;
+
+	/** Running scans keyed by advanced filter name. Releasing a scan task cancels it. */
+	TMap<FString, TSharedPtr<AssetCleaner::FAssetScanTask>> ActiveScans;
+
+	/** Package names currently present in FilteredDataAssets, used to skip duplicates when scan results stream in. */
+	TSet<FName> DisplayedPackageNames;
 
 	TSharedPtr<FTabManager::FLayout> TabLayout;
 
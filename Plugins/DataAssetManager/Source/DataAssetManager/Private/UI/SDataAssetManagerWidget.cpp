@@ -36,6 +36,8 @@
 #include "Widgets/Views/SListView.h"
 #include "Menu/DataAssetManagerMenu.h"
 #include "Algo/AnyOf.h"
+#include "Algo/BinarySearch.h"
+#include "Tasks/Task.h"
 #include "UObject/AssetRegistryTagsContext.h"
 #include "UObject/MetaData.h"
 #include "SMetaDataView.h"
@@ -80,6 +82,37 @@ namespace DataAssetManager
 
 	namespace Private
 	{
+		bool IsLessByAssetName(const TSharedPtr<FAssetData>& A, const TSharedPtr<FAssetData>& B)
+		{
+			return A->AssetName.LexicalLess(B->AssetName);
+		}
+
+		/**
+		 * Merges assets sorted by name into a list sorted by name, in linear time.
+		 * Equal names keep the existing entries first, like an insertion at the upper bound.
+		 */
+		void MergeSortedByAssetName(TArray<TSharedPtr<FAssetData>>& SortedList, TArray<TSharedPtr<FAssetData>>&& SortedNewItems)
+		{
+			int32 Read = SortedList.Num() - 1;
+			int32 ReadNew = SortedNewItems.Num() - 1;
+			int32 Write = SortedList.Num() + SortedNewItems.Num() - 1;
+
+			SortedList.SetNum(Write + 1);
+
+			/** Fill from the back so no element is overwritten before it is moved */
+			while (ReadNew >= 0)
+			{
+				if (Read >= 0 && IsLessByAssetName(SortedNewItems[ReadNew], SortedList[Read]))
+				{
+					SortedList[Write--] = MoveTemp(SortedList[Read--]);
+				}
+				else
+				{
+					SortedList[Write--] = MoveTemp(SortedNewItems[ReadNew--]);
+				}
+			}
+		}
+
 		FString GetAssetDiskSize (const FAssetData& AssetData)
 		{
 			FString PackageFileName;
@@ -676,6 +709,7 @@ void SDataAssetManagerWidget::Construct(const FArguments& InArgs)
 	bCanSupportFocus = true;
 
 	SubscribeToAssetRegistryEvent();
+	SettingsChangedHandle = GetMutableDefault<UDataAssetManagerSettings>()->OnSettingChanged().AddSP(this, &SDataAssetManagerWidget::OnPluginSettingsChanged);
 	LoadDataAssets(DataAssetManager::Private::GetPluginSettings());
 	UpdateFilteredAssetList();
 	InitializeAssetTypeComboBox(FilteredDataAssets);
@@ -900,6 +934,11 @@ void SDataAssetManagerWidget::Construct(const FArguments& InArgs)
 		? FString::Printf(TEXT("(%d selected)"), GetAssetListSelectedItem().Num())
 		: TEXT("");
 
+	if (DiscoveryState.IsValid())
+	{
+		return FText::FromString(FString::Printf(TEXT("   %d items %s (scanning... %d found)"), FilteredDataAssets.Num(), *SelectedStrItems, DiscoveryState->NumFound.load()));
+	}
+
 	return FText::FromString(FString::Printf(TEXT("   %d items %s"), FilteredDataAssets.Num(), *SelectedStrItems));
  }
 
@@ -920,6 +959,21 @@ SDataAssetManagerWidget::~SDataAssetManagerWidget()
 		SafeRemove(AssetRemovedDelegateHandle, AssetRegistryModule->Get().OnAssetRemoved());
 		SafeRemove(AssetRenamedDelegateHandle, AssetRegistryModule->Get().OnAssetRenamed());
 		SafeRemove(FilesLoadedHandle, AssetRegistryModule->Get().OnFilesLoaded());
+		SafeRemove(DiscoveryFilesLoadedHandle, AssetRegistryModule->Get().OnFilesLoaded());
+	}
+
+	CancelDataAssetDiscovery();
+
+	if (SettingsChangedHandle.IsValid())
+	{
+		GetMutableDefault<UDataAssetManagerSettings>()->OnSettingChanged().Remove(SettingsChangedHandle);
+		SettingsChangedHandle.Reset();
+	}
+
+	if (PendingAssetChangesTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingAssetChangesTickerHandle);
+		PendingAssetChangesTickerHandle.Reset();
 	}
 }
 inline void SDataAssetManagerWidget::HandleAssetDoubleClick(const FGeometry& InGeometry, const FPointerEvent& MouseEvent)
@@ -1142,69 +1196,330 @@ void SDataAssetManagerWidget::LoadDataAssets(const UDataAssetManagerSettings* Pl
 {	
 	if (!PluginSettings) return;
 
-	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::GetModuleChecked<FAssetRegistryModule>(DataAssetManager::ModuleName::AssetRegistry);
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+	CacheScanSettings(PluginSettings);
+	DataAssets.Reset();
+
+	StartDataAssetDiscovery();
+}
+
+void SDataAssetManagerWidget::StartDataAssetDiscovery()
+{
+	CancelDataAssetDiscovery();
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	/** A discovery on a partial registry is completed by a second pass once the initial scan is done */
+	if (AssetRegistry.IsLoadingAssets() && !DiscoveryFilesLoadedHandle.IsValid())
+	{
+		DiscoveryFilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddSP(this, &SDataAssetManagerWidget::OnInitialAssetScanFinished);
+	}
+
+	DiscoveryState = MakeShared<DataAssetManager::Private::FDataAssetDiscoveryState, ESPMode::ThreadSafe>();
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UDataAsset::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	/** In-memory assets can only be enumerated on the game thread; unsaved ones arrive through OnAssetAdded */
+	Filter.bIncludeOnlyOnDiskAssets = true;
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [State = DiscoveryState.ToSharedRef(), Filter = MoveTemp(Filter)]()
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(SDataAssetManagerWidget::DiscoverDataAssets);
+
+		TArray<FAssetData> Batch;
+		Batch.Reserve(DataAssetManager::Private::DiscoveryBatchSize);
+
+		IAssetRegistry::GetChecked().EnumerateAssets(Filter, [&State, &Batch](const FAssetData& AssetData)
+		{
+			if (State->bCancelled) return false;
+
+			Batch.Add(AssetData);
+			++State->NumFound;
+
+			if (Batch.Num() >= DataAssetManager::Private::DiscoveryBatchSize)
+			{
+				State->Batches.Enqueue(MoveTemp(Batch));
+				Batch.Reset(DataAssetManager::Private::DiscoveryBatchSize);
+			}
+			return true;
+		});
+
+		if (Batch.Num() > 0)
+		{
+			State->Batches.Enqueue(MoveTemp(Batch));
+		}
+		State->bFinished = true;
+	});
+
+	DiscoveryTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateSP(this, &SDataAssetManagerWidget::PublishDiscoveredDataAssets));
+}
+
+void SDataAssetManagerWidget::CancelDataAssetDiscovery()
+{
+	if (DiscoveryState.IsValid())
+	{
+		DiscoveryState->bCancelled = true;
+		DiscoveryState.Reset();
+	}
+
+	if (DiscoveryTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DiscoveryTickerHandle);
+		DiscoveryTickerHandle.Reset();
+	}
+}
+
+bool SDataAssetManagerWidget::PublishDiscoveredDataAssets(float DeltaTime)
+{
+	if (!DiscoveryState.IsValid())
+	{
+		DiscoveryTickerHandle.Reset();
+		return false;
+	}
+
+	/** Read before draining so a batch enqueued right before the flag is not missed */
+	const bool bFinished = DiscoveryState->bFinished;
+
+	/** Collected aside so DataAssets stays sorted for the duplicate lookups */
+	TArray<TSharedPtr<FAssetData>> NewDataAssets;
+	TArray<FAssetData> Batch;
+	while (DiscoveryState->Batches.Dequeue(Batch))
+	{
+		for (const FAssetData& AssetData : Batch)
+		{
+			/** Registry events or a previous pass may have listed the asset already */
+			if (IsAssetInScanScope(AssetData) && FindDataAssetIndex(AssetData.GetSoftObjectPath(), AssetData.AssetName) == INDEX_NONE)
+			{
+				NewDataAssets.Add(MakeShared<FAssetData>(AssetData));
+			}
+		}
+	}
+
+	if (NewDataAssets.Num() > 0)
+	{
+		/** Only the batch is sorted, then merged, so each tick costs the batch plus one linear pass */
+		NewDataAssets.Sort(DataAssetManager::Private::IsLessByAssetName);
+
+		const FString SearchString = SearchText.Get().ToString();
+		TArray<TSharedPtr<FAssetData>> NewFilteredDataAssets;
+		for (const TSharedPtr<FAssetData>& AssetData : NewDataAssets)
+		{
+			if (PassesAssetFilters(*AssetData, SearchString))
+			{
+				NewFilteredDataAssets.Add(AssetData);
+			}
+		}
+
+		DataAssetManager::Private::MergeSortedByAssetName(DataAssets, MoveTemp(NewDataAssets));
+
+		if (NewFilteredDataAssets.Num() > 0)
+		{
+			DataAssetManager::Private::MergeSortedByAssetName(FilteredDataAssets, MoveTemp(NewFilteredDataAssets));
+
+			if (AssetListView.IsValid())
+			{
+				AssetListView->RequestListRefresh();
+			}
+		}
+
+		if (!SelectedAsset.IsValid() && FilteredDataAssets.Num() > 0 && AssetListView.IsValid())
+		{
+			AssetListView->SetSelection(FilteredDataAssets[0]);
+			OnAssetSelected(FilteredDataAssets[0], ESelectInfo::Direct);
+		}
+	}
+
+	if (!bFinished)
+	{
+		return true;
+	}
 
-	TArray<FString> AssetDirectories;
-	AssetDirectories.Reserve(PluginSettings->ScannedAssetDirectories.Num());
+	/** The type list only needs the complete set, build it once instead of on every batch */
+	InitializeAssetTypeComboBox(DataAssets);
+
+	UE_LOG(SDataAssetManagerWidgetLog, Log, TEXT("%s Discovered %d data assets, %d listed"),
+		ANSI_TO_TCHAR(__FUNCTION__), DiscoveryState->NumFound.load(), DataAssets.Num());
+
+	DiscoveryState.Reset();
+	DiscoveryTickerHandle.Reset();
+	return false;
+}
+
+void SDataAssetManagerWidget::OnInitialAssetScanFinished()
+{
+	IAssetRegistry::GetChecked().OnFilesLoaded().Remove(DiscoveryFilesLoadedHandle);
+	DiscoveryFilesLoadedHandle.Reset();
+
+	/** Keep what was found so far, the second pass only adds the assets that were not scanned yet */
+	StartDataAssetDiscovery();
+}
 
+void SDataAssetManagerWidget::CacheScanSettings(const UDataAssetManagerSettings* PluginSettings)
+{
+	ScannedDirectories.Reset(PluginSettings->ScannedAssetDirectories.Num());
 	for (const FDirectoryPath& Dir : PluginSettings->ScannedAssetDirectories)
 	{
 		FString NormalizedPath = Dir.Path;
 		FPaths::NormalizeDirectoryName(NormalizedPath);
-		AssetDirectories.Add(MoveTemp(NormalizedPath));
+		ScannedDirectories.Add(MoveTemp(NormalizedPath));
 	}
 
-	TArray<FTopLevelAssetPath> IgnoredClassPaths;
-	IgnoredClassPaths.Reserve(PluginSettings->ExcludedScanAssetTypes.Num());
+	ExcludedClassPaths.Reset();
 	for (const TSubclassOf<UDataAsset>& IgnoredClass : PluginSettings->ExcludedScanAssetTypes)
 	{
 		if (IgnoredClass)
 		{
-			IgnoredClassPaths.Add(IgnoredClass->GetClassPathName());
+			ExcludedClassPaths.Add(IgnoredClass->GetClassPathName());
 		}
 	}
 
-	TArray<FAssetData> AssetDataArray;
-	const FTopLevelAssetPath DataAssetPath = UDataAsset::StaticClass()->GetClassPathName();
-	if (!AssetRegistry.GetAssetsByClass(DataAssetPath, AssetDataArray, true))
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::GetModuleChecked<FAssetRegistryModule>(DataAssetManager::ModuleName::AssetRegistry);
+	DataAssetClassPaths.Reset();
+	AssetRegistryModule.Get().GetDerivedClassNames({ UDataAsset::StaticClass()->GetClassPathName() }, {}, DataAssetClassPaths);
+}
+
+bool SDataAssetManagerWidget::IsAssetInScanScope(const FAssetData& AssetData) const
+{
+	if (ExcludedClassPaths.Contains(AssetData.AssetClassPath))
 	{
-		UE_LOG(SDataAssetManagerWidgetLog, Warning, TEXT("%s Failed to get assets by class"), ANSI_TO_TCHAR(__FUNCTION__));
-		return;
+		return false;
+	}
+
+	FString NormalizedAssetPath = AssetData.PackagePath.ToString();
+	FPaths::NormalizeDirectoryName(NormalizedAssetPath);
+
+	// Check if asset is in any of our directories
+	return Algo::AnyOf(ScannedDirectories, [&NormalizedAssetPath](const FString& Directory)
+	{
+	    return NormalizedAssetPath.StartsWith(Directory);
+	});
+}
+
+void SDataAssetManagerWidget::QueueAssetChange(const FSoftObjectPath* OldObjectPath, const FAssetData* NewAssetData)
+{
+	if (OldObjectPath)
+	{
+		PendingAssetChanges.Add(*OldObjectPath, TOptional<FAssetData>());
+	}
+
+	if (NewAssetData)
+	{
+		PendingAssetChanges.Add(NewAssetData->GetSoftObjectPath(), *NewAssetData);
+	}
+
+	if (!PendingAssetChangesTickerHandle.IsValid())
+	{
+		PendingAssetChangesTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateSP(this, &SDataAssetManagerWidget::FlushPendingAssetChanges));
 	}
+}
+
+bool SDataAssetManagerWidget::FlushPendingAssetChanges(float DeltaTime)
+{
+	PendingAssetChangesTickerHandle.Reset();
+
+	const auto ByAssetName = [](const TSharedPtr<FAssetData>& A, const TSharedPtr<FAssetData>& B)
+	{
+		return A->AssetName.LexicalLess(B->AssetName);
+	};
 
-	DataAssets.Reset(AssetDataArray.Num());
-	for (const FAssetData& AssetData : AssetDataArray)
+	/** Registry events report every asset type, only DataAssets belong in the list */
+	bool bRefreshedClassPaths = false;
+	const auto IsDataAsset = [this, &bRefreshedClassPaths](const FAssetData& AssetData)
 	{
-		if (IgnoredClassPaths.Contains(AssetData.AssetClassPath))
+		if (!DataAssetClassPaths.Contains(AssetData.AssetClassPath) && !bRefreshedClassPaths)
 		{
-			continue;
+			/** A DataAsset class created after the last scan, refresh the derived classes once per flush */
+			const FAssetRegistryModule& AssetRegistryModule = FModuleManager::GetModuleChecked<FAssetRegistryModule>(DataAssetManager::ModuleName::AssetRegistry);
+			AssetRegistryModule.Get().GetDerivedClassNames({ UDataAsset::StaticClass()->GetClassPathName() }, {}, DataAssetClassPaths);
+			bRefreshedClassPaths = true;
 		}
 
-		FString NormalizedAssetPath = AssetData.PackagePath.ToString();
-		FPaths::NormalizeDirectoryName(NormalizedAssetPath);
+		return DataAssetClassPaths.Contains(AssetData.AssetClassPath);
+	};
+
+	bool bListChanged = false;
+	int32 NumInserted = 0;
+	const FAssetData* LastInserted = nullptr;
+
+	for (const auto& Change : PendingAssetChanges)
+	{
+		const FSoftObjectPath& ObjectPath = Change.Key;
+		const TOptional<FAssetData>& NewAssetData = Change.Value;
+
+		/** Removals carry no asset data, the asset name is the last element of the object path */
+		const FName AssetName = NewAssetData.IsSet() ? NewAssetData->AssetName : FName(*ObjectPath.GetAssetName());
+		const int32 ExistingIndex = FindDataAssetIndex(ObjectPath, AssetName);
+
+		if (!NewAssetData.IsSet() || !IsDataAsset(NewAssetData.GetValue()) || !IsAssetInScanScope(NewAssetData.GetValue()))
+		{
+			if (ExistingIndex != INDEX_NONE)
+			{
+				DataAssets.RemoveAt(ExistingIndex, 1, EAllowShrinking::No);
+				bListChanged = true;
+			}
+			continue;
+		}
 
-		// Check if asset is in any of our directories
-		if (Algo::AnyOf(AssetDirectories, [&NormalizedAssetPath](const FString& Directory)
+		if (ExistingIndex != INDEX_NONE)
 		{
-		    return NormalizedAssetPath.StartsWith(Directory);
-		}))
+			/** Same path and name, the sort position is unchanged */
+			*DataAssets[ExistingIndex] = NewAssetData.GetValue();
+			bListChanged = true;
+			continue;
+		}
+
+		TSharedPtr<FAssetData> NewEntry = MakeShared<FAssetData>(NewAssetData.GetValue());
+		const int32 InsertIndex = Algo::UpperBound(DataAssets, NewEntry, ByAssetName);
+		DataAssets.Insert(NewEntry, InsertIndex);
+
+		bListChanged = true;
+		++NumInserted;
+		LastInserted = &NewAssetData.GetValue();
+	}
+
+	/** Copy before the pending map that owns it is reset */
+	const TOptional<FAssetData> AssetToFocus = NumInserted == 1 ? TOptional<FAssetData>(*LastInserted) : TOptional<FAssetData>();
+	PendingAssetChanges.Reset();
+
+	if (bListChanged)
+	{
+		UpdateFilteredAssetList();
+		InitializeAssetTypeComboBox(DataAssets);
+
+		/** Focus single interactive additions (create, duplicate, rename) but not bulk imports */
+		if (AssetToFocus.IsSet())
 		{
-		    DataAssets.Add(MakeShared<FAssetData>(AssetData));
+			FocusOnNewlyAddedAsset(AssetToFocus.GetValue());
 		}
 	}
 
-	/**
-	 * Sorts the found DataAssets alphabetically by asset name.
-	 *
-	 * Uses lexicographical comparison (LexicalLess) which:
-	 * - Is case-sensitive
-	 * - More efficient than string comparison as it works directly with FName
-	 */
-	DataAssets.Sort([](const TSharedPtr<FAssetData>& A, const TSharedPtr<FAssetData>& B) 
+	return false;
+}
+
+int32 SDataAssetManagerWidget::FindDataAssetIndex(const FSoftObjectPath& ObjectPath, FName AssetName) const
+{
+	int32 Index = Algo::LowerBoundBy(DataAssets, AssetName, [](const TSharedPtr<FAssetData>& Asset) { return Asset->AssetName; },
+		[](const FName& A, const FName& B) { return A.LexicalLess(B); });
+
+	/** Several packages may hold assets with the same name, scan the equal range for the path */
+	for (; Index < DataAssets.Num() && DataAssets[Index]->AssetName == AssetName; ++Index)
+	{
+		if (DataAssets[Index]->GetSoftObjectPath() == ObjectPath)
 		{
-			return A->AssetName.LexicalLess(B->AssetName);
-		});
+			return Index;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void SDataAssetManagerWidget::OnPluginSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	LoadDataAssets(DataAssetManager::Private::GetPluginSettings());
+	UpdateFilteredAssetList();
+	InitializeAssetTypeComboBox(DataAssets);
 }
 
 void SDataAssetManagerWidget::UpdateFilteredAssetList()
@@ -1213,17 +1528,7 @@ void SDataAssetManagerWidget::UpdateFilteredAssetList()
 	const FString SearchString = SearchText.Get().ToString();
 	for (const TSharedPtr<FAssetData>& AssetData : DataAssets)
 	{
-		if (!AssetData.IsValid())
-		{
-			continue;
-		}
-
-		const FString AssetClassName = AssetData->AssetClassPath.GetAssetName().ToString();
-		const bool bMatchesType = ActiveFilters.Num() == 0 || ActiveFilters.Contains(AssetClassName);
-		const bool bNameMatches = SearchString.IsEmpty() || AssetData->AssetName.ToString().Contains(SearchString);
-
-		/** Filter assets by type and name substring (case-sensitive) */
-		if (bMatchesType && bNameMatches)
+		if (AssetData.IsValid() && PassesAssetFilters(*AssetData, SearchString))
 		{
 			FilteredDataAssets.Add(AssetData);
 		}
@@ -1235,6 +1540,16 @@ void SDataAssetManagerWidget::UpdateFilteredAssetList()
 	}
 }
 
+bool SDataAssetManagerWidget::PassesAssetFilters(const FAssetData& AssetData, const FString& SearchString) const
+{
+	const FString AssetClassName = AssetData.AssetClassPath.GetAssetName().ToString();
+	const bool bMatchesType = ActiveFilters.Num() == 0 || ActiveFilters.Contains(AssetClassName);
+	const bool bNameMatches = SearchString.IsEmpty() || AssetData.AssetName.ToString().Contains(SearchString);
+
+	/** Filter assets by type and name substring (case-sensitive) */
+	return bMatchesType && bNameMatches;
+}
+
 void SDataAssetManagerWidget::OnSearchTextChanged(const FText& InText)
 {
 	SearchText.Set(InText);
@@ -1652,31 +1967,20 @@ void SDataAssetManagerWidget::ProcessAssetData(const TArray<FAssetData>& RefAsse
 
 void SDataAssetManagerWidget::OnAssetAdded(const FAssetData& NewAssetData)
 {
-	LoadDataAssets(DataAssetManager::Private::GetPluginSettings());
-	UpdateFilteredAssetList();
-	InitializeAssetTypeComboBox(DataAssets);
-
-	FocusOnNewlyAddedAsset(NewAssetData);
-
-	UE_LOG(SDataAssetManagerWidgetLog, Warning, TEXT("%s Call Delegate"), ANSI_TO_TCHAR(__FUNCTION__));
+	QueueAssetChange(nullptr, &NewAssetData);
 }
 
 void SDataAssetManagerWidget::OnAssetRemoved(const FAssetData& AssetToRemoved)
 {
-	LoadDataAssets(DataAssetManager::Private::GetPluginSettings());
-	UpdateFilteredAssetList();
-	InitializeAssetTypeComboBox(DataAssets);
-	UE_LOG(SDataAssetManagerWidgetLog, Warning, TEXT("%s Call Delegate"), ANSI_TO_TCHAR(__FUNCTION__));
+	const FSoftObjectPath RemovedObjectPath = AssetToRemoved.GetSoftObjectPath();
+	QueueAssetChange(&RemovedObjectPath, nullptr);
 }
 
 void SDataAssetManagerWidget::OnAssetRenamed(const FAssetData& NewAssetData, const FString& Name)
 {
-	LoadDataAssets(DataAssetManager::Private::GetPluginSettings());
-	UpdateFilteredAssetList();
-	InitializeAssetTypeComboBox(DataAssets);
-
-	FocusOnNewlyAddedAsset(NewAssetData);
-	UE_LOG(SDataAssetManagerWidgetLog, Warning, TEXT("%s Call Delegate"), ANSI_TO_TCHAR(__FUNCTION__));
+	/** Name holds the old object path */
+	const FSoftObjectPath OldObjectPath(Name);
+	QueueAssetChange(&OldObjectPath, &NewAssetData);
 }
 
 void SDataAssetManagerWidget::DeleteDataAsset()
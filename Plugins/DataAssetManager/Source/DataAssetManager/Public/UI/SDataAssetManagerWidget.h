@@ -9,6 +9,9 @@
 #include "Editor/PropertyEditor/Public/IDetailsView.h"
 #include "SAssetSearchBox.h"
 #include "Menu/IDataAssetManagerInterface.h"
+#include "Containers/Ticker.h"
+#include "Containers/Queue.h"
+#include <atomic>
 
 
 class UDataAssetManagerSettings;
@@ -30,6 +33,25 @@ namespace DataAssetManager
 	
 	namespace Private
 	{
+		/** Discovery progress shared between the background enumeration task and the widget. */
+		struct FDataAssetDiscoveryState
+		{
+			/** Batches of assets found on disk, produced by the task and consumed on the game thread. */
+			TQueue<TArray<FAssetData>, EQueueMode::Spsc> Batches;
+
+			/** Number of assets enumerated so far, shown as a live counter. */
+			std::atomic<int32> NumFound{ 0 };
+
+			/** Set by the task once the enumeration completed or was cancelled. */
+			std::atomic<bool> bFinished{ false };
+
+			/** Set by the widget to stop the enumeration early. */
+			std::atomic<bool> bCancelled{ false };
+		};
+
+		/** Number of assets published to the list view per batch. */
+		constexpr int32 DiscoveryBatchSize = 256;
+
 		/**
 		 * Class used to filter asset classes based on certain conditions like class flags and blueprint base class restrictions.
 		 * Implements the IClassViewerFilter interface to provide custom filtering logic for class viewer in the Unreal Editor.
@@ -247,12 +269,31 @@ private:
 	/**
 	 * Loads the data assets based on the plugin settings.
 	 *
-	 * This method retrieves and loads data assets according to the configuration specified in the plugin settings.
+	 * Clears the list and starts a background discovery that publishes found assets in batches,
+	 * so the widget is usable immediately. If the asset registry is still scanning, discovery
+	 * runs again once the initial scan finishes to complete the list.
 	 *
 	 * @param PluginSettings The settings used to load the data assets.
 	 */
 	void LoadDataAssets(const UDataAssetManagerSettings* PluginSettings);
 
+	/** Starts a background enumeration of the DataAssets on disk without clearing the current list. */
+	void StartDataAssetDiscovery();
+
+	/** Stops a running discovery; batches that were not published yet are dropped. */
+	void CancelDataAssetDiscovery();
+
+	/**
+	 * Publishes the batches found by the discovery task to the list view.
+	 *
+	 * @param DeltaTime Unused ticker delta time.
+	 * @return False once the discovery finished and every batch was published.
+	 */
+	bool PublishDiscoveredDataAssets(float DeltaTime);
+
+	/** Called when the asset registry finishes its initial scan while a discovery was started on partial data. */
+	void OnInitialAssetScanFinished();
+
 	/**
 	 * Updates the list of assets based on the applied filter.
 	 *
@@ -260,6 +301,12 @@ private:
 	 */
 	void UpdateFilteredAssetList();
 
+	/**
+	 * @param SearchString Current search box text.
+	 * @return True if the asset matches the active type filters and the search text.
+	 */
+	bool PassesAssetFilters(const FAssetData& AssetData, const FString& SearchString) const;
+
 	/**
 	 * Called when an asset is selected in the asset list.
 	 *
@@ -357,6 +404,56 @@ private:
 	 */
 	void OnAssetRenamed(const FAssetData& NewAssetData, const FString& Name);
 
+	/**
+	 * Caches the scanned directories, excluded classes and known DataAsset classes from the plugin settings.
+	 *
+	 * Used by the discovery and by the incremental updates so both apply the same scope.
+	 *
+	 * @param PluginSettings The settings defining the scan scope.
+	 */
+	void CacheScanSettings(const UDataAssetManagerSettings* PluginSettings);
+
+	/**
+	 * Checks whether an asset belongs in the DataAssets list.
+	 *
+	 * @param AssetData The asset reported by the asset registry.
+	 * @return True if the asset class is not excluded and the asset lies inside a scanned directory.
+	 */
+	bool IsAssetInScanScope(const FAssetData& AssetData) const;
+
+	/**
+	 * Queues an asset registry change and schedules a single flush for the next frame.
+	 *
+	 * @param OldObjectPath Path removed from the list, null for additions.
+	 * @param NewAssetData Asset inserted or patched in the list, null for removals.
+	 */
+	void QueueAssetChange(const FSoftObjectPath* OldObjectPath, const FAssetData* NewAssetData);
+
+	/**
+	 * Applies all queued asset changes to the sorted DataAssets array and refreshes the UI once.
+	 *
+	 * @param DeltaTime Unused ticker delta time.
+	 * @return Always false, the ticker is one-shot.
+	 */
+	bool FlushPendingAssetChanges(float DeltaTime);
+
+	/**
+	 * Finds an asset in the sorted DataAssets array by binary search on the asset name.
+	 *
+	 * @param ObjectPath Object path of the asset to find.
+	 * @param AssetName Name the array is sorted by.
+	 * @return Index in DataAssets, INDEX_NONE if the asset is not listed.
+	 */
+	int32 FindDataAssetIndex(const FSoftObjectPath& ObjectPath, FName AssetName) const;
+
+	/**
+	 * Called when the plugin settings are edited; the only case that triggers a full rescan.
+	 *
+	 * @param Settings The edited settings object.
+	 * @param PropertyChangedEvent Information about the edited property.
+	 */
+	void OnPluginSettingsChanged(UObject* Settings, struct FPropertyChangedEvent& PropertyChangedEvent);
+
 	/**
 	 * Creates a filter image for asset filtering.
 	 *
@@ -555,6 +652,38 @@ private:
 	 */
 	TArray<TSharedPtr<FAssetData>> FilteredDataAssets = {};
 
+	/**
+	 * Asset registry changes received since the last flush, keyed by object path.
+	 *
+	 * A set value inserts or patches the entry, an unset value removes it. Later events for the same
+	 * path overwrite earlier ones, so a burst of events collapses to its final state.
+	 */
+	TMap<FSoftObjectPath, TOptional<FAssetData>> PendingAssetChanges = {};
+
+	/** State shared with the running discovery task, null when no discovery is running. */
+	TSharedPtr<DataAssetManager::Private::FDataAssetDiscoveryState, ESPMode::ThreadSafe> DiscoveryState = nullptr;
+
+	/** Ticker publishing discovered batches while DiscoveryState is valid. */
+	FTSTicker::FDelegateHandle DiscoveryTickerHandle{};
+
+	/** Handle to the OnFilesLoaded subscription that restarts discovery after the initial registry scan. */
+	FDelegateHandle DiscoveryFilesLoadedHandle{};
+
+	/** One-shot ticker flushing PendingAssetChanges on the next frame. */
+	FTSTicker::FDelegateHandle PendingAssetChangesTickerHandle{};
+
+	/** Normalized directories from ScannedAssetDirectories. */
+	TArray<FString> ScannedDirectories = {};
+
+	/** Class paths from ExcludedScanAssetTypes. */
+	TSet<FTopLevelAssetPath> ExcludedClassPaths = {};
+
+	/** UDataAsset and every class derived from it known to the asset registry at scan time. */
+	TSet<FTopLevelAssetPath> DataAssetClassPaths = {};
+
+	/** Handle to the plugin settings change subscription. */
+	FDelegateHandle SettingsChangedHandle{};
+
 	/**
 	 * Assets queued for deferred deletion.
 	 *
@@ -2,6 +2,248 @@
 
 
 #include "BaseClasses/BlueprintValidatorBase.h"
+#include "Library/ValidationResultCache.h"
+#include "Library/BlueprintGraphIndex.h"
+#include "Library/BlueprintGraphSnapshot.h"
+#include "BlueprintEditorModule.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "EdGraph/EdGraph.h"
+#include "Misc/DataValidation.h"
+#include "Misc/PackageName.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Subsystems/AssetEditorSubsystem.h"
 
+UE_TRACE_CHANNEL_DEFINE(ValidatorXChannel);
 
+EDataValidationResult UBlueprintValidatorBase::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+{
+	// The asset is already loaded, its registry tags would save nothing and may be stale
+	if(InAsset ? !PassesAssetPrefilter(InAsset) : !PassesAssetPrefilter(InAssetData))
+	{
+		return EDataValidationResult::NotValidated;
+	}
 
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*GetClass()->GetName(), ValidatorXChannel);
+
+	const int32 FirstIssue = Context.GetIssues().Num();
+	const double StartTime = FPlatformTime::Seconds();
+
+	bool bCacheHit = false;
+	const EDataValidationResult Result = ValidateWithCache(InAssetData, InAsset, Context, bCacheHit);
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+	++Stats.Calls;
+	Stats.CacheHits += bCacheHit ? 1 : 0;
+	Stats.Failures += Result == EDataValidationResult::Invalid ? 1 : 0;
+	Stats.MessagesEmitted += Context.GetIssues().Num() - FirstIssue;
+	Stats.TotalSeconds += Seconds;
+	Stats.MaxSeconds = FMath::Max(Stats.MaxSeconds, Seconds);
+
+	if(!bCacheHit)
+	{
+		Stats.UncachedSeconds += Seconds;
+		Stats.MaxUncachedSeconds = FMath::Max(Stats.MaxUncachedSeconds, Seconds);
+	}
+
+	const UBlueprint* Blueprint = Cast<UBlueprint>(InAsset);
+	if(Blueprint && !bCacheHit)
+	{
+		TArray<UEdGraph*> Graphs;
+		Blueprint->GetAllGraphs(Graphs);
+
+		for(const UEdGraph* Graph : Graphs)
+		{
+			Stats.NodesVisited += Graph ? Graph->Nodes.Num() : 0;
+		}
+	}
+
+	return Result;
+}
+
+void UBlueprintValidatorBase::GetAssetPrefilter(FValidatorAssetPrefilter& OutPrefilter) const
+{
+	OutPrefilter.AssetClasses.Add(UBlueprint::StaticClass());
+}
+
+const FValidatorAssetPrefilter& UBlueprintValidatorBase::GetCachedAssetPrefilter() const
+{
+	if(!AssetPrefilter.IsSet())
+	{
+		GetAssetPrefilter(AssetPrefilter.Emplace());
+	}
+
+	return *AssetPrefilter;
+}
+
+bool UBlueprintValidatorBase::PassesAssetPrefilter(const FAssetData& InAssetData) const
+{
+	const FValidatorAssetPrefilter& Prefilter = GetCachedAssetPrefilter();
+
+	if(Prefilter.AssetClasses.Num() > 0 && !Prefilter.AssetClasses.ContainsByPredicate([&InAssetData] (const UClass* Class) { return InAssetData.IsInstanceOf(Class); }))
+	{
+		return false;
+	}
+
+	FString TagValue;
+
+	if(Prefilter.bRequiresGraphData && InAssetData.GetTagValue(FBlueprintTags::IsDataOnly, TagValue) && TagValue.ToBool())
+	{
+		return false;
+	}
+
+	if(Prefilter.NativeParentClasses.Num() > 0 && InAssetData.GetTagValue(FBlueprintTags::NativeParentClassPath, TagValue))
+	{
+		// Native classes are always loaded, an unknown one belongs to a module that is not
+		const UClass* NativeParentClass = FindObject<UClass>(FTopLevelAssetPath(FPackageName::ExportTextPathToObjectPath(TagValue)));
+		if(!NativeParentClass || !Prefilter.NativeParentClasses.ContainsByPredicate([NativeParentClass] (const UClass* Class) { return NativeParentClass->IsChildOf(Class); }))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool UBlueprintValidatorBase::PassesAssetPrefilter(const UObject* InAsset) const
+{
+	const FValidatorAssetPrefilter& Prefilter = GetCachedAssetPrefilter();
+
+	if(Prefilter.AssetClasses.Num() > 0 && !Prefilter.AssetClasses.ContainsByPredicate([InAsset] (const UClass* Class) { return InAsset->IsA(Class); }))
+	{
+		return false;
+	}
+
+	const UBlueprint* Blueprint = Cast<UBlueprint>(InAsset);
+	if(!Blueprint) return true;
+
+	if(Prefilter.bRequiresGraphData && FBlueprintEditorUtils::IsDataOnlyBlueprint(Blueprint))
+	{
+		return false;
+	}
+
+	if(Prefilter.NativeParentClasses.Num() > 0)
+	{
+		const UClass* NativeParentClass = FBlueprintEditorUtils::FindFirstNativeClass(Blueprint->ParentClass);
+		if(!NativeParentClass || !Prefilter.NativeParentClasses.ContainsByPredicate([NativeParentClass] (const UClass* Class) { return NativeParentClass->IsChildOf(Class); }))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+EDataValidationResult UBlueprintValidatorBase::ValidateWithCache(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context, bool& bOutCacheHit)
+{
+	FValidationResultCache& ResultCache = FValidationResultCache::Get();
+
+	FIoHash CacheKey;
+	const bool bHasCacheKey = PrecomputedCacheKey ? PrecomputedCacheKey->IsSet() : ResultCache.ComputeKey(*this, InAssetData, CacheKey);
+	if(!bHasCacheKey)
+	{
+		return ValidateBlueprintAsset(InAssetData, InAsset, Context);
+	}
+
+	if(PrecomputedCacheKey)
+	{
+		CacheKey = PrecomputedCacheKey->GetValue();
+	}
+
+	const FName ValidatorName = GetClass()->GetFName();
+
+	if(const FCachedValidationResult* Cached = ResultCache.Find(InAssetData.PackageName, ValidatorName, CacheKey))
+	{
+		ResultCache.Replay(*this, InAssetData, *Cached, Context);
+		bIsError = Cached->Result == EDataValidationResult::Invalid;
+		bOutCacheHit = true;
+		return Cached->Result;
+	}
+
+	// The context may already hold the issues of the validators that ran before this one
+	const int32 FirstIssue = Context.GetIssues().Num();
+	bIsResultPartial = false;
+	const EDataValidationResult Result = ValidateBlueprintAsset(InAssetData, InAsset, Context);
+
+	if(bIsResultPartial) return Result;
+
+	ResultCache.Store(InAssetData.PackageName, ValidatorName, CacheKey, Result, MakeArrayView(Context.GetIssues()).RightChop(FirstIssue));
+	return Result;
+}
+
+EDataValidationResult UBlueprintValidatorBase::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+{
+	UBlueprint* Blueprint = Cast<UBlueprint>(InAsset);
+	if(!SupportsSnapshotAnalysis() || !Blueprint)
+	{
+		return EDataValidationResult::NotValidated;
+	}
+
+	if(PendingFindings)
+	{
+		return ReportSnapshotFindings(*PendingFindings->Snapshot, PendingFindings->Findings, Context);
+	}
+
+	const TSharedRef<const FBlueprintGraphSnapshot> Snapshot = FBlueprintGraphIndexCache::Get().FindOrCaptureSnapshot(Blueprint);
+
+	TArray<FBlueprintSnapshotFinding> Findings;
+	AnalyzeSnapshot(*Snapshot, Findings);
+
+	return ReportSnapshotFindings(*Snapshot, Findings, Context);
+}
+
+EDataValidationResult UBlueprintValidatorBase::ValidateAssetWithFindings(const FAssetData& InAssetData, UObject* InAsset, const FBlueprintGraphSnapshot& Snapshot,
+	TConstArrayView<FBlueprintSnapshotFinding> Findings, FDataValidationContext& InContext, const TOptional<FIoHash>* InCacheKey)
+{
+	const FPendingFindings Pending{ &Snapshot, Findings };
+	TGuardValue<const FPendingFindings*> PendingGuard(PendingFindings, &Pending);
+
+	return ValidateAsset(InAssetData, InAsset, InContext, InCacheKey);
+}
+
+EDataValidationResult UBlueprintValidatorBase::ReportSnapshotFindings(const FBlueprintGraphSnapshot& Snapshot, TConstArrayView<FBlueprintSnapshotFinding> Findings, FDataValidationContext& Context)
+{
+	check(IsInGameThread());
+
+	bIsError = Findings.Num() > 0;
+
+	for(const FBlueprintSnapshotFinding& Finding : Findings)
+	{
+		const TSharedRef<FTokenizedMessage> Message = Context.AddMessage(Finding.Severity, Finding.Text);
+
+		if(Finding.JumpLabel.IsEmpty() || !Snapshot.Graphs.IsValidIndex(Finding.Graph)) continue;
+
+		const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[Finding.Graph];
+		const TWeakObjectPtr<UBlueprint> WeakBlueprint = Snapshot.Blueprint;
+		const TWeakObjectPtr<UEdGraph> WeakGraph = Graph.Source;
+		const TWeakObjectPtr<UEdGraphNode> WeakNode = Graph.Nodes.IsValidIndex(Finding.Node) ? Graph.Nodes[Finding.Node].Source : nullptr;
+
+		Message->AddToken(FActionToken::Create(Finding.JumpLabel, FText::GetEmpty(),
+			FSimpleDelegate::CreateLambda([WeakBlueprint, WeakGraph, WeakNode]
+				{
+					UBlueprint* Blueprint = WeakBlueprint.Get();
+					UEdGraph* Graph = WeakGraph.Get();
+					if(!Blueprint || !Graph) return;
+
+					if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+					{
+						AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+						if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+						{
+							if(IBlueprintEditor* BlueprintEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
+							{
+								TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true);
+								if(GraphEditor.IsValid() && WeakNode.IsValid())
+								{
+									GraphEditor->JumpToNode(WeakNode.Get(), false);
+								}
+							}
+						}
+					}
+				})));
+	}
+
+	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+}
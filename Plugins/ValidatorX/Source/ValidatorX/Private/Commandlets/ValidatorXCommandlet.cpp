@@ -0,0 +1,651 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/ValidatorXCommandlet.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "Library/BlueprintGraphIndex.h"
+#include "Library/BlueprintGraphSnapshot.h"
+#include "Library/ClassDefaultTextCache.h"
+#include "Library/ValidationResultCache.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Blueprint.h"
+#include "Misc/DataValidation.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectIterator.h"
+
+DEFINE_LOG_CATEGORY_STATIC(ValidatorXCommandletLog, All, All);
+
+namespace ValidatorXCommandlet
+{
+	struct FMessageResult
+	{
+		EMessageSeverity::Type Severity = EMessageSeverity::Info;
+		FString Text;
+	};
+
+	struct FValidatorResult
+	{
+		int32 ValidatorIndex = INDEX_NONE;
+		EDataValidationResult Result = EDataValidationResult::NotValidated;
+		double Seconds = 0.0;
+		TArray<FMessageResult> Messages;
+	};
+
+	struct FAssetResult
+	{
+		FString ObjectPath;
+		EDataValidationResult Result = EDataValidationResult::NotValidated;
+		double Seconds = 0.0;
+		bool bLoadFailed = false;
+		bool bFromCache = false;
+		TArray<FValidatorResult> Validators;
+	};
+
+	struct FValidatorStats
+	{
+		int32 Calls = 0;
+		int32 Failures = 0;
+		int32 CacheHits = 0;
+		double TotalSeconds = 0.0;
+		double MaxSeconds = 0.0;
+	};
+
+	/** Analysis of one Blueprint snapshot by one snapshot validator, run on a worker thread. */
+	struct FSnapshotJob
+	{
+		int32 ValidatorIndex = INDEX_NONE;
+		TSharedRef<const FBlueprintGraphSnapshot> Snapshot;
+		TArray<FBlueprintSnapshotFinding> Findings;
+		double Seconds = 0.0;
+	};
+
+	const TCHAR* ResultToString(EDataValidationResult Result)
+	{
+		switch(Result)
+		{
+		case EDataValidationResult::Invalid: return TEXT("Invalid");
+		case EDataValidationResult::Valid: return TEXT("Valid");
+		default: return TEXT("NotValidated");
+		}
+	}
+
+	const TCHAR* SeverityToString(EMessageSeverity::Type Severity)
+	{
+		switch(Severity)
+		{
+		case EMessageSeverity::Error: return TEXT("Error");
+		case EMessageSeverity::PerformanceWarning:
+		case EMessageSeverity::Warning: return TEXT("Warning");
+		default: return TEXT("Info");
+		}
+	}
+
+	void MergeResult(FAssetResult& AssetResult, EDataValidationResult Result)
+	{
+		if(Result == EDataValidationResult::Invalid)
+		{
+			AssetResult.Result = EDataValidationResult::Invalid;
+		}
+		else if(Result == EDataValidationResult::Valid && AssetResult.Result == EDataValidationResult::NotValidated)
+		{
+			AssetResult.Result = EDataValidationResult::Valid;
+		}
+	}
+
+	FString EscapeXml(const FString& Text)
+	{
+		FString Escaped = Text.Replace(TEXT("&"), TEXT("&amp;"));
+		Escaped.ReplaceInline(TEXT("<"), TEXT("&lt;"));
+		Escaped.ReplaceInline(TEXT(">"), TEXT("&gt;"));
+		Escaped.ReplaceInline(TEXT("\""), TEXT("&quot;"));
+		Escaped.ReplaceInline(TEXT("'"), TEXT("&apos;"));
+		return Escaped;
+	}
+
+	bool WriteJson(const FString& FileName, const TArray<FString>& Paths, const TArray<FString>& ValidatorNames,
+		const TArray<FValidatorStats>& Stats, const TArray<FAssetResult>& Results, double TotalSeconds)
+	{
+		FString JsonString;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+
+		int32 NumInvalid = 0;
+		for(const FAssetResult& AssetResult : Results)
+		{
+			NumInvalid += AssetResult.Result == EDataValidationResult::Invalid ? 1 : 0;
+		}
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("paths"), Paths);
+		Writer->WriteValue(TEXT("numAssets"), Results.Num());
+		Writer->WriteValue(TEXT("numInvalid"), NumInvalid);
+		Writer->WriteValue(TEXT("totalMs"), TotalSeconds * 1000.0);
+
+		Writer->WriteArrayStart(TEXT("validators"));
+		for(int32 ValidatorIndex = 0; ValidatorIndex < ValidatorNames.Num(); ++ValidatorIndex)
+		{
+			const FValidatorStats& ValidatorStats = Stats[ValidatorIndex];
+
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("name"), ValidatorNames[ValidatorIndex]);
+			Writer->WriteValue(TEXT("calls"), ValidatorStats.Calls);
+			Writer->WriteValue(TEXT("failures"), ValidatorStats.Failures);
+			Writer->WriteValue(TEXT("cacheHits"), ValidatorStats.CacheHits);
+			Writer->WriteValue(TEXT("totalMs"), ValidatorStats.TotalSeconds * 1000.0);
+			Writer->WriteValue(TEXT("meanMs"), ValidatorStats.Calls > ValidatorStats.CacheHits ? ValidatorStats.TotalSeconds * 1000.0 / (ValidatorStats.Calls - ValidatorStats.CacheHits) : 0.0);
+			Writer->WriteValue(TEXT("maxMs"), ValidatorStats.MaxSeconds * 1000.0);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("assets"));
+		for(const FAssetResult& AssetResult : Results)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("path"), AssetResult.ObjectPath);
+			Writer->WriteValue(TEXT("result"), AssetResult.bLoadFailed ? TEXT("LoadFailed") : ResultToString(AssetResult.Result));
+			Writer->WriteValue(TEXT("cached"), AssetResult.bFromCache);
+			Writer->WriteValue(TEXT("timeMs"), AssetResult.Seconds * 1000.0);
+
+			Writer->WriteArrayStart(TEXT("validators"));
+			for(const FValidatorResult& ValidatorResult : AssetResult.Validators)
+			{
+				Writer->WriteObjectStart();
+				Writer->WriteValue(TEXT("name"), ValidatorNames[ValidatorResult.ValidatorIndex]);
+				Writer->WriteValue(TEXT("result"), ResultToString(ValidatorResult.Result));
+				Writer->WriteValue(TEXT("timeMs"), ValidatorResult.Seconds * 1000.0);
+
+				Writer->WriteArrayStart(TEXT("messages"));
+				for(const FMessageResult& Message : ValidatorResult.Messages)
+				{
+					Writer->WriteObjectStart();
+					Writer->WriteValue(TEXT("severity"), SeverityToString(Message.Severity));
+					Writer->WriteValue(TEXT("text"), Message.Text);
+					Writer->WriteObjectEnd();
+				}
+				Writer->WriteArrayEnd();
+
+				Writer->WriteObjectEnd();
+			}
+			Writer->WriteArrayEnd();
+
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		return FFileHelper::SaveStringToFile(JsonString, *FileName, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	}
+
+	bool WriteJUnit(const FString& FileName, const TArray<FString>& ValidatorNames, const TArray<FValidatorStats>& Stats,
+		const TArray<FAssetResult>& Results, double TotalSeconds)
+	{
+		// One test suite per validator, one test case per asset it validated
+		TArray<FString> SuitesXml;
+		SuitesXml.SetNum(ValidatorNames.Num());
+
+		int32 NumTests = 0;
+		int32 NumFailures = 0;
+
+		for(const FAssetResult& AssetResult : Results)
+		{
+			for(const FValidatorResult& ValidatorResult : AssetResult.Validators)
+			{
+				FString& SuiteXml = SuitesXml[ValidatorResult.ValidatorIndex];
+				SuiteXml += FString::Printf(TEXT("    <testcase classname=\"ValidatorX.%s\" name=\"%s\" time=\"%.6f\""),
+					*ValidatorNames[ValidatorResult.ValidatorIndex], *EscapeXml(AssetResult.ObjectPath), ValidatorResult.Seconds);
+
+				++NumTests;
+
+				if(ValidatorResult.Result != EDataValidationResult::Invalid)
+				{
+					SuiteXml += TEXT("/>\n");
+					continue;
+				}
+
+				++NumFailures;
+
+				FString Details;
+				for(const FMessageResult& Message : ValidatorResult.Messages)
+				{
+					Details += FString::Printf(TEXT("[%s] %s\n"), SeverityToString(Message.Severity), *Message.Text);
+				}
+
+				const FString Summary = ValidatorResult.Messages.Num() > 0 ? ValidatorResult.Messages[0].Text : FString(TEXT("Validation failed"));
+				SuiteXml += FString::Printf(TEXT(">\n      <failure message=\"%s\">%s</failure>\n    </testcase>\n"), *EscapeXml(Summary), *EscapeXml(Details));
+			}
+		}
+
+		FString Xml = TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+		Xml += FString::Printf(TEXT("<testsuites name=\"ValidatorX\" tests=\"%d\" failures=\"%d\" time=\"%.3f\">\n"), NumTests, NumFailures, TotalSeconds);
+
+		for(int32 ValidatorIndex = 0; ValidatorIndex < ValidatorNames.Num(); ++ValidatorIndex)
+		{
+			const FValidatorStats& ValidatorStats = Stats[ValidatorIndex];
+			Xml += FString::Printf(TEXT("  <testsuite name=\"%s\" tests=\"%d\" failures=\"%d\" time=\"%.6f\">\n"),
+				*ValidatorNames[ValidatorIndex], ValidatorStats.Calls, ValidatorStats.Failures, ValidatorStats.TotalSeconds);
+			Xml += SuitesXml[ValidatorIndex];
+			Xml += TEXT("  </testsuite>\n");
+		}
+
+		Xml += TEXT("</testsuites>\n");
+
+		return FFileHelper::SaveStringToFile(Xml, *FileName, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	}
+}
+
+UValidatorXCommandlet::UValidatorXCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+
+	HelpDescription = TEXT("Validates every Blueprint under the given paths with the ValidatorX validators.");
+	HelpUsage = TEXT("-run=ValidatorX [-Paths=/Game/A+/Game/B] [-Validators=Name+Name] [-BatchSize=256] [-Json=<File>] [-JUnit=<File>] [-NoCache] [-NoFail]");
+}
+
+int32 UValidatorXCommandlet::Main(const FString& Params)
+{
+	using namespace ValidatorXCommandlet;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UValidatorXCommandlet::Main);
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	TArray<FString> Paths;
+	if(const FString* PathsValue = ParamValues.Find(TEXT("Paths")))
+	{
+		PathsValue->ParseIntoArray(Paths, TEXT("+"), true);
+	}
+	if(Paths.Num() == 0)
+	{
+		Paths.Add(TEXT("/Game"));
+	}
+
+	TArray<FString> ValidatorFilter;
+	if(const FString* ValidatorsValue = ParamValues.Find(TEXT("Validators")))
+	{
+		ValidatorsValue->ParseIntoArray(ValidatorFilter, TEXT("+"), true);
+	}
+
+	int32 BatchSize = 256;
+	if(const FString* BatchSizeValue = ParamValues.Find(TEXT("BatchSize")))
+	{
+		BatchSize = FMath::Max(1, FCString::Atoi(**BatchSizeValue));
+	}
+
+	const FString* JsonFileName = ParamValues.Find(TEXT("Json"));
+	const FString* JUnitFileName = ParamValues.Find(TEXT("JUnit"));
+	const bool bNoFail = Switches.Contains(TEXT("NoFail"));
+	const bool bNoCache = Switches.Contains(TEXT("NoCache"));
+
+	const TArray<UBlueprintValidatorBase*> Validators = CreateValidators(ValidatorFilter);
+	if(Validators.Num() == 0)
+	{
+		UE_LOG(ValidatorXCommandletLog, Error, TEXT("No validator matches -Validators=%s"), *FString::Join(ValidatorFilter, TEXT("+")));
+		return 1;
+	}
+
+	TArray<FString> ValidatorNames;
+	for(const UBlueprintValidatorBase* Validator : Validators)
+	{
+		ValidatorNames.Add(Validator->GetClass()->GetName());
+	}
+
+	// Gather the candidates from the registry only, nothing is loaded yet
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for(const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(FName(*Path));
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	// Blueprints that no validator could flag by their registry tags are never loaded
+	const int32 NumCandidates = Assets.Num();
+	Assets.RemoveAllSwap([&Validators] (const FAssetData& AssetData)
+		{
+			return !Validators.ContainsByPredicate([&AssetData] (const UBlueprintValidatorBase* Validator) { return Validator->PassesAssetPrefilter(AssetData); });
+		});
+	Assets.Sort([] (const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+
+	UE_LOG(ValidatorXCommandletLog, Display, TEXT("%d of %d Blueprints are rejected by the validator prefilters"), NumCandidates - Assets.Num(), NumCandidates);
+
+	UE_LOG(ValidatorXCommandletLog, Display, TEXT("Validating %d Blueprints under %s with %d validators in batches of %d"),
+		Assets.Num(), *FString::Join(Paths, TEXT(", ")), Validators.Num(), BatchSize);
+
+	TArray<FAssetResult> Results;
+	Results.SetNum(Assets.Num());
+
+	TArray<FValidatorStats> Stats;
+	Stats.SetNum(Validators.Num());
+
+	// Assets whose results are all cached for their current package hashes are never loaded
+	FValidationResultCache& ResultCache = FValidationResultCache::Get();
+	ResultCache.SetEnabled(!bNoCache);
+
+	TArray<int32> PendingAssetIndices;
+	TArray<const FCachedValidationResult*> CachedResults;
+
+	// Keys hash every cache dependency, e.g. a whole hard reference closure, so each pair is hashed once here
+	// and reused by the snapshot skip check and the validation call. Unset where no key could be computed.
+	const int32 NumValidators = Validators.Num();
+	TArray<TOptional<FIoHash>> CacheKeys;
+	CacheKeys.SetNum(Assets.Num() * NumValidators);
+
+	for(int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
+	{
+		const FAssetData& AssetData = Assets[AssetIndex];
+
+		FAssetResult& AssetResult = Results[AssetIndex];
+		AssetResult.ObjectPath = AssetData.GetObjectPathString();
+
+		// Validators rejecting the asset by prefilter need no cached result, they would not run on it
+		CachedResults.Reset();
+		bool bAllCached = true;
+		for(int32 ValidatorIndex = 0; ValidatorIndex < NumValidators; ++ValidatorIndex)
+		{
+			const UBlueprintValidatorBase* Validator = Validators[ValidatorIndex];
+			if(!Validator->PassesAssetPrefilter(AssetData))
+			{
+				CachedResults.Add(nullptr);
+				continue;
+			}
+
+			FIoHash CacheKey;
+			const FCachedValidationResult* Cached = nullptr;
+			if(ResultCache.ComputeKey(*Validator, AssetData, CacheKey))
+			{
+				CacheKeys[AssetIndex * NumValidators + ValidatorIndex] = CacheKey;
+				Cached = ResultCache.Find(AssetData.PackageName, Validator->GetClass()->GetFName(), CacheKey);
+			}
+
+			// Keep going so the keys of every validator are ready for the validation of the asset
+			bAllCached = bAllCached && Cached != nullptr;
+			CachedResults.Add(Cached);
+		}
+
+		if(!bAllCached)
+		{
+			PendingAssetIndices.Add(AssetIndex);
+			continue;
+		}
+
+		AssetResult.bFromCache = true;
+
+		for(int32 ValidatorIndex = 0; ValidatorIndex < Validators.Num(); ++ValidatorIndex)
+		{
+			if(!CachedResults[ValidatorIndex]) continue;
+
+			const FCachedValidationResult& Cached = *CachedResults[ValidatorIndex];
+
+			FValidatorResult& ValidatorResult = AssetResult.Validators.AddDefaulted_GetRef();
+			ValidatorResult.ValidatorIndex = ValidatorIndex;
+			ValidatorResult.Result = Cached.Result;
+
+			for(const FCachedValidationMessage& CachedMessage : Cached.Messages)
+			{
+				FMessageResult& Message = ValidatorResult.Messages.AddDefaulted_GetRef();
+				Message.Severity = CachedMessage.Severity;
+				Message.Text = CachedMessage.Text;
+			}
+
+			FValidatorStats& ValidatorStats = Stats[ValidatorIndex];
+			++ValidatorStats.Calls;
+			++ValidatorStats.CacheHits;
+			ValidatorStats.Failures += Cached.Result == EDataValidationResult::Invalid ? 1 : 0;
+
+			MergeResult(AssetResult, Cached.Result);
+		}
+	}
+
+	UE_LOG(ValidatorXCommandletLog, Display, TEXT("%d of %d Blueprints are unchanged since they were last validated"),
+		Assets.Num() - PendingAssetIndices.Num(), Assets.Num());
+
+	// Loaded assets of the batch being validated and of the batch loading ahead; both survive the GC between batches
+	TArray<TStrongObjectPtr<UObject>> CurrentBatchObjects;
+	TArray<TStrongObjectPtr<UObject>> NextBatchObjects;
+	TArray<int32> RequestIds;
+
+	const int32 NumBatches = FMath::DivideAndRoundUp(PendingAssetIndices.Num(), BatchSize);
+
+	const auto RequestBatch = [&Assets, &PendingAssetIndices, &NextBatchObjects, &RequestIds, BatchSize] (int32 BatchIndex)
+		{
+			const int32 Begin = BatchIndex * BatchSize;
+			const int32 End = FMath::Min(Begin + BatchSize, PendingAssetIndices.Num());
+
+			for(int32 PendingIndex = Begin; PendingIndex < End; ++PendingIndex)
+			{
+				const FAssetData& AssetData = Assets[PendingAssetIndices[PendingIndex]];
+				const FSoftObjectPath ObjectPath = AssetData.GetSoftObjectPath();
+				RequestIds.Add(LoadPackageAsync(AssetData.PackageName.ToString(),
+					FLoadPackageAsyncDelegate::CreateLambda([&NextBatchObjects, ObjectPath] (const FName&, UPackage*, EAsyncLoadingResult::Type Result)
+						{
+							if(Result != EAsyncLoadingResult::Succeeded) return;
+
+							if(UObject* Object = ObjectPath.ResolveObject())
+							{
+								NextBatchObjects.Emplace(Object);
+							}
+						})));
+			}
+		};
+
+	double LoadWaitSeconds = 0.0;
+
+	if(NumBatches > 0)
+	{
+		RequestBatch(0);
+	}
+
+	for(int32 BatchIndex = 0; BatchIndex < NumBatches; ++BatchIndex)
+	{
+		const double WaitStartTime = FPlatformTime::Seconds();
+		for(const int32 RequestId : RequestIds)
+		{
+			FlushAsyncLoading(RequestId);
+		}
+		LoadWaitSeconds += FPlatformTime::Seconds() - WaitStartTime;
+
+		CurrentBatchObjects = MoveTemp(NextBatchObjects);
+		NextBatchObjects.Reset();
+		RequestIds.Reset();
+
+		// Start loading the next batch before validating this one
+		if(BatchIndex + 1 < NumBatches)
+		{
+			RequestBatch(BatchIndex + 1);
+		}
+
+		const int32 Begin = BatchIndex * BatchSize;
+		const int32 End = FMath::Min(Begin + BatchSize, PendingAssetIndices.Num());
+
+		// Snapshot the batch on the game thread, then run the snapshot validators on all cores
+		TArray<FSnapshotJob> SnapshotJobs;
+		TArray<int32> SnapshotJobIndices;
+		SnapshotJobIndices.Init(INDEX_NONE, (End - Begin) * Validators.Num());
+
+		for(int32 PendingIndex = Begin; PendingIndex < End; ++PendingIndex)
+		{
+			const int32 AssetIndex = PendingAssetIndices[PendingIndex];
+			const FAssetData& AssetData = Assets[AssetIndex];
+
+			UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.FastGetAsset(false));
+			if(!Blueprint) continue;
+
+			for(int32 ValidatorIndex = 0; ValidatorIndex < Validators.Num(); ++ValidatorIndex)
+			{
+				const UBlueprintValidatorBase* Validator = Validators[ValidatorIndex];
+				if(!Validator->SupportsSnapshotAnalysis() || !Validator->PassesAssetPrefilter(AssetData)) continue;
+
+				// Cached results are replayed on the game thread, analyzing them again would be wasted
+				const TOptional<FIoHash>& CacheKey = CacheKeys[AssetIndex * NumValidators + ValidatorIndex];
+				if(CacheKey.IsSet() && ResultCache.Find(AssetData.PackageName, Validator->GetClass()->GetFName(), CacheKey.GetValue())) continue;
+
+				SnapshotJobIndices[(PendingIndex - Begin) * Validators.Num() + ValidatorIndex] = SnapshotJobs.Num();
+				SnapshotJobs.Add(FSnapshotJob{ ValidatorIndex, FBlueprintGraphIndexCache::Get().FindOrCaptureSnapshot(Blueprint) });
+			}
+		}
+
+		ParallelFor(SnapshotJobs.Num(), [&SnapshotJobs, &Validators, &ValidatorNames] (int32 JobIndex)
+			{
+				FSnapshotJob& Job = SnapshotJobs[JobIndex];
+				TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*ValidatorNames[Job.ValidatorIndex], ValidatorXChannel);
+
+				const double JobStartTime = FPlatformTime::Seconds();
+				Validators[Job.ValidatorIndex]->AnalyzeSnapshot(*Job.Snapshot, Job.Findings);
+				Job.Seconds = FPlatformTime::Seconds() - JobStartTime;
+			});
+
+		for(int32 PendingIndex = Begin; PendingIndex < End; ++PendingIndex)
+		{
+			const int32 AssetIndex = PendingAssetIndices[PendingIndex];
+			const FAssetData& AssetData = Assets[AssetIndex];
+			FAssetResult& AssetResult = Results[AssetIndex];
+
+			// Falls back to a synchronous load if the async request failed
+			UObject* Asset = AssetData.GetAsset();
+			if(!Asset)
+			{
+				AssetResult.bLoadFailed = true;
+				UE_LOG(ValidatorXCommandletLog, Warning, TEXT("Failed to load %s"), *AssetResult.ObjectPath);
+				continue;
+			}
+
+			const double AssetStartTime = FPlatformTime::Seconds();
+
+			for(int32 ValidatorIndex = 0; ValidatorIndex < Validators.Num(); ++ValidatorIndex)
+			{
+				UBlueprintValidatorBase* Validator = Validators[ValidatorIndex];
+
+				FDataValidationContext Context(false, EDataValidationUsecase::Commandlet, {});
+
+				const int32 JobIndex = SnapshotJobIndices[(PendingIndex - Begin) * Validators.Num() + ValidatorIndex];
+				const FSnapshotJob* Job = JobIndex != INDEX_NONE ? &SnapshotJobs[JobIndex] : nullptr;
+
+				const TOptional<FIoHash>* CacheKey = &CacheKeys[AssetIndex * NumValidators + ValidatorIndex];
+
+				const double ValidatorStartTime = FPlatformTime::Seconds();
+				const EDataValidationResult Result = Job
+					? Validator->ValidateAssetWithFindings(AssetData, Asset, *Job->Snapshot, Job->Findings, Context, CacheKey)
+					: Validator->ValidateAsset(AssetData, Asset, Context, CacheKey);
+
+				if(Result == EDataValidationResult::NotValidated) continue;
+
+				FValidatorResult& ValidatorResult = AssetResult.Validators.AddDefaulted_GetRef();
+				ValidatorResult.ValidatorIndex = ValidatorIndex;
+				ValidatorResult.Result = Result;
+				ValidatorResult.Seconds = FPlatformTime::Seconds() - ValidatorStartTime + (Job ? Job->Seconds : 0.0);
+
+				for(const FDataValidationContext::FIssue& Issue : Context.GetIssues())
+				{
+					FMessageResult& Message = ValidatorResult.Messages.AddDefaulted_GetRef();
+					Message.Severity = Issue.Severity;
+					Message.Text = Issue.TokenizedMessage.IsValid() ? Issue.TokenizedMessage->ToText().ToString() : Issue.Message.ToString();
+				}
+
+				FValidatorStats& ValidatorStats = Stats[ValidatorIndex];
+				++ValidatorStats.Calls;
+				ValidatorStats.TotalSeconds += ValidatorResult.Seconds;
+				ValidatorStats.MaxSeconds = FMath::Max(ValidatorStats.MaxSeconds, ValidatorResult.Seconds);
+
+				ValidatorStats.Failures += ValidatorResult.Result == EDataValidationResult::Invalid ? 1 : 0;
+
+				MergeResult(AssetResult, ValidatorResult.Result);
+			}
+
+			AssetResult.Seconds = FPlatformTime::Seconds() - AssetStartTime;
+		}
+
+		// Release the validated batch and everything the validators pulled in with it
+		CurrentBatchObjects.Reset();
+		FBlueprintGraphIndexCache::Get().Reset();
+		FClassDefaultTextCache::Get().Reset();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		UE_LOG(ValidatorXCommandletLog, Display, TEXT("Batch %d/%d done, %d/%d assets validated"), BatchIndex + 1, NumBatches, End, PendingAssetIndices.Num());
+	}
+
+	for(UBlueprintValidatorBase* Validator : Validators)
+	{
+		Validator->RemoveFromRoot();
+	}
+
+	ResultCache.Save();
+
+	const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+	int32 NumInvalid = 0;
+	int32 NumLoadFailed = 0;
+	for(const FAssetResult& AssetResult : Results)
+	{
+		NumInvalid += AssetResult.Result == EDataValidationResult::Invalid ? 1 : 0;
+		NumLoadFailed += AssetResult.bLoadFailed ? 1 : 0;
+	}
+
+	for(int32 ValidatorIndex = 0; ValidatorIndex < Validators.Num(); ++ValidatorIndex)
+	{
+		const FValidatorStats& ValidatorStats = Stats[ValidatorIndex];
+		UE_LOG(ValidatorXCommandletLog, Display, TEXT("  %-40s calls %6d  cached %6d  failures %6d  total %9.2f ms  max %8.2f ms"),
+			*ValidatorNames[ValidatorIndex], ValidatorStats.Calls, ValidatorStats.CacheHits, ValidatorStats.Failures, ValidatorStats.TotalSeconds * 1000.0, ValidatorStats.MaxSeconds * 1000.0);
+	}
+
+	UE_LOG(ValidatorXCommandletLog, Display, TEXT("Validated %d Blueprints in %.2f s (%.2f s waiting on loads): %d invalid, %d failed to load"),
+		Results.Num(), TotalSeconds, LoadWaitSeconds, NumInvalid, NumLoadFailed);
+
+	if(JsonFileName && !WriteJson(*JsonFileName, Paths, ValidatorNames, Stats, Results, TotalSeconds))
+	{
+		UE_LOG(ValidatorXCommandletLog, Error, TEXT("Failed to write %s"), **JsonFileName);
+	}
+
+	if(JUnitFileName && !WriteJUnit(*JUnitFileName, ValidatorNames, Stats, Results, TotalSeconds))
+	{
+		UE_LOG(ValidatorXCommandletLog, Error, TEXT("Failed to write %s"), **JUnitFileName);
+	}
+
+	return (NumInvalid > 0 || NumLoadFailed > 0) && !bNoFail ? 1 : 0;
+}
+
+TArray<UBlueprintValidatorBase*> UValidatorXCommandlet::CreateValidators(const TArray<FString>& ValidatorNames)
+{
+	TArray<UBlueprintValidatorBase*> Validators;
+
+	for(TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		if(!Class->IsChildOf<UBlueprintValidatorBase>() || !Class->HasAnyClassFlags(CLASS_Native) || Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated))
+		{
+			continue;
+		}
+
+		if(ValidatorNames.Num() > 0 && !ValidatorNames.Contains(Class->GetName()))
+		{
+			continue;
+		}
+
+		UBlueprintValidatorBase* Validator = NewObject<UBlueprintValidatorBase>(GetTransientPackage(), Class);
+		Validator->AddToRoot();
+		Validators.Add(Validator);
+	}
+
+	Validators.Sort([] (const UBlueprintValidatorBase& A, const UBlueprintValidatorBase& B) { return A.GetClass()->GetName() < B.GetClass()->GetName(); });
+
+	return Validators;
+}
@@ -10,43 +10,55 @@
 #include "K2Node_MacroInstance.h"
 #include "EdGraphNode_Comment.h"
 #include "K2Node_IfThenElse.h"
-#include "AssetRegistry/AssetRegistryModule.h"
+#include "Library/BlueprintClassHierarchy.h"
+#include "Library/BlueprintGraphIndex.h"
 
 DEFINE_LOG_CATEGORY_STATIC(NodeFunctionLibraryLog, All, All);
 
-void UBPUtilsNodeFunctionLibrary::GetDerivedRegistryBlueprintClasses(const UClass* ParentClass, TArray<UClass*>& OutDerived)
+void UBPUtilsNodeFunctionLibrary::GetDerivedRegistryBlueprintClassPaths(const UClass* ParentClass, TArray<FSoftClassPath>& OutDerived)
 {
 	if(!ParentClass)
 	{
-		UE_LOG(NodeFunctionLibraryLog, Warning, TEXT("[GetDerivedBlueprintClasses] ParentClass is nullptr."));
+		UE_LOG(NodeFunctionLibraryLog, Warning, TEXT("[GetDerivedRegistryBlueprintClassPaths] ParentClass is nullptr."));
 		return;
 	}
 
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	TArray<FTopLevelAssetPath> DerivedClassPaths;
+	FBlueprintClassHierarchy::Get().GetDerivedClassPaths(ParentClass->GetClassPathName(), DerivedClassPaths);
 
-	TArray<FAssetData> BlueprintAssets;
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-	Filter.bRecursiveClasses = true;
+	OutDerived.Reserve(OutDerived.Num() + DerivedClassPaths.Num());
+	for(const FTopLevelAssetPath& DerivedClassPath : DerivedClassPaths)
+	{
+		OutDerived.Emplace(DerivedClassPath.ToString());
+	}
+
+	UE_LOG(NodeFunctionLibraryLog, Verbose, TEXT("Found %d derived blueprint classes (via AssetRegistry) of %s"), DerivedClassPaths.Num(), *ParentClass->GetName());
+}
 
-	AssetRegistryModule.Get().GetAssets(Filter, BlueprintAssets);
+void UBPUtilsNodeFunctionLibrary::GetDerivedRegistryBlueprintClasses(const UClass* ParentClass, TArray<UClass*>& OutDerived, bool bLoadClasses)
+{
+	if(!ParentClass)
+	{
+		UE_LOG(NodeFunctionLibraryLog, Warning, TEXT("[GetDerivedRegistryBlueprintClasses] ParentClass is nullptr."));
+		return;
+	}
+
+	TArray<FSoftClassPath> DerivedClassPaths;
+	GetDerivedRegistryBlueprintClassPaths(ParentClass, DerivedClassPaths);
 
 	int32 FoundCount = 0;
 
-	for(const FAssetData& Asset : BlueprintAssets)
+	for(const FSoftClassPath& DerivedClassPath : DerivedClassPaths)
 	{
-		UBlueprint* LoadedBP = Cast<UBlueprint>(Asset.GetAsset());
-		if(!LoadedBP || !LoadedBP->GeneratedClass) continue;
-
-		if(LoadedBP->GeneratedClass->IsChildOf(ParentClass) && LoadedBP->GeneratedClass != ParentClass)
+		UClass* DerivedClass = bLoadClasses ? DerivedClassPath.TryLoadClass<UObject>() : DerivedClassPath.ResolveClass();
+		if(DerivedClass && DerivedClass != ParentClass)
 		{
-			OutDerived.Add(LoadedBP->GeneratedClass);
-			UE_LOG(NodeFunctionLibraryLog, Display, TEXT("[DerivedBP] %s"), *LoadedBP->GetName());
+			OutDerived.Add(DerivedClass);
 			++FoundCount;
 		}
 	}
 
-	UE_LOG(NodeFunctionLibraryLog, Display, TEXT("Found %d derived blueprint classes (via AssetRegistry) of %s"), FoundCount, *ParentClass->GetName());
+	UE_LOG(NodeFunctionLibraryLog, Display, TEXT("Resolved %d of %d derived blueprint classes (via AssetRegistry) of %s"), FoundCount, DerivedClassPaths.Num(), *ParentClass->GetName());
 }
 
 void UBPUtilsNodeFunctionLibrary::GetAllDerivedBlueprintClasses(const UClass* ParentClass, TArray<UClass*>& OutDerived, bool bSearchAssetRegistry)
@@ -57,7 +69,7 @@ void UBPUtilsNodeFunctionLibrary::GetAllDerivedBlueprintClasses(const UClass* Pa
 	// 2. If none found, fallback to AssetRegistry
 	if(OutDerived.Num() == 0 && bSearchAssetRegistry)
 	{
-		UBPUtilsNodeFunctionLibrary::GetDerivedRegistryBlueprintClasses(ParentClass, OutDerived);
+		UBPUtilsNodeFunctionLibrary::GetDerivedRegistryBlueprintClasses(ParentClass, OutDerived, true);
 	}
 }
 
@@ -259,89 +271,111 @@ bool UBPUtilsNodeFunctionLibrary::HasExecutionOutputConnections(const UEdGraphNo
 	return false;
 }
 
-FString UBPUtilsNodeFunctionLibrary::GetGraphType(UBlueprint* Blueprint, UEdGraph* Graph)
+bool UBPUtilsNodeFunctionLibrary::IsPureNode(const UEdGraphNode* Node)
 {
-	if(Blueprint->FunctionGraphs.Contains(Graph)) return TEXT("Function");
-	if(Blueprint->MacroGraphs.Contains(Graph)) return TEXT("Macro");
-	if(Blueprint->UbergraphPages.Contains(Graph)) return TEXT("Event Graph");
-	if(Blueprint->DelegateSignatureGraphs.Contains(Graph)) return TEXT("Delegate");
-	if(Blueprint->IntermediateGeneratedGraphs.Contains(Graph)) return TEXT("Intermediate");
-
-	return TEXT("Unknown");
+	const UK2Node* K2Node = Cast<UK2Node>(Node);
+	return K2Node && K2Node->IsNodePure();
 }
 
-bool UBPUtilsNodeFunctionLibrary::IsBoolVariableSetInThisOrParentBPs(UBlueprint* Blueprint, FName VarName, FString* OutSourceInfo)
+void UBPUtilsNodeFunctionLibrary::GetPureExecConsumers(const UEdGraphNode* PureNode, TArray<UEdGraphNode*>& OutConsumers)
 {
-	if(!Blueprint)
-	{
-		UE_LOG(NodeFunctionLibraryLog, Warning, TEXT("[IsBoolVariableSet] Blueprint is nullptr."));
-		return false;
-	}
+	if(!PureNode) return;
 
-	UBlueprint* CurrentBP = Blueprint;
-	while(CurrentBP)
-	{
-		UE_LOG(NodeFunctionLibraryLog, Display, TEXT("[IsBoolVariableSet] Checking Blueprint: %s"), *CurrentBP->GetName());
+	TArray<const UEdGraphNode*> Stack = { PureNode };
+	TSet<const UEdGraphNode*> Visited = { PureNode };
 
-		TArray<UEdGraph*> Graphs;
-		CurrentBP->GetAllGraphs(Graphs);
+	while(Stack.Num() > 0)
+	{
+		const UEdGraphNode* Node = Stack.Pop(EAllowShrinking::No);
 
-		for(UEdGraph* Graph : Graphs)
+		for(const UEdGraphPin* Pin : Node->Pins)
 		{
-			if(!Graph) continue;
+			if(!Pin || Pin->Direction != EGPD_Output || Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec) continue;
 
-			UE_LOG(NodeFunctionLibraryLog, VeryVerbose, TEXT("  [Graph] %s"), *Graph->GetName());
-
-			for(UEdGraphNode* Node : Graph->Nodes)
+			for(const UEdGraphPin* LinkedPin : Pin->LinkedTo)
 			{
-				if(UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(Node))
-				{
-					const FName SetVarName = SetNode->GetVarName();
-					UE_LOG(NodeFunctionLibraryLog, Verbose, TEXT("[SetNode] Variable: %s"), *SetVarName.ToString());
+				UEdGraphNode* LinkedNode = LinkedPin ? LinkedPin->GetOwningNode() : nullptr;
+				if(!LinkedNode) continue;
 
-					if(SetVarName == VarName)
-					{
-						UE_LOG(NodeFunctionLibraryLog, Display, TEXT("Found SET for '%s' in BP '%s', Graph '%s'"),
-							*VarName.ToString(),
-							*CurrentBP->GetName(),
-							*Graph->GetName());
-
-						if(OutSourceInfo)
-						{
-							*OutSourceInfo = FString::Printf(TEXT("Set found in Blueprint: %s, Graph: %s"),
-								*CurrentBP->GetName(),
-								*Graph->GetName());
-						}
-						return true;
-					}
+				bool bAlreadyVisited = false;
+				Visited.Add(LinkedNode, &bAlreadyVisited);
+				if(bAlreadyVisited) continue;
+
+				if(IsPureNode(LinkedNode))
+				{
+					Stack.Add(LinkedNode);
+				}
+				else
+				{
+					OutConsumers.Add(LinkedNode);
 				}
 			}
 		}
+	}
+}
 
-		UClass* ParentClass = CurrentBP->ParentClass;
-		if(!ParentClass)
-		{
-			UE_LOG(NodeFunctionLibraryLog, Display, TEXT("[IsBoolVariableSet] Reached top base class from %s"), *CurrentBP->GetName());
-			break;
-		}
+void UBPUtilsNodeFunctionLibrary::GetPureInputNodes(const UEdGraphNode* Node, TArray<UEdGraphNode*>& OutPureNodes)
+{
+	if(!Node) return;
 
-		CurrentBP = UBlueprint::GetBlueprintFromClass(ParentClass);
-		if(!CurrentBP)
+	TArray<const UEdGraphNode*> Stack = { Node };
+	TSet<const UEdGraphNode*> Visited = { Node };
+
+	while(Stack.Num() > 0)
+	{
+		const UEdGraphNode* Current = Stack.Pop(EAllowShrinking::No);
+
+		for(const UEdGraphPin* Pin : Current->Pins)
 		{
-			UE_LOG(NodeFunctionLibraryLog, Display, TEXT("[IsBoolVariableSet] No Blueprint found for ParentClass: %s"), *ParentClass->GetName());
+			if(!Pin || Pin->Direction != EGPD_Input || Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec) continue;
+
+			for(const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				UEdGraphNode* LinkedNode = LinkedPin ? LinkedPin->GetOwningNode() : nullptr;
+				if(!LinkedNode || !IsPureNode(LinkedNode)) continue;
+
+				bool bAlreadyVisited = false;
+				Visited.Add(LinkedNode, &bAlreadyVisited);
+				if(!bAlreadyVisited)
+				{
+					OutPureNodes.Add(LinkedNode);
+					Stack.Add(LinkedNode);
+				}
+			}
 		}
 	}
+}
 
-	if(OutSourceInfo)
+FString UBPUtilsNodeFunctionLibrary::GetGraphType(UBlueprint* Blueprint, UEdGraph* Graph)
+{
+	if(Blueprint->FunctionGraphs.Contains(Graph)) return TEXT("Function");
+	if(Blueprint->MacroGraphs.Contains(Graph)) return TEXT("Macro");
+	if(Blueprint->UbergraphPages.Contains(Graph)) return TEXT("Event Graph");
+	if(Blueprint->DelegateSignatureGraphs.Contains(Graph)) return TEXT("Delegate");
+	if(Blueprint->IntermediateGeneratedGraphs.Contains(Graph)) return TEXT("Intermediate");
+
+	return TEXT("Unknown");
+}
+
+bool UBPUtilsNodeFunctionLibrary::IsBoolVariableSetInThisOrParentBPs(UBlueprint* Blueprint, FName VarName, FString* OutSourceInfo)
+{
+	if(!Blueprint)
 	{
-		*OutSourceInfo = TEXT("No Set found in this Blueprint or any parent.");
+		UE_LOG(NodeFunctionLibraryLog, Warning, TEXT("[IsBoolVariableSet] Blueprint is nullptr."));
+		return false;
 	}
 
-	UE_LOG(NodeFunctionLibraryLog, Display, TEXT("No SET found for variable '%s' in %s or parents."),
-		*VarName.ToString(),
-		*Blueprint->GetName());
+	const TSharedRef<const TMap<FName, FBlueprintVariableSetSource>> VariableSets = FBlueprintGraphIndexCache::Get().FindOrBuildHierarchyVariableSets(Blueprint);
+	const FBlueprintVariableSetSource* Source = VariableSets->Find(VarName);
 
-	return false;
+	if(OutSourceInfo)
+	{
+		*OutSourceInfo = Source
+			? FString::Printf(TEXT("Set found in Blueprint: %s, Graph: %s"), *GetNameSafe(Source->Blueprint), *GetNameSafe(Source->SetNode.Graph))
+			: TEXT("No Set found in this Blueprint or any parent.");
+	}
+
+	return Source != nullptr;
 }
 
 bool UBPUtilsNodeFunctionLibrary::AreAllBranchExecsDisconnected(const UK2Node_IfThenElse* Branch)
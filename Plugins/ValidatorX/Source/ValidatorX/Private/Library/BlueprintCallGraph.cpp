@@ -0,0 +1,651 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Library/BlueprintCallGraph.h"
+#include "Library/BlueprintGraphIndex.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_MacroInstance.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Editor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(BlueprintCallGraphLog, All, All);
+
+namespace BlueprintCallGraph
+{
+	/** Number of package loads in flight, or loaded between two flushes in commandlets, while reading the Blueprints of dependency cycles. */
+	constexpr int32 LoadBatchSize = 64;
+
+	/**
+	 * Iterative Tarjan pass, so deep call chains cannot overflow the stack.
+	 *
+	 * @param Successors Outgoing edges of every vertex.
+	 * @param OutComponents Receives every strongly connected component, singletons included.
+	 */
+	void FindStronglyConnectedComponents(const TArray<TArray<int32>>& Successors, TArray<TArray<int32>>& OutComponents)
+	{
+		struct FFrame
+		{
+			int32 Vertex;
+			int32 NextSuccessor;
+		};
+
+		const int32 NumVertices = Successors.Num();
+
+		TArray<int32> Order;
+		Order.Init(INDEX_NONE, NumVertices);
+
+		TArray<int32> LowLink;
+		LowLink.Init(INDEX_NONE, NumVertices);
+
+		TBitArray<> IsOnStack(false, NumVertices);
+		TArray<int32> Stack;
+		TArray<FFrame> CallStack;
+		int32 NextOrder = 0;
+
+		for(int32 Root = 0; Root < NumVertices; ++Root)
+		{
+			if(Order[Root] != INDEX_NONE) continue;
+
+			Order[Root] = LowLink[Root] = NextOrder++;
+			Stack.Add(Root);
+			IsOnStack[Root] = true;
+			CallStack.Add({ Root, 0 });
+
+			while(CallStack.Num() > 0)
+			{
+				const int32 Vertex = CallStack.Last().Vertex;
+				const TArray<int32>& VertexSuccessors = Successors[Vertex];
+
+				if(CallStack.Last().NextSuccessor < VertexSuccessors.Num())
+				{
+					const int32 Successor = VertexSuccessors[CallStack.Last().NextSuccessor++];
+
+					if(Order[Successor] == INDEX_NONE)
+					{
+						Order[Successor] = LowLink[Successor] = NextOrder++;
+						Stack.Add(Successor);
+						IsOnStack[Successor] = true;
+						CallStack.Add({ Successor, 0 });
+					}
+					else if(IsOnStack[Successor])
+					{
+						LowLink[Vertex] = FMath::Min(LowLink[Vertex], Order[Successor]);
+					}
+					continue;
+				}
+
+				CallStack.Pop(EAllowShrinking::No);
+				if(CallStack.Num() > 0)
+				{
+					const int32 Parent = CallStack.Last().Vertex;
+					LowLink[Parent] = FMath::Min(LowLink[Parent], LowLink[Vertex]);
+				}
+
+				if(LowLink[Vertex] == Order[Vertex])
+				{
+					TArray<int32>& Component = OutComponents.AddDefaulted_GetRef();
+					int32 Member;
+					do
+					{
+						Member = Stack.Pop(EAllowShrinking::No);
+						IsOnStack[Member] = false;
+						Component.Add(Member);
+					}
+					while(Member != Vertex);
+				}
+			}
+		}
+	}
+
+	/** @return False if the node calls native code or a graph that cannot be resolved. */
+	bool ResolveCallee(const UEdGraphNode* Node, FBlueprintCallable& OutCallee)
+	{
+		if(const UK2Node_MacroInstance* MacroInstance = Cast<UK2Node_MacroInstance>(Node))
+		{
+			const UEdGraph* MacroGraph = MacroInstance->GetMacroGraph();
+			const UBlueprint* Owner = MacroGraph ? MacroGraph->GetTypedOuter<UBlueprint>() : nullptr;
+			if(!Owner) return false;
+
+			OutCallee = { FTopLevelAssetPath(Owner), MacroGraph->GetFName() };
+			return true;
+		}
+
+		if(const UK2Node_CallFunction* CallFunction = Cast<UK2Node_CallFunction>(Node))
+		{
+			// Blueprint functions live in the skeleton or generated class, both generated by the owning Blueprint
+			const UFunction* Function = CallFunction->GetTargetFunction();
+			const UClass* OwnerClass = Function ? Function->GetOwnerClass() : CallFunction->FunctionReference.GetMemberParentClass(CallFunction->GetBlueprintClassFromNode());
+			const UBlueprint* Owner = OwnerClass ? Cast<UBlueprint>(OwnerClass->ClassGeneratedBy) : nullptr;
+			if(!Owner) return false;
+
+			OutCallee = { FTopLevelAssetPath(Owner), CallFunction->FunctionReference.GetMemberName() };
+			return true;
+		}
+
+		return false;
+	}
+
+	/** @return True if the package is content of the project or one of its plugins, not of the engine. */
+	bool IsProjectPackage(FName PackageName, const FString& ProjectDir)
+	{
+		FString FileName;
+		return FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), FileName) &&
+			FPaths::IsUnderDirectory(FPaths::ConvertRelativePathToFull(FileName), ProjectDir);
+	}
+}
+
+void FBlueprintCallGraph::Initialize()
+{
+	if(ObjectModifiedHandle.IsValid()) return;
+
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FBlueprintCallGraph::OnObjectModified);
+	UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FBlueprintCallGraph::OnUndoRedo);
+
+	if(GEditor)
+	{
+		BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FBlueprintCallGraph::OnBlueprintPreCompile);
+	}
+
+	if(IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetAddedHandle = AssetRegistry->OnAssetAdded().AddRaw(this, &FBlueprintCallGraph::OnAssetChanged);
+		AssetUpdatedHandle = AssetRegistry->OnAssetUpdated().AddRaw(this, &FBlueprintCallGraph::OnAssetChanged);
+		AssetRemovedHandle = AssetRegistry->OnAssetRemoved().AddRaw(this, &FBlueprintCallGraph::OnAssetRemoved);
+		AssetRenamedHandle = AssetRegistry->OnAssetRenamed().AddRaw(this, &FBlueprintCallGraph::OnAssetRenamed);
+	}
+}
+
+void FBlueprintCallGraph::Shutdown()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+
+	if(GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+	}
+
+	if(IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+		AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+
+	ObjectModifiedHandle.Reset();
+	UndoRedoHandle.Reset();
+	BlueprintPreCompileHandle.Reset();
+	AssetAddedHandle.Reset();
+	AssetUpdatedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	AssetRenamedHandle.Reset();
+
+	CallsByBlueprint.Reset();
+	StaleBlueprints.Reset();
+	PackageCycleByPackage.Reset();
+	PackageCycles.Reset();
+	Clusters.Reset();
+	ClustersByBlueprint.Reset();
+
+	// Loads still in flight complete later and are ignored
+	QueuedLoads.Reset();
+	InFlightLoads.Reset();
+	NumLoadsRead = 0;
+
+	bArePackageCyclesDirty = true;
+	bAreCandidatesDirty = true;
+	bAreClustersDirty = true;
+}
+
+bool FBlueprintCallGraph::GetRecursiveClusters(UBlueprint* Blueprint, TArray<TSharedRef<const FBlueprintCallCluster>>& OutClusters)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBlueprintCallGraph::GetRecursiveClusters);
+	check(IsInGameThread());
+	check(Blueprint);
+
+	const FTopLevelAssetPath BlueprintPath(Blueprint);
+	if(!CallsByBlueprint.Contains(BlueprintPath))
+	{
+		StaleBlueprints.Add(BlueprintPath);
+	}
+
+	// Loaded Blueprints are read again now, unloaded ones are dropped and loaded again with the dependency cycles
+	for(const FTopLevelAssetPath& StalePath : StaleBlueprints.Array())
+	{
+		if(UBlueprint* StaleBlueprint = FindObject<UBlueprint>(StalePath))
+		{
+			UpdateBlueprint(StaleBlueprint);
+		}
+		else
+		{
+			CallsByBlueprint.Remove(StalePath);
+			bAreCandidatesDirty = true;
+			bAreClustersDirty = true;
+		}
+	}
+	StaleBlueprints.Reset();
+
+	EnsureCandidatesLoaded();
+	UpdateClusters();
+
+	if(const TArray<int32>* ClusterIndices = ClustersByBlueprint.Find(BlueprintPath))
+	{
+		for(const int32 ClusterIndex : *ClusterIndices)
+		{
+			OutClusters.Add(Clusters[ClusterIndex]);
+		}
+	}
+
+	return QueuedLoads.Num() == 0 && InFlightLoads.Num() == 0;
+}
+
+void FBlueprintCallGraph::GetDependencyCyclePackages(FName PackageName, TArray<FName>& OutPackageNames)
+{
+	check(IsInGameThread());
+	EnsurePackageCycles();
+
+	if(const int32* CycleIndex = PackageCycleByPackage.Find(PackageName))
+	{
+		for(const FName CyclePackageName : PackageCycles[*CycleIndex])
+		{
+			if(CyclePackageName != PackageName)
+			{
+				OutPackageNames.Add(CyclePackageName);
+			}
+		}
+	}
+}
+
+void FBlueprintCallGraph::EnsurePackageCycles()
+{
+	if(!bArePackageCyclesDirty) return;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBlueprintCallGraph::EnsurePackageCycles);
+	const double StartTime = FPlatformTime::Seconds();
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	// Cycles found while the registry is still scanning may be incomplete
+	bArePackageCyclesDirty = AssetRegistry.IsLoadingAssets();
+	bAreCandidatesDirty = true;
+
+	PackageCycleByPackage.Reset();
+	PackageCycles.Reset();
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+
+	TArray<FName> Packages;
+	TMap<FName, int32> IndexByPackage;
+
+	AssetRegistry.EnumerateAssets(Filter, [&] (const FAssetData& AssetData)
+		{
+			// Data-only Blueprints call nothing, so they can close no cycle and are never loaded for one
+			FString IsDataOnly;
+			if(AssetData.GetTagValue(FBlueprintTags::IsDataOnly, IsDataOnly) && IsDataOnly.ToBool()) return true;
+
+			if(!IndexByPackage.Contains(AssetData.PackageName) && BlueprintCallGraph::IsProjectPackage(AssetData.PackageName, ProjectDir))
+			{
+				IndexByPackage.Add(AssetData.PackageName, Packages.Add(AssetData.PackageName));
+			}
+			return true;
+		});
+
+	TArray<TArray<int32>> Successors;
+	Successors.SetNum(Packages.Num());
+
+	TArray<FName> Dependencies;
+	for(int32 PackageIndex = 0; PackageIndex < Packages.Num(); ++PackageIndex)
+	{
+		Dependencies.Reset();
+		AssetRegistry.GetDependencies(Packages[PackageIndex], Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+		for(const FName Dependency : Dependencies)
+		{
+			if(const int32* DependencyIndex = IndexByPackage.Find(Dependency))
+			{
+				Successors[PackageIndex].Add(*DependencyIndex);
+			}
+		}
+	}
+
+	TArray<TArray<int32>> Components;
+	BlueprintCallGraph::FindStronglyConnectedComponents(Successors, Components);
+
+	for(const TArray<int32>& Component : Components)
+	{
+		if(Component.Num() < 2) continue;
+
+		const int32 CycleIndex = PackageCycles.AddDefaulted();
+		for(const int32 PackageIndex : Component)
+		{
+			PackageCycles[CycleIndex].Add(Packages[PackageIndex]);
+			PackageCycleByPackage.Add(Packages[PackageIndex], CycleIndex);
+		}
+	}
+
+	UE_LOG(BlueprintCallGraphLog, Log, TEXT("Found %d dependency cycles spanning %d of %d Blueprint packages in %.2f ms"),
+		PackageCycles.Num(), PackageCycleByPackage.Num(), Packages.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FBlueprintCallGraph::EnsureCandidatesLoaded()
+{
+	EnsurePackageCycles();
+	if(!bAreCandidatesDirty) return;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBlueprintCallGraph::EnsureCandidatesLoaded);
+	const double StartTime = FPlatformTime::Seconds();
+
+	bAreCandidatesDirty = false;
+
+	TSet<FName> ReadPackages;
+	for(const TPair<FTopLevelAssetPath, FBlueprintCalls>& Pair : CallsByBlueprint)
+	{
+		ReadPackages.Add(Pair.Key.GetPackageName());
+	}
+
+	TArray<FName> PackagesToRead;
+	for(const TPair<FName, int32>& Pair : PackageCycleByPackage)
+	{
+		if(!ReadPackages.Contains(Pair.Key) && !InFlightLoads.Contains(Pair.Key))
+		{
+			PackagesToRead.Add(Pair.Key);
+		}
+	}
+
+	if(!IsRunningCommandlet())
+	{
+		// Blocking on hundreds of packages would freeze the editor, e.g. when validating after a compile
+		if(QueuedLoads.Num() == 0 && InFlightLoads.Num() == 0)
+		{
+			NumLoadsRead = 0;
+			LoadStartTime = StartTime;
+		}
+
+		QueuedLoads = MoveTemp(PackagesToRead);
+		RequestQueuedLoads();
+		return;
+	}
+
+	for(int32 BatchStart = 0; BatchStart < PackagesToRead.Num(); BatchStart += BlueprintCallGraph::LoadBatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BlueprintCallGraph::LoadBatchSize, PackagesToRead.Num());
+
+		TArray<int32> RequestIds;
+		for(int32 Index = BatchStart; Index < BatchEnd; ++Index)
+		{
+			RequestIds.Add(LoadPackageAsync(PackagesToRead[Index].ToString()));
+		}
+
+		for(const int32 RequestId : RequestIds)
+		{
+			FlushAsyncLoading(RequestId);
+		}
+
+		for(int32 Index = BatchStart; Index < BatchEnd; ++Index)
+		{
+			const UPackage* Package = FindObjectFast<UPackage>(nullptr, PackagesToRead[Index]);
+			if(UBlueprint* Blueprint = Package ? Cast<UBlueprint>(Package->FindAssetInPackage()) : nullptr)
+			{
+				UpdateBlueprint(Blueprint);
+			}
+			else
+			{
+				UE_LOG(BlueprintCallGraphLog, Warning, TEXT("Failed to load %s to read its calls"), *PackagesToRead[Index].ToString());
+			}
+		}
+	}
+
+	if(PackagesToRead.Num() > 0)
+	{
+		UE_LOG(BlueprintCallGraphLog, Log, TEXT("Read the calls of %d Blueprints in dependency cycles in %.2f ms"),
+			PackagesToRead.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}
+}
+
+void FBlueprintCallGraph::RequestQueuedLoads()
+{
+	while(QueuedLoads.Num() > 0 && InFlightLoads.Num() < BlueprintCallGraph::LoadBatchSize)
+	{
+		const FName PackageName = QueuedLoads.Pop(EAllowShrinking::No);
+
+		// Packages already in memory are read right away, they cost no I/O
+		const UPackage* Package = FindObjectFast<UPackage>(nullptr, PackageName);
+		if(UBlueprint* Blueprint = Package ? Cast<UBlueprint>(Package->FindAssetInPackage()) : nullptr)
+		{
+			UpdateBlueprint(Blueprint);
+			++NumLoadsRead;
+			continue;
+		}
+
+		InFlightLoads.Add(PackageName);
+		LoadPackageAsync(PackageName.ToString(), FLoadPackageAsyncDelegate::CreateRaw(this, &FBlueprintCallGraph::OnCandidateLoaded));
+	}
+}
+
+void FBlueprintCallGraph::OnCandidateLoaded(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result)
+{
+	// Requests dropped by Shutdown or already answered
+	if(InFlightLoads.Remove(PackageName) == 0) return;
+
+	UBlueprint* Blueprint = Package && Result == EAsyncLoadingResult::Succeeded ? Cast<UBlueprint>(Package->FindAssetInPackage()) : nullptr;
+	if(Blueprint)
+	{
+		UpdateBlueprint(Blueprint);
+		++NumLoadsRead;
+	}
+	else
+	{
+		UE_LOG(BlueprintCallGraphLog, Warning, TEXT("Failed to load %s to read its calls"), *PackageName.ToString());
+	}
+
+	RequestQueuedLoads();
+
+	if(QueuedLoads.Num() == 0 && InFlightLoads.Num() == 0)
+	{
+		UE_LOG(BlueprintCallGraphLog, Log, TEXT("Read the calls of %d Blueprints in dependency cycles in %.2f ms"),
+			NumLoadsRead, (FPlatformTime::Seconds() - LoadStartTime) * 1000.0);
+	}
+}
+
+void FBlueprintCallGraph::UpdateBlueprint(UBlueprint* Blueprint)
+{
+	const FTopLevelAssetPath BlueprintPath(Blueprint);
+	CallsByBlueprint.Add(BlueprintPath, ReadCalls(Blueprint));
+	StaleBlueprints.Remove(BlueprintPath);
+	bAreClustersDirty = true;
+}
+
+void FBlueprintCallGraph::UpdateClusters()
+{
+	if(!bAreClustersDirty) return;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBlueprintCallGraph::UpdateClusters);
+	const double StartTime = FPlatformTime::Seconds();
+
+	bAreClustersDirty = false;
+	Clusters.Reset();
+	ClustersByBlueprint.Reset();
+
+	TArray<FBlueprintCallable> Callables;
+	TMap<FBlueprintCallable, int32> IndexByCallable;
+
+	for(const TPair<FTopLevelAssetPath, FBlueprintCalls>& Pair : CallsByBlueprint)
+	{
+		for(const FName Graph : Pair.Value.Graphs)
+		{
+			const FBlueprintCallable Callable{ Pair.Key, Graph };
+			IndexByCallable.Add(Callable, Callables.Add(Callable));
+		}
+	}
+
+	TArray<TArray<int32>> Successors;
+	Successors.SetNum(Callables.Num());
+	TBitArray<> CallsItself(false, Callables.Num());
+
+	int32 NumEdges = 0;
+	for(const TPair<FTopLevelAssetPath, FBlueprintCalls>& Pair : CallsByBlueprint)
+	{
+		for(const TPair<FName, FBlueprintCallable>& Call : Pair.Value.Calls)
+		{
+			// Calls to graphs that were never read cannot be part of a cycle with this one
+			const int32* CallerIndex = IndexByCallable.Find(FBlueprintCallable{ Pair.Key, Call.Key });
+			const int32* CalleeIndex = IndexByCallable.Find(Call.Value);
+			if(!CallerIndex || !CalleeIndex) continue;
+
+			Successors[*CallerIndex].Add(*CalleeIndex);
+			CallsItself[*CallerIndex] = CallsItself[*CallerIndex] || *CallerIndex == *CalleeIndex;
+			++NumEdges;
+		}
+	}
+
+	TArray<TArray<int32>> Components;
+	BlueprintCallGraph::FindStronglyConnectedComponents(Successors, Components);
+
+	for(const TArray<int32>& Component : Components)
+	{
+		if(Component.Num() == 1 && !CallsItself[Component[0]]) continue;
+
+		const TSharedRef<FBlueprintCallCluster> Cluster = MakeShared<FBlueprintCallCluster>();
+		for(const int32 CallableIndex : Component)
+		{
+			Cluster->Members.Add(Callables[CallableIndex]);
+		}
+		Cluster->Members.Sort([] (const FBlueprintCallable& A, const FBlueprintCallable& B) { return A.ToString() < B.ToString(); });
+
+		const int32 ClusterIndex = Clusters.Add(Cluster);
+		for(const FBlueprintCallable& Member : Cluster->Members)
+		{
+			ClustersByBlueprint.FindOrAdd(Member.Blueprint).AddUnique(ClusterIndex);
+		}
+	}
+
+	UE_LOG(BlueprintCallGraphLog, Verbose, TEXT("Found %d recursive clusters among %d functions and macros with %d calls in %.2f ms"),
+		Clusters.Num(), Callables.Num(), NumEdges, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+FBlueprintCallGraph::FBlueprintCalls FBlueprintCallGraph::ReadCalls(UBlueprint* Blueprint)
+{
+	FBlueprintCalls Calls;
+
+	TSet<const UEdGraph*> CallableGraphs;
+	for(const TArray<TObjectPtr<UEdGraph>>* Graphs : { &Blueprint->FunctionGraphs, &Blueprint->MacroGraphs })
+	{
+		for(const UEdGraph* Graph : *Graphs)
+		{
+			if(Graph)
+			{
+				CallableGraphs.Add(Graph);
+				Calls.Graphs.Add(Graph->GetFName());
+			}
+		}
+	}
+
+	const TSharedRef<const FBlueprintGraphIndex> GraphIndex = FBlueprintGraphIndexCache::Get().FindOrBuild(Blueprint);
+
+	for(const TPair<const UEdGraph*, TArray<UEdGraphNode*>>& Pair : GraphIndex->CallNodesByGraph)
+	{
+		// Calls made inside collapsed graphs belong to the function or macro that contains them
+		const UEdGraph* CallerGraph = Pair.Key;
+		while(const UEdGraph* OuterGraph = CallerGraph->GetTypedOuter<UEdGraph>())
+		{
+			CallerGraph = OuterGraph;
+		}
+
+		if(!CallableGraphs.Contains(CallerGraph)) continue;
+
+		for(const UEdGraphNode* Node : Pair.Value)
+		{
+			FBlueprintCallable Callee;
+			if(BlueprintCallGraph::ResolveCallee(Node, Callee))
+			{
+				Calls.Calls.Emplace(CallerGraph->GetFName(), Callee);
+			}
+		}
+	}
+
+	return Calls;
+}
+
+void FBlueprintCallGraph::OnObjectModified(UObject* Object)
+{
+	if(CallsByBlueprint.Num() == 0 || !Object) return;
+
+	const UBlueprint* Blueprint = Object->IsA<UBlueprint>() ? CastChecked<UBlueprint>(Object) : Object->GetTypedOuter<UBlueprint>();
+	if(Blueprint)
+	{
+		const FTopLevelAssetPath BlueprintPath(Blueprint);
+		if(CallsByBlueprint.Contains(BlueprintPath))
+		{
+			StaleBlueprints.Add(BlueprintPath);
+		}
+	}
+}
+
+void FBlueprintCallGraph::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	if(Blueprint)
+	{
+		StaleBlueprints.Add(FTopLevelAssetPath(Blueprint));
+	}
+}
+
+void FBlueprintCallGraph::OnUndoRedo()
+{
+	for(const TPair<FTopLevelAssetPath, FBlueprintCalls>& Pair : CallsByBlueprint)
+	{
+		if(FindObject<UBlueprint>(Pair.Key))
+		{
+			StaleBlueprints.Add(Pair.Key);
+		}
+	}
+}
+
+void FBlueprintCallGraph::OnAssetChanged(const FAssetData& AssetData)
+{
+	if(!AssetData.IsInstanceOf(UBlueprint::StaticClass())) return;
+
+	// A saved Blueprint may have new package dependencies, and its calls on disk changed
+	bArePackageCyclesDirty = true;
+
+	const FTopLevelAssetPath BlueprintPath = AssetData.GetSoftObjectPath().GetAssetPath();
+	if(CallsByBlueprint.Contains(BlueprintPath))
+	{
+		StaleBlueprints.Add(BlueprintPath);
+	}
+}
+
+void FBlueprintCallGraph::OnAssetRemoved(const FAssetData& AssetData)
+{
+	if(!AssetData.IsInstanceOf(UBlueprint::StaticClass())) return;
+
+	bArePackageCyclesDirty = true;
+
+	const FTopLevelAssetPath BlueprintPath = AssetData.GetSoftObjectPath().GetAssetPath();
+	StaleBlueprints.Remove(BlueprintPath);
+	if(CallsByBlueprint.Remove(BlueprintPath) > 0)
+	{
+		bAreClustersDirty = true;
+	}
+}
+
+void FBlueprintCallGraph::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if(!AssetData.IsInstanceOf(UBlueprint::StaticClass())) return;
+
+	bArePackageCyclesDirty = true;
+
+	const FTopLevelAssetPath OldBlueprintPath = FSoftObjectPath(OldObjectPath).GetAssetPath();
+	StaleBlueprints.Remove(OldBlueprintPath);
+	if(CallsByBlueprint.Remove(OldBlueprintPath) > 0)
+	{
+		bAreClustersDirty = true;
+	}
+}
@@ -0,0 +1,224 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Library/BlueprintClassHierarchy.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Misc/PackageName.h"
+
+DEFINE_LOG_CATEGORY_STATIC(BlueprintClassHierarchyLog, All, All);
+
+void FBlueprintClassHierarchy::Initialize()
+{
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if(!AssetRegistry || AssetAddedHandle.IsValid()) return;
+
+	AssetAddedHandle = AssetRegistry->OnAssetAdded().AddRaw(this, &FBlueprintClassHierarchy::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry->OnAssetRemoved().AddRaw(this, &FBlueprintClassHierarchy::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry->OnAssetRenamed().AddRaw(this, &FBlueprintClassHierarchy::OnAssetRenamed);
+	AssetUpdatedHandle = AssetRegistry->OnAssetUpdated().AddRaw(this, &FBlueprintClassHierarchy::OnAssetAdded);
+	FilesLoadedHandle = AssetRegistry->OnFilesLoaded().AddRaw(this, &FBlueprintClassHierarchy::OnFilesLoaded);
+}
+
+void FBlueprintClassHierarchy::Shutdown()
+{
+	if(IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+		AssetRegistry->OnFilesLoaded().Remove(FilesLoadedHandle);
+	}
+
+	AssetAddedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	AssetRenamedHandle.Reset();
+	AssetUpdatedHandle.Reset();
+	FilesLoadedHandle.Reset();
+
+	ChildrenByParent.Reset();
+	ParentByClass.Reset();
+	ClassByAsset.Reset();
+	bIsBuilt = false;
+}
+
+void FBlueprintClassHierarchy::GetDerivedClassPaths(const FTopLevelAssetPath& ParentClassPath, TArray<FTopLevelAssetPath>& OutDerived)
+{
+	check(IsInGameThread());
+	EnsureBuilt();
+
+	// Breadth first, so every class comes after its parent. Stale tags of renamed assets could form a loop
+	TSet<FTopLevelAssetPath> Visited;
+	Visited.Add(ParentClassPath);
+
+	const int32 FirstDerived = OutDerived.Num();
+	OutDerived.Add(ParentClassPath);
+
+	for(int32 Index = FirstDerived; Index < OutDerived.Num(); ++Index)
+	{
+		if(const TArray<FTopLevelAssetPath>* Children = ChildrenByParent.Find(OutDerived[Index]))
+		{
+			for(const FTopLevelAssetPath& Child : *Children)
+			{
+				bool bIsAlreadyVisited = false;
+				Visited.Add(Child, &bIsAlreadyVisited);
+				if(!bIsAlreadyVisited)
+				{
+					OutDerived.Add(Child);
+				}
+			}
+		}
+	}
+
+	OutDerived.RemoveAt(FirstDerived, 1, EAllowShrinking::No);
+}
+
+void FBlueprintClassHierarchy::GetAncestorClassPaths(const FTopLevelAssetPath& ClassPath, TArray<FTopLevelAssetPath>& OutAncestors)
+{
+	check(IsInGameThread());
+	EnsureBuilt();
+
+	// Only Blueprint classes have an entry, so the walk ends at the native parent
+	TSet<FTopLevelAssetPath> Visited;
+	Visited.Add(ClassPath);
+
+	const FTopLevelAssetPath* ParentClassPath = ParentByClass.Find(ClassPath);
+	while(ParentClassPath && ParentByClass.Contains(*ParentClassPath))
+	{
+		bool bIsAlreadyVisited = false;
+		Visited.Add(*ParentClassPath, &bIsAlreadyVisited);
+		if(bIsAlreadyVisited) break;
+
+		OutAncestors.Add(*ParentClassPath);
+		ParentClassPath = ParentByClass.Find(*ParentClassPath);
+	}
+}
+
+void FBlueprintClassHierarchy::EnsureBuilt()
+{
+	if(bIsBuilt) return;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBlueprintClassHierarchy::Build);
+	const double StartTime = FPlatformTime::Seconds();
+
+	ChildrenByParent.Reset();
+	ParentByClass.Reset();
+	ClassByAsset.Reset();
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+
+	IAssetRegistry::GetChecked().EnumerateAssets(Filter, [this] (const FAssetData& AssetData)
+		{
+			AddAsset(AssetData);
+			return true;
+		});
+
+	bIsBuilt = true;
+
+	UE_LOG(BlueprintClassHierarchyLog, Log, TEXT("Indexed %d Blueprint classes under %d parents in %.2f ms"),
+		ParentByClass.Num(), ChildrenByParent.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FBlueprintClassHierarchy::AddAsset(const FAssetData& AssetData)
+{
+	const FTopLevelAssetPath ClassPath = GetGeneratedClassPath(AssetData);
+	const FTopLevelAssetPath ParentClassPath = GetParentClassPath(AssetData);
+	if(!ClassPath.IsValid() || !ParentClassPath.IsValid()) return;
+
+	if(const FTopLevelAssetPath* CurrentParent = ParentByClass.Find(ClassPath))
+	{
+		if(*CurrentParent == ParentClassPath) return;
+
+		// Reparented: detach from the previous parent first
+		RemoveClass(ClassPath);
+	}
+
+	ParentByClass.Add(ClassPath, ParentClassPath);
+	ChildrenByParent.FindOrAdd(ParentClassPath).Add(ClassPath);
+	ClassByAsset.Add(AssetData.GetSoftObjectPath(), ClassPath);
+}
+
+void FBlueprintClassHierarchy::RemoveClass(const FTopLevelAssetPath& ClassPath)
+{
+	FTopLevelAssetPath ParentClassPath;
+	if(!ParentByClass.RemoveAndCopyValue(ClassPath, ParentClassPath)) return;
+
+	if(TArray<FTopLevelAssetPath>* Siblings = ChildrenByParent.Find(ParentClassPath))
+	{
+		Siblings->RemoveSwap(ClassPath);
+		if(Siblings->Num() == 0)
+		{
+			ChildrenByParent.Remove(ParentClassPath);
+		}
+	}
+}
+
+void FBlueprintClassHierarchy::OnAssetAdded(const FAssetData& AssetData)
+{
+	if(bIsBuilt)
+	{
+		AddAsset(AssetData);
+	}
+}
+
+void FBlueprintClassHierarchy::OnAssetRemoved(const FAssetData& AssetData)
+{
+	if(!bIsBuilt) return;
+
+	FTopLevelAssetPath ClassPath;
+	if(ClassByAsset.RemoveAndCopyValue(AssetData.GetSoftObjectPath(), ClassPath))
+	{
+		RemoveClass(ClassPath);
+	}
+}
+
+void FBlueprintClassHierarchy::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if(!bIsBuilt) return;
+
+	FTopLevelAssetPath OldClassPath;
+	if(ClassByAsset.RemoveAndCopyValue(FSoftObjectPath(OldObjectPath), OldClassPath))
+	{
+		// Children keep pointing at the old class path until they are resaved with the new parent tag
+		RemoveClass(OldClassPath);
+	}
+
+	AddAsset(AssetData);
+}
+
+void FBlueprintClassHierarchy::OnFilesLoaded()
+{
+	// A map built while the registry was still scanning is incomplete
+	bIsBuilt = false;
+}
+
+FTopLevelAssetPath FBlueprintClassHierarchy::GetGeneratedClassPath(const FAssetData& AssetData)
+{
+	FString GeneratedClassPath;
+	if(AssetData.GetTagValue(FBlueprintTags::GeneratedClassPath, GeneratedClassPath))
+	{
+		return FTopLevelAssetPath(FPackageName::ExportTextPathToObjectPath(GeneratedClassPath));
+	}
+
+	if(!AssetData.TagsAndValues.Contains(FBlueprintTags::ParentClassPath))
+	{
+		return FTopLevelAssetPath();
+	}
+
+	return FTopLevelAssetPath(AssetData.PackageName, *(AssetData.AssetName.ToString() + TEXT("_C")));
+}
+
+FTopLevelAssetPath FBlueprintClassHierarchy::GetParentClassPath(const FAssetData& AssetData)
+{
+	FString ParentClassPath;
+	if(!AssetData.GetTagValue(FBlueprintTags::ParentClassPath, ParentClassPath) &&
+		!AssetData.GetTagValue(FBlueprintTags::NativeParentClassPath, ParentClassPath))
+	{
+		return FTopLevelAssetPath();
+	}
+
+	return FTopLevelAssetPath(FPackageName::ExportTextPathToObjectPath(ParentClassPath));
+}
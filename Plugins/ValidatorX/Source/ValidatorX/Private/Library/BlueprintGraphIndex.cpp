@@ -0,0 +1,389 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Library/BlueprintGraphIndex.h"
+#include "Engine/Blueprint.h"
+#include "EdGraphNode_Comment.h"
+#include "K2Node_BaseMCDelegate.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ClearDelegate.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_FunctionResult.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_Tunnel.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Editor.h"
+#include "Library/BPUtilsNodeFunctionLibrary.h"
+
+DEFINE_LOG_CATEGORY_STATIC(BlueprintGraphIndexLog, All, All);
+
+bool FBlueprintGraphIndex::IsFunctionCalled(FName FunctionName, const UEdGraph* IgnoredGraph) const
+{
+	if(const TArray<FBlueprintGraphNodeRef>* CallSites = CallSitesByFunction.Find(FunctionName))
+	{
+		for(const FBlueprintGraphNodeRef& CallSite : *CallSites)
+		{
+			if(CallSite.Graph != IgnoredGraph) return true;
+		}
+	}
+	return false;
+}
+
+bool FBlueprintGraphIndex::IsMacroInstanced(const UEdGraph* MacroGraph, const UEdGraph* IgnoredGraph) const
+{
+	if(const TArray<FBlueprintGraphNodeRef>* Instances = MacroInstancesByGraph.Find(MacroGraph))
+	{
+		for(const FBlueprintGraphNodeRef& Instance : *Instances)
+		{
+			if(Instance.Graph != IgnoredGraph) return true;
+		}
+	}
+	return false;
+}
+
+bool FBlueprintGraphIndex::IsVariableUsed(FName VarName) const
+{
+	return VariableGets.Contains(VarName) || VariableSets.Contains(VarName);
+}
+
+bool FBlueprintGraphIndex::IsVariableUsedInGraph(FName VarName, const UEdGraph* Graph) const
+{
+	const auto ContainsGraph = [Graph] (const TArray<FBlueprintGraphNodeRef>* NodeRefs)
+		{
+			return NodeRefs && NodeRefs->ContainsByPredicate([Graph] (const FBlueprintGraphNodeRef& NodeRef) { return NodeRef.Graph == Graph; });
+		};
+
+	return ContainsGraph(VariableGets.Find(VarName)) || ContainsGraph(VariableSets.Find(VarName));
+}
+
+const TArray<UEdGraphNode_Comment*>& FBlueprintGraphIndex::GetComments(const UEdGraph* Graph) const
+{
+	static const TArray<UEdGraphNode_Comment*> NoComments;
+
+	const TArray<UEdGraphNode_Comment*>* Comments = CommentsByGraph.Find(Graph);
+	return Comments ? *Comments : NoComments;
+}
+
+bool FBlueprintGraphIndex::IsNodeInsideComment(const UEdGraph* Graph, const UEdGraphNode* Node) const
+{
+	const FGraphBoundsIndex* CommentBounds = CommentBoundsByGraph.Find(Graph);
+	return CommentBounds && Node && CommentBounds->ContainsPoint(FVector2D(Node->NodePosX, Node->NodePosY));
+}
+
+int32 FBlueprintGraphIndex::GetCodeNodeCount(const UEdGraph* Graph) const
+{
+	return CodeNodeCounts.FindRef(Graph);
+}
+
+TSharedRef<const FBlueprintGraphIndex> FBlueprintGraphIndex::Build(UBlueprint* Blueprint)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBlueprintGraphIndex::Build);
+	check(Blueprint);
+
+	TSharedRef<FBlueprintGraphIndex> Index = MakeShared<FBlueprintGraphIndex>();
+	Blueprint->GetAllGraphs(Index->Graphs);
+	Index->Graphs.Remove(nullptr);
+
+	for(UEdGraph* Graph : Index->Graphs)
+	{
+		TArray<UEdGraphNode*>& CallNodes = Index->CallNodesByGraph.Add(Graph);
+		int32& CodeNodeCount = Index->CodeNodeCounts.Add(Graph, 0);
+
+		for(UEdGraphNode* Node : Graph->Nodes)
+		{
+			if(!Node) continue;
+
+			++Index->NumNodes;
+			const FBlueprintGraphNodeRef NodeRef{ Graph, Node };
+
+			if(UK2Node_FunctionEntry* Entry = Cast<UK2Node_FunctionEntry>(Node))
+			{
+				Index->FunctionEntries.FindOrAdd(Graph, Entry);
+				continue;
+			}
+
+			// Plain tunnels are the entry/exit of macros and collapsed graphs; macro instances and composites derive from them
+			if(Node->IsA<UK2Node_FunctionResult>() || Node->GetClass() == UK2Node_Tunnel::StaticClass()) continue;
+
+			++CodeNodeCount;
+
+			if(UK2Node_CallFunction* CallFunction = Cast<UK2Node_CallFunction>(Node))
+			{
+				const FName FunctionName = CallFunction->FunctionReference.GetMemberName();
+				Index->CallSitesByFunction.FindOrAdd(FunctionName).Add(NodeRef);
+				CallNodes.Add(Node);
+			}
+			else if(UK2Node_MacroInstance* MacroInstance = Cast<UK2Node_MacroInstance>(Node))
+			{
+				if(const UEdGraph* MacroGraph = MacroInstance->GetMacroGraph())
+				{
+					Index->MacroInstancesByGraph.FindOrAdd(MacroGraph).Add(NodeRef);
+					CallNodes.Add(Node);
+				}
+			}
+			else if(UK2Node_VariableGet* VariableGet = Cast<UK2Node_VariableGet>(Node))
+			{
+				Index->VariableGets.FindOrAdd(VariableGet->GetVarName()).Add(NodeRef);
+			}
+			else if(UK2Node_VariableSet* VariableSet = Cast<UK2Node_VariableSet>(Node))
+			{
+				Index->VariableSets.FindOrAdd(VariableSet->GetVarName()).Add(NodeRef);
+			}
+			else if(UK2Node_BaseMCDelegate* Delegate = Cast<UK2Node_BaseMCDelegate>(Node))
+			{
+				// Clearing a dispatcher neither binds nor calls it
+				if(!Node->IsA<UK2Node_ClearDelegate>())
+				{
+					Index->DelegateUsages.Add(Delegate->GetPropertyName());
+				}
+			}
+			else if(Node->IsA<UK2Node_IfThenElse>())
+			{
+				Index->Branches.Add(NodeRef);
+			}
+			else if(UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Node))
+			{
+				Index->CommentsByGraph.FindOrAdd(Graph).Add(Comment);
+			}
+		}
+	}
+
+	for(const TPair<const UEdGraph*, TArray<UEdGraphNode_Comment*>>& Pair : Index->CommentsByGraph)
+	{
+		TArray<FBox2D> CommentBounds;
+		CommentBounds.Reserve(Pair.Value.Num());
+
+		for(const UEdGraphNode_Comment* Comment : Pair.Value)
+		{
+			const FVector2D CommentPos(Comment->NodePosX, Comment->NodePosY);
+			CommentBounds.Emplace(CommentPos, CommentPos + FVector2D(Comment->NodeWidth, Comment->NodeHeight));
+		}
+
+		Index->CommentBoundsByGraph.Add(Pair.Key).Build(MoveTemp(CommentBounds));
+	}
+
+	UE_LOG(BlueprintGraphIndexLog, Verbose, TEXT("Indexed %d nodes in %d graphs of %s"), Index->NumNodes, Index->Graphs.Num(), *Blueprint->GetName());
+
+	return Index;
+}
+
+void FBlueprintGraphIndexCache::Initialize()
+{
+	if(!ObjectModifiedHandle.IsValid())
+	{
+		ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FBlueprintGraphIndexCache::OnObjectModified);
+	}
+
+	if(!UndoRedoHandle.IsValid())
+	{
+		UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FBlueprintGraphIndexCache::Reset);
+	}
+
+	if(GEditor && !BlueprintPreCompileHandle.IsValid())
+	{
+		BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FBlueprintGraphIndexCache::OnBlueprintPreCompile);
+	}
+}
+
+void FBlueprintGraphIndexCache::Shutdown()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+
+	if(GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+	}
+
+	ObjectModifiedHandle.Reset();
+	UndoRedoHandle.Reset();
+	BlueprintPreCompileHandle.Reset();
+
+	Reset();
+}
+
+TSharedRef<const FBlueprintGraphIndex> FBlueprintGraphIndexCache::FindOrBuild(UBlueprint* Blueprint)
+{
+	check(IsInGameThread());
+
+	if(const TSharedRef<const FBlueprintGraphIndex>* Index = Indices.Find(Blueprint))
+	{
+		return *Index;
+	}
+
+	// Forget Blueprints that were garbage collected since the last build
+	for(auto It = Indices.CreateIterator(); It; ++It)
+	{
+		if(!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	return Indices.Add(Blueprint, FBlueprintGraphIndex::Build(Blueprint));
+}
+
+TSharedRef<const FBlueprintGraphSnapshot> FBlueprintGraphIndexCache::FindOrCaptureSnapshot(UBlueprint* Blueprint)
+{
+	check(IsInGameThread());
+
+	if(const TSharedRef<const FBlueprintGraphSnapshot>* Snapshot = Snapshots.Find(Blueprint))
+	{
+		return *Snapshot;
+	}
+
+	for(auto It = Snapshots.CreateIterator(); It; ++It)
+	{
+		if(!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	return Snapshots.Add(Blueprint, FBlueprintGraphSnapshot::Capture(Blueprint));
+}
+
+TSharedRef<const TSet<FName>> FBlueprintGraphIndexCache::FindOrBuildDescendantCalls(UBlueprint* Blueprint)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBlueprintGraphIndexCache::FindOrBuildDescendantCalls);
+	check(IsInGameThread());
+
+	if(const FMergedNames* Cached = DescendantCalls.Find(Blueprint))
+	{
+		return Cached->Names;
+	}
+
+	TSharedRef<TSet<FName>> CalledFunctions = MakeShared<TSet<FName>>();
+	FMergedNames& Entry = DescendantCalls.Add(Blueprint, FMergedNames{ {}, CalledFunctions });
+
+	if(Blueprint->GeneratedClass)
+	{
+		TArray<UClass*> DerivedClasses;
+		UBPUtilsNodeFunctionLibrary::GetAllDerivedBlueprintClasses(Blueprint->GeneratedClass, DerivedClasses, true);
+
+		// Skeleton and generated classes of the same Blueprint are both reported
+		TSet<UBlueprint*> Descendants;
+		for(UClass* DerivedClass : DerivedClasses)
+		{
+			UBlueprint* DerivedBlueprint = DerivedClass ? Cast<UBlueprint>(DerivedClass->ClassGeneratedBy) : nullptr;
+			if(DerivedBlueprint && DerivedBlueprint != Blueprint)
+			{
+				Descendants.Add(DerivedBlueprint);
+			}
+		}
+
+		for(UBlueprint* Descendant : Descendants)
+		{
+			const TSharedRef<const FBlueprintGraphIndex> Index = FindOrBuild(Descendant);
+			for(const auto& Pair : Index->CallSitesByFunction)
+			{
+				CalledFunctions->Add(Pair.Key);
+			}
+			Entry.Members.Add(Descendant);
+		}
+	}
+
+	UE_LOG(BlueprintGraphIndexLog, Verbose, TEXT("Gathered %d called functions from %d descendants of %s"),
+		CalledFunctions->Num(), Entry.Members.Num(), *Blueprint->GetName());
+
+	return CalledFunctions;
+}
+
+TSharedRef<const TMap<FName, FBlueprintVariableSetSource>> FBlueprintGraphIndexCache::FindOrBuildHierarchyVariableSets(UBlueprint* Blueprint)
+{
+	check(IsInGameThread());
+
+	if(const FMergedVariableSets* Cached = HierarchyVariableSets.Find(Blueprint))
+	{
+		return Cached->Sources;
+	}
+
+	TSharedRef<TMap<FName, FBlueprintVariableSetSource>> VariableSets = MakeShared<TMap<FName, FBlueprintVariableSetSource>>();
+	TArray<TObjectKey<UBlueprint>> Members;
+
+	// Merge the parent's map first, it is cached in turn and shared with the siblings
+	UBlueprint* ParentBlueprint = Blueprint->ParentClass ? UBlueprint::GetBlueprintFromClass(Blueprint->ParentClass) : nullptr;
+	if(ParentBlueprint && ParentBlueprint != Blueprint)
+	{
+		VariableSets->Append(*FindOrBuildHierarchyVariableSets(ParentBlueprint));
+		Members = HierarchyVariableSets.FindChecked(ParentBlueprint).Members;
+	}
+
+	// The Blueprint's own set nodes take precedence over the ones of its ancestors
+	const TSharedRef<const FBlueprintGraphIndex> Index = FindOrBuild(Blueprint);
+	for(const auto& Pair : Index->VariableSets)
+	{
+		if(Pair.Value.Num() > 0)
+		{
+			VariableSets->Add(Pair.Key, FBlueprintVariableSetSource{ Blueprint, Pair.Value[0] });
+		}
+	}
+	Members.Add(Blueprint);
+
+	HierarchyVariableSets.Add(Blueprint, FMergedVariableSets{ MoveTemp(Members), VariableSets });
+	return VariableSets;
+}
+
+void FBlueprintGraphIndexCache::Invalidate(const UBlueprint* Blueprint)
+{
+	Indices.Remove(Blueprint);
+	Snapshots.Remove(Blueprint);
+
+	const TObjectKey<UBlueprint> BlueprintKey(Blueprint);
+
+	// A write set includes the whole class chain, drop the sets of every descendant
+	for(auto It = HierarchyVariableSets.CreateIterator(); It; ++It)
+	{
+		if(It.Value().Members.Contains(BlueprintKey))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if(DescendantCalls.Num() == 0) return;
+
+	// Every ancestor's set may include this Blueprint, including sets built before it was created
+	TSet<const UBlueprint*> Ancestors;
+	for(const UClass* Class = Blueprint->ParentClass; Class; Class = Class->GetSuperClass())
+	{
+		if(const UBlueprint* Ancestor = Cast<UBlueprint>(Class->ClassGeneratedBy))
+		{
+			Ancestors.Add(Ancestor);
+		}
+	}
+
+	for(auto It = DescendantCalls.CreateIterator(); It; ++It)
+	{
+		// Membership also covers a reparented child that no longer lists its old ancestors
+		if(It.Key() == BlueprintKey || Ancestors.Contains(It.Key().ResolveObjectPtr()) || It.Value().Members.Contains(BlueprintKey))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FBlueprintGraphIndexCache::Reset()
+{
+	Indices.Reset();
+	Snapshots.Reset();
+	DescendantCalls.Reset();
+	HierarchyVariableSets.Reset();
+}
+
+void FBlueprintGraphIndexCache::OnObjectModified(UObject* Object)
+{
+	if((Indices.Num() == 0 && Snapshots.Num() == 0 && DescendantCalls.Num() == 0 && HierarchyVariableSets.Num() == 0) || !Object) return;
+
+	const UBlueprint* Blueprint = Object->IsA<UBlueprint>() ? CastChecked<UBlueprint>(Object) : Object->GetTypedOuter<UBlueprint>();
+	if(Blueprint)
+	{
+		Invalidate(Blueprint);
+	}
+}
+
+void FBlueprintGraphIndexCache::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	Invalidate(Blueprint);
+}
@@ -0,0 +1,220 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Library/BlueprintGraphSnapshot.h"
+#include "Engine/Blueprint.h"
+#include "EdGraphNode_Comment.h"
+#include "K2Node_BaseMCDelegate.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Composite.h"
+#include "K2Node_Event.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_FunctionResult.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_Tunnel.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Library/BPUtilsNodeFunctionLibrary.h"
+
+namespace BlueprintGraphSnapshot
+{
+	static EBlueprintSnapshotGraphKind GetGraphKind(const UBlueprint* Blueprint, const UEdGraph* Graph)
+	{
+		if(Blueprint->FunctionGraphs.Contains(Graph)) return EBlueprintSnapshotGraphKind::Function;
+		if(Blueprint->MacroGraphs.Contains(Graph)) return EBlueprintSnapshotGraphKind::Macro;
+		if(Blueprint->UbergraphPages.Contains(Graph)) return EBlueprintSnapshotGraphKind::Ubergraph;
+		if(Blueprint->DelegateSignatureGraphs.Contains(Graph)) return EBlueprintSnapshotGraphKind::DelegateSignature;
+		if(Blueprint->IntermediateGeneratedGraphs.Contains(Graph)) return EBlueprintSnapshotGraphKind::Intermediate;
+
+		return EBlueprintSnapshotGraphKind::SubGraph;
+	}
+
+	static int32 FindGraphIndex(const TMap<const UEdGraph*, int32>& GraphIndices, const UEdGraph* Graph)
+	{
+		const int32* GraphIndex = GraphIndices.Find(Graph);
+		return GraphIndex ? *GraphIndex : INDEX_NONE;
+	}
+
+	static void CaptureNode(const UBlueprint* Blueprint, const TMap<const UEdGraph*, int32>& GraphIndices, UEdGraphNode* Node, FBlueprintSnapshotNode& OutNode)
+	{
+		OutNode.ClassName = Node->GetClass()->GetFName();
+		OutNode.Position = FIntPoint(Node->NodePosX, Node->NodePosY);
+		OutNode.Source = Node;
+
+		if(const UK2Node* K2Node = Cast<UK2Node>(Node))
+		{
+			OutNode.bIsPure = K2Node->IsNodePure();
+		}
+
+		if(Node->IsA<UK2Node_FunctionEntry>())
+		{
+			OutNode.Kind = EBlueprintSnapshotNodeKind::FunctionEntry;
+		}
+		else if(Node->IsA<UK2Node_FunctionResult>())
+		{
+			OutNode.Kind = EBlueprintSnapshotNodeKind::FunctionResult;
+		}
+		// Macro instances and composites derive from tunnels, only the plain class is an entry or exit
+		else if(Node->GetClass() == UK2Node_Tunnel::StaticClass())
+		{
+			OutNode.Kind = EBlueprintSnapshotNodeKind::Tunnel;
+		}
+		else if(const UK2Node_Event* Event = Cast<UK2Node_Event>(Node))
+		{
+			OutNode.Kind = EBlueprintSnapshotNodeKind::Event;
+			OutNode.MemberName = Event->GetFunctionName();
+			OutNode.bIsSelfMember = true;
+		}
+		else if(const UK2Node_CallFunction* CallFunction = Cast<UK2Node_CallFunction>(Node))
+		{
+			OutNode.Kind = EBlueprintSnapshotNodeKind::CallFunction;
+			OutNode.MemberName = CallFunction->FunctionReference.GetMemberName();
+			OutNode.bIsSelfMember = CallFunction->FunctionReference.IsSelfContext();
+		}
+		else if(const UK2Node_MacroInstance* MacroInstance = Cast<UK2Node_MacroInstance>(Node))
+		{
+			OutNode.Kind = EBlueprintSnapshotNodeKind::MacroInstance;
+			if(const UEdGraph* MacroGraph = MacroInstance->GetMacroGraph())
+			{
+				OutNode.MemberName = MacroGraph->GetFName();
+				OutNode.bIsSelfMember = MacroGraph->GetTypedOuter<UBlueprint>() == Blueprint;
+				OutNode.BoundGraph = FindGraphIndex(GraphIndices, MacroGraph);
+			}
+		}
+		else if(const UK2Node_Composite* Composite = Cast<UK2Node_Composite>(Node))
+		{
+			OutNode.BoundGraph = FindGraphIndex(GraphIndices, Composite->BoundGraph);
+		}
+		else if(const UK2Node_VariableGet* VariableGet = Cast<UK2Node_VariableGet>(Node))
+		{
+			OutNode.Kind = EBlueprintSnapshotNodeKind::VariableGet;
+			OutNode.MemberName = VariableGet->GetVarName();
+			OutNode.bIsSelfMember = VariableGet->VariableReference.IsSelfContext();
+		}
+		else if(const UK2Node_VariableSet* VariableSet = Cast<UK2Node_VariableSet>(Node))
+		{
+			OutNode.Kind = EBlueprintSnapshotNodeKind::VariableSet;
+			OutNode.MemberName = VariableSet->GetVarName();
+			OutNode.bIsSelfMember = VariableSet->VariableReference.IsSelfContext();
+		}
+		else if(const UK2Node_BaseMCDelegate* Delegate = Cast<UK2Node_BaseMCDelegate>(Node))
+		{
+			OutNode.Kind = EBlueprintSnapshotNodeKind::Delegate;
+			OutNode.MemberName = Delegate->GetPropertyName();
+			OutNode.bIsSelfMember = Delegate->DelegateReference.IsSelfContext();
+		}
+		else if(Node->IsA<UK2Node_IfThenElse>())
+		{
+			OutNode.Kind = EBlueprintSnapshotNodeKind::Branch;
+		}
+		else if(const UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Node))
+		{
+			OutNode.Kind = EBlueprintSnapshotNodeKind::Comment;
+			OutNode.Size = FIntPoint(Comment->NodeWidth, Comment->NodeHeight);
+		}
+	}
+}
+
+const FBlueprintSnapshotPin* FBlueprintSnapshotGraph::FindPin(const FBlueprintSnapshotNode& Node, FName PinName) const
+{
+	return GetPins(Node).FindByPredicate([PinName] (const FBlueprintSnapshotPin& Pin) { return Pin.Name == PinName; });
+}
+
+int32 FBlueprintSnapshotGraph::GetCodeNodeCount() const
+{
+	int32 CodeNodeCount = 0;
+	for(const FBlueprintSnapshotNode& Node : Nodes)
+	{
+		const bool bIsBoundary = Node.Kind == EBlueprintSnapshotNodeKind::FunctionEntry
+			|| Node.Kind == EBlueprintSnapshotNodeKind::FunctionResult
+			|| Node.Kind == EBlueprintSnapshotNodeKind::Tunnel;
+
+		CodeNodeCount += bIsBoundary ? 0 : 1;
+	}
+	return CodeNodeCount;
+}
+
+TSharedRef<const FBlueprintGraphSnapshot> FBlueprintGraphSnapshot::Capture(UBlueprint* InBlueprint)
+{
+	using namespace BlueprintGraphSnapshot;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBlueprintGraphSnapshot::Capture);
+	check(IsInGameThread() && InBlueprint);
+
+	TSharedRef<FBlueprintGraphSnapshot> Snapshot = MakeShared<FBlueprintGraphSnapshot>();
+	Snapshot->BlueprintName = InBlueprint->GetFName();
+	Snapshot->Blueprint = InBlueprint;
+
+	TArray<UEdGraph*> Graphs;
+	InBlueprint->GetAllGraphs(Graphs);
+	Graphs.Remove(nullptr);
+
+	Snapshot->Graphs.Reserve(Graphs.Num());
+
+	// Collapsed nodes and macro instances point at graphs that may come later
+	TMap<const UEdGraph*, int32> GraphIndices;
+	for(int32 GraphIndex = 0; GraphIndex < Graphs.Num(); ++GraphIndex)
+	{
+		GraphIndices.Add(Graphs[GraphIndex], GraphIndex);
+	}
+
+	TMap<const UEdGraphPin*, int32> PinIndices;
+
+	for(UEdGraph* Graph : Graphs)
+	{
+		FBlueprintSnapshotGraph& GraphSnapshot = Snapshot->Graphs.AddDefaulted_GetRef();
+		GraphSnapshot.Name = Graph->GetFName();
+		GraphSnapshot.Kind = GetGraphKind(InBlueprint, Graph);
+		GraphSnapshot.TypeName = UBPUtilsNodeFunctionLibrary::GetGraphType(InBlueprint, Graph);
+		GraphSnapshot.Source = Graph;
+		GraphSnapshot.Nodes.Reserve(Graph->Nodes.Num());
+
+		// Number every pin first, links may point at pins of nodes further down
+		PinIndices.Reset();
+
+		for(UEdGraphNode* Node : Graph->Nodes)
+		{
+			if(!Node) continue;
+
+			const int32 NodeIndex = GraphSnapshot.Nodes.Num();
+			FBlueprintSnapshotNode& NodeSnapshot = GraphSnapshot.Nodes.AddDefaulted_GetRef();
+			CaptureNode(InBlueprint, GraphIndices, Node, NodeSnapshot);
+
+			NodeSnapshot.FirstPin = GraphSnapshot.Pins.Num();
+
+			for(const UEdGraphPin* Pin : Node->Pins)
+			{
+				if(!Pin) continue;
+
+				PinIndices.Add(Pin, GraphSnapshot.Pins.Num());
+
+				FBlueprintSnapshotPin& PinSnapshot = GraphSnapshot.Pins.AddDefaulted_GetRef();
+				PinSnapshot.Name = Pin->PinName;
+				PinSnapshot.Category = Pin->PinType.PinCategory;
+				PinSnapshot.Direction = Pin->Direction;
+				PinSnapshot.DefaultValue = Pin->DefaultValue;
+				PinSnapshot.Node = NodeIndex;
+			}
+
+			NodeSnapshot.NumPins = GraphSnapshot.Pins.Num() - NodeSnapshot.FirstPin;
+		}
+
+		for(const TPair<const UEdGraphPin*, int32>& Pair : PinIndices)
+		{
+			TArray<int32>& LinkedTo = GraphSnapshot.Pins[Pair.Value].LinkedTo;
+			LinkedTo.Reserve(Pair.Key->LinkedTo.Num());
+
+			for(const UEdGraphPin* LinkedPin : Pair.Key->LinkedTo)
+			{
+				// Links never leave their graph, a missing index means a stale link
+				if(const int32* LinkedIndex = PinIndices.Find(LinkedPin))
+				{
+					LinkedTo.Add(*LinkedIndex);
+				}
+			}
+		}
+	}
+
+	return Snapshot;
+}
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Library/ClassDefaultTextCache.h"
+#include "Engine/Blueprint.h"
+#include "Editor.h"
+
+void FClassDefaultTextCache::Initialize()
+{
+	if(!ObjectModifiedHandle.IsValid())
+	{
+		ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FClassDefaultTextCache::OnObjectModified);
+	}
+
+	if(!UndoRedoHandle.IsValid())
+	{
+		UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FClassDefaultTextCache::Reset);
+	}
+
+	if(GEditor && !BlueprintPreCompileHandle.IsValid())
+	{
+		BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FClassDefaultTextCache::OnBlueprintPreCompile);
+	}
+}
+
+void FClassDefaultTextCache::Shutdown()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+
+	if(GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+	}
+
+	ObjectModifiedHandle.Reset();
+	UndoRedoHandle.Reset();
+	BlueprintPreCompileHandle.Reset();
+
+	Reset();
+}
+
+const FString& FClassDefaultTextCache::FindOrExport(UClass* Class, const FProperty* Property)
+{
+	check(IsInGameThread());
+
+	TMap<FName, FString>* DefaultTexts = DefaultTextsByClass.Find(Class);
+	if(!DefaultTexts)
+	{
+		// Forget classes that were garbage collected or replaced by a recompile since the last query
+		for(auto It = DefaultTextsByClass.CreateIterator(); It; ++It)
+		{
+			if(!It.Key().ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		DefaultTexts = &DefaultTextsByClass.Add(Class);
+	}
+
+	if(const FString* DefaultText = DefaultTexts->Find(Property->GetFName()))
+	{
+		return *DefaultText;
+	}
+
+	FString& DefaultText = DefaultTexts->Add(Property->GetFName());
+
+	if(const UObject* DefaultObject = Class->GetDefaultObject(false))
+	{
+		Property->ExportText_InContainer(0, DefaultText, DefaultObject, DefaultObject, nullptr, PPF_None);
+	}
+
+	return DefaultText;
+}
+
+void FClassDefaultTextCache::Invalidate(const UClass* Class)
+{
+	if(!Class) return;
+
+	// Derived classes inherit the defaults they do not override
+	for(auto It = DefaultTextsByClass.CreateIterator(); It; ++It)
+	{
+		const UClass* CachedClass = It.Key().ResolveObjectPtr();
+		if(!CachedClass || CachedClass->IsChildOf(Class))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FClassDefaultTextCache::Reset()
+{
+	DefaultTextsByClass.Reset();
+}
+
+void FClassDefaultTextCache::OnObjectModified(UObject* Object)
+{
+	if(DefaultTextsByClass.Num() == 0 || !Object || !Object->HasAnyFlags(RF_ClassDefaultObject)) return;
+
+	Invalidate(Object->GetClass());
+}
+
+void FClassDefaultTextCache::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	if(DefaultTextsByClass.Num() == 0 || !Blueprint) return;
+
+	Invalidate(Blueprint->GeneratedClass);
+}
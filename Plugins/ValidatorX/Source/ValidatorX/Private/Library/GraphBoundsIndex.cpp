@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Library/GraphBoundsIndex.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Unique.h"
+
+void FGraphBoundsIndex::Build(TArray<FBox2D> InBounds)
+{
+	Bounds = MoveTemp(InBounds);
+	Edges.Reset();
+	Nodes.Reset();
+	NumLeaves = 0;
+
+	if(Bounds.Num() == 0) return;
+
+	for(const FBox2D& Box : Bounds)
+	{
+		Edges.Add(Box.Min.X);
+		Edges.Add(Box.Max.X);
+	}
+	Edges.Sort();
+	Edges.SetNum(Algo::Unique(Edges));
+
+	const int32 NumSlots = Edges.Num() * 2 - 1;
+	NumLeaves = FMath::RoundUpToPowerOfTwo(NumSlots);
+	Nodes.SetNum(NumLeaves * 2);
+
+	for(int32 BoundsIndex = 0; BoundsIndex < Bounds.Num(); ++BoundsIndex)
+	{
+		const FBox2D& Box = Bounds[BoundsIndex];
+		const FSpan Span{ Box.Min.Y, Box.Max.Y, Box.Max.Y, BoundsIndex };
+
+		// Store the span in the O(log n) nodes that exactly cover the leaves [First, Last]
+		int32 First = Algo::LowerBound(Edges, Box.Min.X) * 2 + NumLeaves;
+		int32 End = Algo::LowerBound(Edges, Box.Max.X) * 2 + NumLeaves + 1;
+
+		while(First < End)
+		{
+			if(First & 1)
+			{
+				Nodes[First++].Add(Span);
+			}
+			if(End & 1)
+			{
+				Nodes[--End].Add(Span);
+			}
+			First >>= 1;
+			End >>= 1;
+		}
+	}
+
+	for(TArray<FSpan>& Spans : Nodes)
+	{
+		Spans.Sort([] (const FSpan& A, const FSpan& B) { return A.MinY < B.MinY; });
+
+		double RunningMaxY = -UE_DOUBLE_BIG_NUMBER;
+		for(FSpan& Span : Spans)
+		{
+			RunningMaxY = FMath::Max(RunningMaxY, Span.MaxY);
+			Span.RunningMaxY = RunningMaxY;
+		}
+	}
+}
+
+bool FGraphBoundsIndex::ContainsPoint(const FVector2D& Point) const
+{
+	for(int32 Node = FindLeaf(Point.X); Node > 0; Node >>= 1)
+	{
+		// Every span of the node covers X; one of those starting at or above Y must also end at or below it
+		const TArray<FSpan>& Spans = Nodes[Node];
+		const int32 NumCandidates = CountSpansStartingAtOrBelow(Spans, Point.Y);
+
+		if(NumCandidates > 0 && Spans[NumCandidates - 1].RunningMaxY >= Point.Y)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FGraphBoundsIndex::FindContaining(const FVector2D& Point, TArray<int32>& OutBoundsIndices) const
+{
+	for(int32 Node = FindLeaf(Point.X); Node > 0; Node >>= 1)
+	{
+		const TArray<FSpan>& Spans = Nodes[Node];
+		const int32 NumCandidates = CountSpansStartingAtOrBelow(Spans, Point.Y);
+
+		if(NumCandidates == 0 || Spans[NumCandidates - 1].RunningMaxY < Point.Y) continue;
+
+		for(int32 SpanIndex = 0; SpanIndex < NumCandidates; ++SpanIndex)
+		{
+			if(Spans[SpanIndex].MaxY >= Point.Y)
+			{
+				OutBoundsIndices.Add(Spans[SpanIndex].BoundsIndex);
+			}
+		}
+	}
+}
+
+int32 FGraphBoundsIndex::FindLeaf(double X) const
+{
+	if(Edges.Num() == 0 || X < Edges[0] || X > Edges.Last()) return INDEX_NONE;
+
+	const int32 EdgeIndex = Algo::LowerBound(Edges, X);
+	const int32 Slot = Edges[EdgeIndex] == X ? EdgeIndex * 2 : EdgeIndex * 2 - 1;
+
+	return NumLeaves + Slot;
+}
+
+int32 FGraphBoundsIndex::CountSpansStartingAtOrBelow(const TArray<FSpan>& Spans, double Y)
+{
+	return Algo::UpperBoundBy(Spans, Y, &FSpan::MinY);
+}
@@ -0,0 +1,303 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Library/ValidationResultCache.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Hash/Blake3.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(ValidationResultCacheLog, All, All);
+
+namespace ValidationResultCache
+{
+	constexpr uint32 FileMagic = 0x56584331;
+
+	/** Bump when the file layout or the key composition changes. */
+	constexpr uint32 FileVersion = 1;
+
+	void SerializeResult(FArchive& Ar, FCachedValidationResult& Cached)
+	{
+		Ar << Cached.Key;
+
+		uint8 Result = static_cast<uint8>(Cached.Result);
+		Ar << Result;
+		Cached.Result = static_cast<EDataValidationResult>(Result);
+
+		int32 NumMessages = Cached.Messages.Num();
+		Ar << NumMessages;
+		if(Ar.IsLoading())
+		{
+			if(NumMessages < 0 || Ar.IsError()) return;
+			Cached.Messages.SetNum(NumMessages);
+		}
+
+		for(FCachedValidationMessage& Message : Cached.Messages)
+		{
+			uint8 Severity = static_cast<uint8>(Message.Severity);
+			Ar << Severity;
+			Message.Severity = static_cast<EMessageSeverity::Type>(Severity);
+
+			Ar << Message.Text;
+			Ar << Message.ActionLabels;
+
+			if(Ar.IsError()) return;
+		}
+	}
+
+	/** @return False if the data was written by another version or is truncated. */
+	bool SerializeResults(FArchive& Ar, TMap<FName, TMap<FName, FCachedValidationResult>>& ResultsByPackage)
+	{
+		uint32 Magic = FileMagic;
+		uint32 Version = FileVersion;
+		Ar << Magic;
+		Ar << Version;
+		if(Magic != FileMagic || Version != FileVersion) return false;
+
+		int32 NumPackages = ResultsByPackage.Num();
+		Ar << NumPackages;
+
+		if(Ar.IsSaving())
+		{
+			for(TPair<FName, TMap<FName, FCachedValidationResult>>& PackagePair : ResultsByPackage)
+			{
+				FString PackageName = PackagePair.Key.ToString();
+				int32 NumResults = PackagePair.Value.Num();
+				Ar << PackageName;
+				Ar << NumResults;
+
+				for(TPair<FName, FCachedValidationResult>& ResultPair : PackagePair.Value)
+				{
+					FString ValidatorName = ResultPair.Key.ToString();
+					Ar << ValidatorName;
+					SerializeResult(Ar, ResultPair.Value);
+				}
+			}
+			return !Ar.IsError();
+		}
+
+		for(int32 PackageIndex = 0; PackageIndex < NumPackages && !Ar.IsError(); ++PackageIndex)
+		{
+			FString PackageName;
+			int32 NumResults = 0;
+			Ar << PackageName;
+			Ar << NumResults;
+
+			TMap<FName, FCachedValidationResult>& PackageResults = ResultsByPackage.Add(FName(*PackageName));
+			for(int32 ResultIndex = 0; ResultIndex < NumResults && !Ar.IsError(); ++ResultIndex)
+			{
+				FString ValidatorName;
+				Ar << ValidatorName;
+				SerializeResult(Ar, PackageResults.Add(FName(*ValidatorName)));
+			}
+		}
+		return !Ar.IsError();
+	}
+}
+
+bool FValidationResultCache::ComputeKey(const UBlueprintValidatorBase& Validator, const FAssetData& AssetData, FIoHash& OutKey) const
+{
+	if(!bIsEnabled) return false;
+
+	FIoHash PackageHash;
+	if(!GetPackageHash(AssetData.PackageName, PackageHash) || PackageHash.IsZero()) return false;
+
+	FBlake3 Hasher;
+	const auto UpdateString = [&Hasher] (const FString& Value)
+		{
+			Hasher.Update(*Value, Value.Len() * sizeof(TCHAR));
+		};
+
+	const uint32 FileVersion = ValidationResultCache::FileVersion;
+	const int32 CacheVersion = Validator.GetCacheVersion();
+	Hasher.Update(&FileVersion, sizeof(FileVersion));
+	Hasher.Update(&CacheVersion, sizeof(CacheVersion));
+	UpdateString(Validator.GetClass()->GetPathName());
+
+	// Config properties change what a validator reports, e.g. a node count threshold
+	for(TFieldIterator<FProperty> It(Validator.GetClass()); It; ++It)
+	{
+		if(!It->HasAnyPropertyFlags(CPF_Config) || !It->GetOwnerClass()->IsChildOf<UBlueprintValidatorBase>()) continue;
+
+		FString Value;
+		It->ExportText_InContainer(0, Value, &Validator, nullptr, nullptr, PPF_None);
+		UpdateString(It->GetName());
+		UpdateString(Value);
+	}
+
+	Hasher.Update(&PackageHash, sizeof(PackageHash));
+
+	TArray<FName> Dependencies;
+	Validator.GetCacheDependencies(AssetData, Dependencies);
+	Dependencies.Sort(FNameLexicalLess());
+
+	for(const FName Dependency : Dependencies)
+	{
+		FIoHash DependencyHash;
+		if(!GetPackageHash(Dependency, DependencyHash)) return false;
+
+		UpdateString(Dependency.ToString());
+		Hasher.Update(&DependencyHash, sizeof(DependencyHash));
+	}
+
+	OutKey = FIoHash(Hasher.Finalize());
+	return true;
+}
+
+const FCachedValidationResult* FValidationResultCache::Find(FName PackageName, FName ValidatorName, const FIoHash& Key)
+{
+	EnsureLoaded();
+
+	if(const TMap<FName, FCachedValidationResult>* PackageResults = ResultsByPackage.Find(PackageName))
+	{
+		const FCachedValidationResult* Cached = PackageResults->Find(ValidatorName);
+		if(Cached && Cached->Key == Key)
+		{
+			return Cached;
+		}
+	}
+	return nullptr;
+}
+
+void FValidationResultCache::Store(FName PackageName, FName ValidatorName, const FIoHash& Key, EDataValidationResult Result, TConstArrayView<FDataValidationContext::FIssue> Issues)
+{
+	EnsureLoaded();
+
+	FCachedValidationResult& Cached = ResultsByPackage.FindOrAdd(PackageName).FindOrAdd(ValidatorName);
+	Cached.Key = Key;
+	Cached.Result = Result;
+	Cached.Messages.Reset();
+
+	for(const FDataValidationContext::FIssue& Issue : Issues)
+	{
+		FCachedValidationMessage& Message = Cached.Messages.AddDefaulted_GetRef();
+		Message.Severity = Issue.Severity;
+
+		if(!Issue.TokenizedMessage.IsValid())
+		{
+			Message.Text = Issue.Message.ToString();
+			continue;
+		}
+
+		for(const TSharedRef<IMessageToken>& Token : Issue.TokenizedMessage->GetMessageTokens())
+		{
+			if(Token->GetType() == EMessageToken::Action)
+			{
+				Message.ActionLabels.Add(Token->ToText().ToString());
+			}
+			else if(Token->GetType() != EMessageToken::Severity)
+			{
+				Message.Text += Message.Text.IsEmpty() ? Token->ToText().ToString() : TEXT(" ") + Token->ToText().ToString();
+			}
+		}
+	}
+
+	bIsDirty = true;
+}
+
+void FValidationResultCache::Replay(UBlueprintValidatorBase& Validator, const FAssetData& AssetData, const FCachedValidationResult& Cached, FDataValidationContext& Context) const
+{
+	for(int32 MessageIndex = 0; MessageIndex < Cached.Messages.Num(); ++MessageIndex)
+	{
+		const FCachedValidationMessage& Message = Cached.Messages[MessageIndex];
+		const TSharedRef<FTokenizedMessage> TokenizedMessage = Context.AddMessage(Message.Severity, FText::FromString(Message.Text));
+
+		for(int32 ActionIndex = 0; ActionIndex < Message.ActionLabels.Num(); ++ActionIndex)
+		{
+			TokenizedMessage->AddToken(FActionToken::Create(FText::FromString(Message.ActionLabels[ActionIndex]), FText::GetEmpty(),
+				FSimpleDelegate::CreateLambda([WeakValidator = TWeakObjectPtr<UBlueprintValidatorBase>(&Validator), ObjectPath = AssetData.GetSoftObjectPath(), MessageIndex, ActionIndex]
+					{
+						UBlueprintValidatorBase* FreshValidator = WeakValidator.Get();
+						UObject* Asset = ObjectPath.TryLoad();
+						if(!FreshValidator || !Asset) return;
+
+						// The asset is unchanged, so a fresh run reports the same messages in the same order
+						FDataValidationContext FreshContext(false, EDataValidationUsecase::Manual, {});
+						FreshValidator->ValidateBlueprintAsset(FAssetData(Asset), Asset, FreshContext);
+
+						const TArray<FDataValidationContext::FIssue>& Issues = FreshContext.GetIssues();
+						if(!Issues.IsValidIndex(MessageIndex) || !Issues[MessageIndex].TokenizedMessage.IsValid()) return;
+
+						int32 CurrentActionIndex = 0;
+						for(const TSharedRef<IMessageToken>& Token : Issues[MessageIndex].TokenizedMessage->GetMessageTokens())
+						{
+							if(Token->GetType() == EMessageToken::Action && CurrentActionIndex++ == ActionIndex)
+							{
+								StaticCastSharedRef<FActionToken>(Token)->ExecuteAction();
+								return;
+							}
+						}
+					})));
+		}
+	}
+}
+
+void FValidationResultCache::Save()
+{
+	if(!bIsDirty) return;
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	ValidationResultCache::SerializeResults(Writer, ResultsByPackage);
+
+	const FString FilePath = GetCacheFilePath();
+	if(!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+	{
+		UE_LOG(ValidationResultCacheLog, Warning, TEXT("Failed to write the validation cache to %s"), *FilePath);
+		return;
+	}
+
+	bIsDirty = false;
+}
+
+void FValidationResultCache::EnsureLoaded()
+{
+	check(IsInGameThread());
+	if(bIsLoaded) return;
+
+	bIsLoaded = true;
+
+	const FString FilePath = GetCacheFilePath();
+
+	TArray<uint8> Bytes;
+	if(!FFileHelper::LoadFileToArray(Bytes, *FilePath, FILEREAD_Silent)) return;
+
+	FMemoryReader Reader(Bytes);
+	if(!ValidationResultCache::SerializeResults(Reader, ResultsByPackage))
+	{
+		UE_LOG(ValidationResultCacheLog, Log, TEXT("Discarding outdated validation cache %s"), *FilePath);
+		ResultsByPackage.Reset();
+		return;
+	}
+
+	UE_LOG(ValidationResultCacheLog, Log, TEXT("Loaded cached validation results of %d packages"), ResultsByPackage.Num());
+}
+
+bool FValidationResultCache::GetPackageHash(FName PackageName, FIoHash& OutHash)
+{
+	OutHash = FIoHash::Zero;
+
+	// A loaded package knows its new hash right after a save, before the asset registry has rescanned the file
+	if(const UPackage* Package = FindObjectFast<UPackage>(nullptr, PackageName))
+	{
+		if(Package->IsDirty()) return false;
+
+		OutHash = Package->GetSavedHash();
+		if(!OutHash.IsZero()) return true;
+	}
+
+	if(const TOptional<FAssetPackageData> PackageData = IAssetRegistry::GetChecked().GetAssetPackageDataCopy(PackageName))
+	{
+		OutHash = PackageData->GetPackageSavedHash();
+	}
+	return true;
+}
+
+FString FValidationResultCache::GetCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ValidatorX") / TEXT("ValidationCache.bin");
+}
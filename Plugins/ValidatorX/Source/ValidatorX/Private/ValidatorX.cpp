@@ -2,8 +2,14 @@
 
 #include "ValidatorX.h"
 #include "ValidatorXManager.h"
+#include "ValidatorXBackgroundValidator.h"
 #include "Widgets/SValidatorWidget.h"
 #include "EditorValidatorSubsystem.h"
+#include "Library/BlueprintGraphIndex.h"
+#include "Library/BlueprintClassHierarchy.h"
+#include "Library/BlueprintCallGraph.h"
+#include "Library/ClassDefaultTextCache.h"
+#include "Library/ValidationResultCache.h"
 
 #include "Layout/WidgetPath.h"
 DEFINE_LOG_CATEGORY_STATIC(LogValidatorX, All, All);
@@ -43,6 +49,12 @@ void FValidatorXModule::ShutdownModule()
 {
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(ValidatorXTabName);
 	UToolMenus::UnregisterOwner(this);
+	FValidatorXBackgroundValidator::Get().Shutdown();
+	FBlueprintGraphIndexCache::Get().Shutdown();
+	FBlueprintClassHierarchy::Get().Shutdown();
+	FBlueprintCallGraph::Get().Shutdown();
+	FClassDefaultTextCache::Get().Shutdown();
+	FValidationResultCache::Get().Save();
 }
 
 ETabSpawnerMenuType::Type FValidatorXModule::GetVisibleModule() const
@@ -62,6 +74,11 @@ void FValidatorXModule::HandlePostEngineInit()
 	{
 		UE_LOG(LogTemp, Warning, TEXT("GEditor is valid"));
 
+		FBlueprintGraphIndexCache::Get().Initialize();
+		FBlueprintClassHierarchy::Get().Initialize();
+		FBlueprintCallGraph::Get().Initialize();
+		FClassDefaultTextCache::Get().Initialize();
+
 		UEditorValidatorSubsystem* ValidatorSubsystem = GEditor->GetEditorSubsystem<UEditorValidatorSubsystem>();
 		if(ValidatorSubsystem)
 		{
@@ -85,6 +102,8 @@ void FValidatorXModule::HandlePostEngineInit()
 		{
 			UE_LOG(LogTemp, Warning, TEXT("ValidatorSubsystem is nullptr"));
 		}
+
+		FValidatorXBackgroundValidator::Get().Initialize();
 	}
 }
 
@@ -0,0 +1,306 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ValidatorXBackgroundValidator.h"
+#include "ValidatorXManager.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
+#include "Logging/IMessageLogListing.h"
+#include "Logging/MessageLog.h"
+#include "MessageLogModule.h"
+#include "Misc/DataValidation.h"
+#include "Misc/UObjectToken.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(ValidatorXBackgroundLog, All, All);
+
+#define LOCTEXT_NAMESPACE "ValidatorXBackgroundValidator"
+
+static TAutoConsoleVariable<bool> CVarAutoValidate(
+	TEXT("ValidatorX.AutoValidate"),
+	true,
+	TEXT("Validate Blueprints in the background after they are compiled in their editor or saved."));
+
+static TAutoConsoleVariable<float> CVarAutoValidateDelay(
+	TEXT("ValidatorX.AutoValidate.DelaySeconds"),
+	1.0f,
+	TEXT("Quiet period after the last compile or save of a Blueprint before it is validated."));
+
+static TAutoConsoleVariable<float> CVarAutoValidateBudget(
+	TEXT("ValidatorX.AutoValidate.BudgetMs"),
+	4.0f,
+	TEXT("Time per frame spent on background validation. A validator that is already running always finishes, one expected to exceed the rest of the budget waits for the next frame, and one usually exceeding the whole budget is not run in the background."));
+
+const FName FValidatorXBackgroundValidator::MessageLogName = TEXT("ValidatorX");
+
+void FValidatorXBackgroundValidator::Initialize()
+{
+	if(IsRunningCommandlet() || !GEditor || TickerHandle.IsValid()) return;
+
+	FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
+	if(!MessageLogModule.IsRegisteredLogListing(MessageLogName))
+	{
+		MessageLogModule.RegisterLogListing(MessageLogName, LOCTEXT("MessageLogLabel", "ValidatorX"));
+	}
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FValidatorXBackgroundValidator::Tick));
+	BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FValidatorXBackgroundValidator::OnBlueprintPreCompile);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FValidatorXBackgroundValidator::OnPackageSaved);
+}
+
+void FValidatorXBackgroundValidator::Shutdown()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+
+	if(GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+	}
+
+	if(FMessageLogModule* MessageLogModule = FModuleManager::GetModulePtr<FMessageLogModule>("MessageLog"))
+	{
+		if(MessageLogModule->IsRegisteredLogListing(MessageLogName))
+		{
+			MessageLogModule->UnregisterLogListing(MessageLogName);
+		}
+	}
+
+	TickerHandle.Reset();
+	BlueprintPreCompileHandle.Reset();
+	PackageSavedHandle.Reset();
+
+	DueTimes.Reset();
+	Active.Reset();
+	MessagesByBlueprint.Reset();
+}
+
+void FValidatorXBackgroundValidator::Enqueue(UBlueprint* Blueprint)
+{
+	if(!Blueprint || !CVarAutoValidate.GetValueOnGameThread()) return;
+
+	// A newer request makes the running one stale
+	if(Active.IsSet() && Active->Blueprint == Blueprint)
+	{
+		Active.Reset();
+	}
+
+	DueTimes.Add(Blueprint, FPlatformTime::Seconds() + CVarAutoValidateDelay.GetValueOnGameThread());
+}
+
+bool FValidatorXBackgroundValidator::Tick(float DeltaTime)
+{
+	if(!Active.IsSet() && DueTimes.Num() == 0) return true;
+
+	// Validators walk editor graphs, keep out of play sessions and garbage collection
+	if(!CVarAutoValidate.GetValueOnGameThread() || GEditor->IsPlaySessionInProgress() || IsGarbageCollecting()) return true;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FValidatorXBackgroundValidator::Tick);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double Budget = CVarAutoValidateBudget.GetValueOnGameThread() / 1000.0;
+	bool bHasRun = false;
+
+	while(FPlatformTime::Seconds() - StartTime < Budget)
+	{
+		if(!Active.IsSet() && !StartNextDue(FPlatformTime::Seconds())) break;
+
+		if(!CanRunNextValidatorWithin(Budget - (FPlatformTime::Seconds() - StartTime), !bHasRun)) break;
+
+		RunNextValidator();
+		bHasRun = true;
+	}
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	if(Seconds > Budget)
+	{
+		UE_LOG(ValidatorXBackgroundLog, Verbose, TEXT("Background validation took %.2f ms, over the %.2f ms budget"), Seconds * 1000.0, Budget * 1000.0);
+	}
+
+	return true;
+}
+
+bool FValidatorXBackgroundValidator::StartNextDue(double Now)
+{
+	TObjectKey<UBlueprint> NextKey;
+	double NextDueTime = Now;
+
+	for(auto It = DueTimes.CreateIterator(); It; ++It)
+	{
+		if(!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+		else if(It.Value() <= NextDueTime)
+		{
+			NextKey = It.Key();
+			NextDueTime = It.Value();
+		}
+	}
+
+	UBlueprint* Blueprint = NextKey.ResolveObjectPtr();
+	if(!Blueprint) return false;
+
+	DueTimes.Remove(NextKey);
+
+	FActiveValidation& Validation = Active.Emplace();
+	Validation.Blueprint = Blueprint;
+	Validation.AssetData = FAssetData(Blueprint);
+	Validation.StartTime = FPlatformTime::Seconds();
+
+	const double Budget = CVarAutoValidateBudget.GetValueOnGameThread() / 1000.0;
+
+	for(const TWeakObjectPtr<UBlueprintValidatorBase>& Validator : FValidatorXManager::Get().GetValidators())
+	{
+		if(!Validator.IsValid() || !Validator->IsEnabled() || !Validator->PassesAssetPrefilter(Validation.AssetData)) continue;
+
+		// A validator that cannot fit in a frame would stall the editor; it still runs on save and from the commandlet
+		const double UncachedMeanSeconds = Validator->GetStats().GetUncachedMeanSeconds();
+		if(Validator->IsExpensive() || UncachedMeanSeconds > Budget)
+		{
+			UE_LOG(ValidatorXBackgroundLog, Verbose, TEXT("Skipped %s on %s, expensive or %.2f ms per uncached run"),
+				*Validator->GetClass()->GetName(), *Blueprint->GetName(), UncachedMeanSeconds * 1000.0);
+			continue;
+		}
+
+		Validation.Validators.Add(Validator);
+	}
+
+	return true;
+}
+
+void FValidatorXBackgroundValidator::RunNextValidator()
+{
+	FActiveValidation& Validation = *Active;
+	UBlueprint* Blueprint = Validation.Blueprint.Get();
+
+	if(!Blueprint || Validation.NextValidator >= Validation.Validators.Num())
+	{
+		if(Blueprint)
+		{
+			UE_LOG(ValidatorXBackgroundLog, Verbose, TEXT("Validated %s with %d validators in %.2f ms, %d messages"),
+				*Blueprint->GetName(), Validation.Validators.Num(), (FPlatformTime::Seconds() - Validation.StartTime) * 1000.0, Validation.NumMessages);
+
+			// A validation without any result still clears the messages of the previous one
+			if(!Validation.bHasReplacedMessages && MessagesByBlueprint.Remove(Blueprint) > 0)
+			{
+				PublishMessages();
+			}
+		}
+		Active.Reset();
+		return;
+	}
+
+	UBlueprintValidatorBase* Validator = Validation.Validators[Validation.NextValidator++].Get();
+	if(!Validator || !Validator->IsEnabled()) return;
+
+	FDataValidationContext Context(false, EDataValidationUsecase::Manual, {});
+	if(Validator->ValidateAsset(Validation.AssetData, Blueprint, Context) == EDataValidationResult::NotValidated) return;
+
+	TArray<TSharedRef<FTokenizedMessage>> Messages;
+	for(const FDataValidationContext::FIssue& Issue : Context.GetIssues())
+	{
+		// Lead with the Blueprint, as the log mixes the messages of every validated asset
+		const TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(Issue.Severity);
+		Message->AddToken(FUObjectToken::Create(Blueprint));
+
+		if(Issue.TokenizedMessage.IsValid())
+		{
+			for(const TSharedRef<IMessageToken>& Token : Issue.TokenizedMessage->GetMessageTokens())
+			{
+				Message->AddToken(Token);
+			}
+		}
+		else
+		{
+			Message->AddToken(FTextToken::Create(Issue.Message));
+		}
+
+		Messages.Add(Message);
+	}
+
+	// The first result of a validation replaces the messages of the previous one, later results add to them
+	bool bHasChanged = Messages.Num() > 0;
+	if(!Validation.bHasReplacedMessages)
+	{
+		Validation.bHasReplacedMessages = true;
+		bHasChanged |= MessagesByBlueprint.Remove(Blueprint) > 0;
+	}
+
+	if(Messages.Num() > 0)
+	{
+		Validation.NumMessages += Messages.Num();
+		MessagesByBlueprint.FindOrAdd(Blueprint).Append(MoveTemp(Messages));
+	}
+
+	if(bHasChanged)
+	{
+		PublishMessages();
+	}
+}
+
+bool FValidatorXBackgroundValidator::CanRunNextValidatorWithin(double Seconds, bool bIsFirstInFrame) const
+{
+	const FActiveValidation& Validation = *Active;
+
+	// Ending the validation of a finished Blueprint is cheap
+	if(!Validation.Validators.IsValidIndex(Validation.NextValidator)) return true;
+
+	const UBlueprintValidatorBase* Validator = Validation.Validators[Validation.NextValidator].Get();
+	if(!Validator) return true;
+
+	// Validators over the whole budget are not queued, so the first one of a frame always fits.
+	// Cache hits are cheap and would hide what a run that misses the cache costs.
+	const FValidatorXStats& Stats = Validator->GetStats();
+	return bIsFirstInFrame || (Stats.GetUncachedCalls() > 0 && Stats.GetUncachedMeanSeconds() <= Seconds);
+}
+
+void FValidatorXBackgroundValidator::PublishMessages()
+{
+	FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
+	if(!MessageLogModule.IsRegisteredLogListing(MessageLogName)) return;
+
+	TArray<TSharedRef<FTokenizedMessage>> AllMessages;
+	for(auto It = MessagesByBlueprint.CreateIterator(); It; ++It)
+	{
+		// Messages of deleted Blueprints would only jump to nothing
+		if(!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		AllMessages.Append(It.Value());
+	}
+
+	const TSharedRef<IMessageLogListing> Listing = MessageLogModule.GetLogListing(MessageLogName);
+	Listing->ClearMessages();
+	Listing->AddMessages(AllMessages, false);
+}
+
+void FValidatorXBackgroundValidator::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	// Blueprints are also compiled while loading; only react to compiles of Blueprints open in an editor
+	if(!Blueprint || GIsEditorLoadingPackage) return;
+
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+	if(AssetEditorSubsystem && AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+	{
+		Enqueue(Blueprint);
+	}
+}
+
+void FValidatorXBackgroundValidator::OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	if(!Package || ObjectSaveContext.IsProceduralSave()) return;
+
+	if(UBlueprint* Blueprint = Cast<UBlueprint>(Package->FindAssetInPackage()))
+	{
+		Enqueue(Blueprint);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -2,4 +2,40 @@
 
 
 #include "ValidatorXManager.h"
+#include "Misc/FileHelper.h"
 
+void FValidatorXManager::ResetStats()
+{
+	for(const TWeakObjectPtr<UBlueprintValidatorBase>& Validator : Validators)
+	{
+		if(Validator.IsValid())
+		{
+			Validator->ResetStats();
+		}
+	}
+}
+
+bool FValidatorXManager::ExportStatsToCsv(const FString& FileName) const
+{
+	FString Csv = TEXT("Validator,Enabled,Calls,CacheHits,Failures,TotalMs,MeanMs,MaxMs,NodesVisited,MessagesEmitted\n");
+
+	for(const TWeakObjectPtr<UBlueprintValidatorBase>& Validator : Validators)
+	{
+		if(!Validator.IsValid()) continue;
+
+		const FValidatorXStats& Stats = Validator->GetStats();
+		Csv += FString::Printf(TEXT("%s,%s,%d,%d,%d,%.3f,%.3f,%.3f,%lld,%d\n"),
+			*Validator->GetClass()->GetName(),
+			Validator->IsEnabled() ? TEXT("true") : TEXT("false"),
+			Stats.Calls,
+			Stats.CacheHits,
+			Stats.Failures,
+			Stats.TotalSeconds * 1000.0,
+			Stats.GetMeanSeconds() * 1000.0,
+			Stats.MaxSeconds * 1000.0,
+			Stats.NodesVisited,
+			Stats.MessagesEmitted);
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *FileName);
+}
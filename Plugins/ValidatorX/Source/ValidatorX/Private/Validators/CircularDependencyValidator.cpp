@@ -12,6 +12,7 @@
 #include "EdGraphSchema_K2.h"
 #include "Misc/DataValidation.h"
 #include "BlueprintEditor.h"
+#include "Library/BlueprintCallGraph.h"
 
 UEdGraph* UCircularDependencyValidator::FindGraphByName(UBlueprint* Blueprint, const FName& GraphName)
 {
@@ -63,7 +64,7 @@ bool UCircularDependencyValidator::CanValidateAsset_Implementation(const FAssetD
 	return InAsset && InAsset->IsA<UBlueprint>();
 }
 
-EDataValidationResult UCircularDependencyValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+EDataValidationResult UCircularDependencyValidator::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
 	bIsError = false;
 
@@ -80,106 +81,52 @@ EDataValidationResult UCircularDependencyValidator::ValidateLoadedAsset_Implemen
 
 bool UCircularDependencyValidator::HasCircularDependency(UBlueprint* Blueprint, FDataValidationContext& Context)
 {
-	TMap<FName, TArray<FName>> CallGraph;
-
-	auto CollectGraphCalls = [&] (const TArray<UEdGraph*>& Graphs)
-		{
-			for(UEdGraph* Graph : Graphs)
-			{
-				if(!Graph) continue;
-
-				FName ThisGraphName = Graph->GetFName();
-				TArray<FName>& Called = CallGraph.FindOrAdd(ThisGraphName);
-
-				for(UEdGraphNode* Node : Graph->Nodes)
-				{
-					if(UK2Node_CallFunction* CallFunction = Cast<UK2Node_CallFunction>(Node))
-					{
-						Called.Add(CallFunction->FunctionReference.GetMemberName());
-					}
-					else if(UK2Node_MacroInstance* Macro = Cast<UK2Node_MacroInstance>(Node))
-					{
-						Called.Add(Macro->GetMacroGraph()->GetFName());
-					}
-				}
-			}
-		};
+	TArray<TSharedRef<const FBlueprintCallCluster>> Clusters;
+	if(!FBlueprintCallGraph::Get().GetRecursiveClusters(Blueprint, Clusters))
+	{
+		bIsResultPartial = true;
+		Context.AddMessage(EMessageSeverity::Info, FText::FromString(
+			TEXT("Blueprints in a dependency cycle with this one are still loading, circular calls through them are not reported yet. Validate again once they are loaded.")));
+	}
 
-	CollectGraphCalls(Blueprint->FunctionGraphs);
-	CollectGraphCalls(Blueprint->MacroGraphs);
+	const FTopLevelAssetPath BlueprintPath(Blueprint);
 
-	for(const auto& Pair : CallGraph)
+	for(const TSharedRef<const FBlueprintCallCluster>& Cluster : Clusters)
 	{
-		const FName& Start = Pair.Key;
-		TSet<FName> Visited;
-		TSet<FName> Stack;
-		TArray<FName> CyclePath;
+		FString CycleStr = FString::JoinBy(Cluster->Members, TEXT(" - "), [] (const FBlueprintCallable& Callable) { return Callable.ToString(); });
+		const FText MessageText = FText::FromString(FString::Printf(TEXT("Circular call detected: %s"), *CycleStr));
 
-		if(DetectCycle(Start, CallGraph, Visited, Stack, CyclePath))
-		{
-			FString CycleStr = FString::JoinBy(CyclePath, TEXT(" - "), [] (const FName& Name) { return Name.ToString(); });
-			const FText MessageText = FText::FromString(FString::Printf(TEXT("Circular call detected: %s"), *CycleStr));
+		TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Error, MessageText);
 
-			TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Error, MessageText);
-			if(UEdGraph* TargetGraph = FindGraphByName(Blueprint, CyclePath[0]))
-			{
-				Message->AddToken(FActionToken::Create(
-					FText::FromString("Jump to graph"),
-					FText::FromString("Opens the first function or macro involved in the circular call"),
-					FSimpleDelegate::CreateLambda([Blueprint, TargetGraph] ()
+		// Members are sorted by name, jump to the first one that lives in this Blueprint
+		const FBlueprintCallable* LocalMember = Cluster->Members.FindByPredicate([&BlueprintPath] (const FBlueprintCallable& Callable) { return Callable.Blueprint == BlueprintPath; });
+		if(UEdGraph* TargetGraph = LocalMember ? FindGraphByName(Blueprint, LocalMember->Graph) : nullptr)
+		{
+			Message->AddToken(FActionToken::Create(
+				FText::FromString("Jump to graph"),
+				FText::FromString("Opens the first function or macro involved in the circular call"),
+				FSimpleDelegate::CreateLambda([Blueprint, TargetGraph] ()
+					{
+						if(UAssetEditorSubsystem* Subsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
 						{
-							if(UAssetEditorSubsystem* Subsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+							Subsystem->OpenEditorForAsset(Blueprint);
+							if(IAssetEditorInstance* EditorInstance = Subsystem->FindEditorForAsset(Blueprint, false))
 							{
-								Subsystem->OpenEditorForAsset(Blueprint);
-								if(IAssetEditorInstance* EditorInstance = Subsystem->FindEditorForAsset(Blueprint, false))
+								if(IBlueprintEditor* BPEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
 								{
-									if(IBlueprintEditor* BPEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
-									{
-										BPEditor->OpenGraphAndBringToFront(TargetGraph, true);
-									}
+									BPEditor->OpenGraphAndBringToFront(TargetGraph, true);
 								}
 							}
-						})
-				));
-			}
-
-			return true;
+						}
+					})
+			));
 		}
 	}
 
-	return false;
+	return Clusters.Num() > 0;
 }
 
-bool UCircularDependencyValidator::DetectCycle(const FName& StartName, TMap<FName, TArray<FName>>& GraphMap, TSet<FName>& Visited, TSet<FName>& Stack, TArray<FName>& OutCyclePath)
+void UCircularDependencyValidator::GetCacheDependencies(const FAssetData& InAssetData, TArray<FName>& OutPackageNames) const
 {
-	if(Stack.Contains(StartName))
-	{
-		OutCyclePath.Add(StartName);
-		return true;
-	}
-
-	if(Visited.Contains(StartName))
-	{
-		return false;
-	}
-
-	Visited.Add(StartName);
-	Stack.Add(StartName);
-
-	if(TArray<FName>* CalledList = GraphMap.Find(StartName))
-	{
-		for(const FName& Next : *CalledList)
-		{
-			if(DetectCycle(Next, GraphMap, Visited, Stack, OutCyclePath))
-			{
-				OutCyclePath.Insert(StartName, 0);
-				return true;
-			}
-		}
-	}
-
-	Stack.Remove(StartName);
-	return false;
+	FBlueprintCallGraph::Get().GetDependencyCyclePackages(InAssetData.PackageName, OutPackageNames);
 }
-
-
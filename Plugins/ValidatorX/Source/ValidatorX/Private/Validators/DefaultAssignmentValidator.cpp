@@ -5,6 +5,9 @@
 #include "K2Node_VariableSet.h"
 #include "Misc/DataValidation.h"
 #include "BlueprintEditor.h"
+#include "Library/BlueprintGraphIndex.h"
+#include "Library/BlueprintClassHierarchy.h"
+#include "Library/ClassDefaultTextCache.h"
 
 UDefaultAssignmentValidator::UDefaultAssignmentValidator()
 {
@@ -22,44 +25,44 @@ bool UDefaultAssignmentValidator::IsEnabled() const
 	return CDO->bIsEnabled && !bIsConfigDisabled;
 }
 
-EDataValidationResult UDefaultAssignmentValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+void UDefaultAssignmentValidator::GetCacheDependencies(const FAssetData& InAssetData, TArray<FName>& OutPackageNames) const
+{
+	TArray<FTopLevelAssetPath> AncestorClassPaths;
+	FBlueprintClassHierarchy::Get().GetAncestorClassPaths(FBlueprintClassHierarchy::GetGeneratedClassPath(InAssetData), AncestorClassPaths);
+
+	for(const FTopLevelAssetPath& AncestorClassPath : AncestorClassPaths)
+	{
+		OutPackageNames.Add(AncestorClassPath.GetPackageName());
+	}
+}
+
+EDataValidationResult UDefaultAssignmentValidator::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
+		const TSharedRef<const FBlueprintGraphIndex> GraphIndex = FBlueprintGraphIndexCache::Get().FindOrBuild(Blueprint);
 
-		for(UEdGraph* Graph : AllGraphs)
+		for(const auto& Pair : GraphIndex->VariableSets)
 		{
-			for(UEdGraphNode* Node : Graph->Nodes)
+			const FName VarName = Pair.Key;
+			const FProperty* Property = FindFProperty<FProperty>(Blueprint->GeneratedClass, VarName);
+			if(!Property)
 			{
-				if(UK2Node_VariableSet* VarSetNode = Cast<UK2Node_VariableSet>(Node))
-				{
-					const FName VarName = VarSetNode->GetVarName();
-					const FProperty* Property = FindFProperty<FProperty>(Blueprint->GeneratedClass, VarName);
-					if(!Property)
-					{
-						continue;
-					}
+				continue;
+			}
 
+			for(const FBlueprintGraphNodeRef& NodeRef : Pair.Value)
+			{
+				UEdGraph* Graph = NodeRef.Graph;
+				if(UK2Node_VariableSet* VarSetNode = Cast<UK2Node_VariableSet>(NodeRef.Node))
+				{
 					if(UEdGraphPin* ValuePin = VarSetNode->FindPin(VarName))
 					{
 						if(!ValuePin->HasAnyConnections())
 						{
-							const FString PinDefaultValue = ValuePin->DefaultValue;
-
-							FString PropertyDefaultValue;
-
-							if(const auto DefaultObjectPtr = Blueprint->GeneratedClass->GetDefaultObject(false))
-							{
-								FString Temp;
-								Property->ExportText_InContainer(0, Temp, DefaultObjectPtr, DefaultObjectPtr, nullptr, PPF_None);
-								PropertyDefaultValue = Temp;
-							}
-
-							if(PinDefaultValue == PropertyDefaultValue)
+							if(ValuePin->DefaultValue == FClassDefaultTextCache::Get().FindOrExport(Blueprint->GeneratedClass, Property))
 							{
 								const FText MessageText = FText::Format(
 									INVTEXT("Redundant assignment detected: variable '{0}' in Blueprint '{1}' is assigned its default value."),
@@ -2,9 +2,10 @@
 
 
 #include "Validators/EmptyBranchValidator.h"
-#include "K2Node_IfThenElse.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
 #include "Misc/DataValidation.h"
-#include "BlueprintEditorModule.h"
+#include "Library/BlueprintGraphSnapshot.h"
 
 UEmptyBranchValidator::UEmptyBranchValidator()
 {
@@ -16,67 +17,37 @@ bool UEmptyBranchValidator::CanValidateAsset_Implementation(const FAssetData& In
 	return InAsset && InAsset->IsA<UBlueprint>();
 }
 
-EDataValidationResult UEmptyBranchValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+void UEmptyBranchValidator::AnalyzeSnapshot(const FBlueprintGraphSnapshot& Snapshot, TArray<FBlueprintSnapshotFinding>& OutFindings) const
 {
-	bIsError = false;
-
-	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
+	for(int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
 	{
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
+		const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[GraphIndex];
 
-		for(UEdGraph* Graph : AllGraphs)
+		for(int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
 		{
-			for(UEdGraphNode* Node : Graph->Nodes)
-			{
-				if(UK2Node_IfThenElse* Branch = Cast<UK2Node_IfThenElse>(Node))
-				{
-					const UEdGraphPin* ThenPin = Branch->GetThenPin();
-					const UEdGraphPin* ElsePin = Branch->GetElsePin();
-
-					const bool bThenUnconnected = ThenPin && ThenPin->LinkedTo.Num() == 0;
-					const bool bElseUnconnected = ElsePin && ElsePin->LinkedTo.Num() == 0;
+			const FBlueprintSnapshotNode& Node = Graph.Nodes[NodeIndex];
+			if(Node.Kind != EBlueprintSnapshotNodeKind::Branch) continue;
 
-					// Only if BOTH branches are not connected
-					if(bThenUnconnected && bElseUnconnected)
-					{
-						const FText MessageText = FText::Format(
-							INVTEXT("Branch node in graph '{0}' has both 'Then' and 'Else' execution pins unconnected."),
-							FText::FromString(Graph->GetName())
-						);
+			const FBlueprintSnapshotPin* ThenPin = Graph.FindPin(Node, UEdGraphSchema_K2::PN_Then);
+			const FBlueprintSnapshotPin* ElsePin = Graph.FindPin(Node, UEdGraphSchema_K2::PN_Else);
 
-						TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
-						Message->AddToken(FActionToken::Create(FText::FromString("Jump to Branch"), FText::GetEmpty(),
-							FSimpleDelegate::CreateLambda([=]
-								{
-									if(Blueprint && Graph)
-									{
-										if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
-										{
-											AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-											if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-											{
-												if(IBlueprintEditor* BlueprintEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
-												{
-													if(TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
-													{
-														GraphEditor->JumpToNode(Branch, false);
-													}
-												}
-											}
-										}
-									}
-								}))
-						);
+			const bool bThenUnconnected = ThenPin && ThenPin->LinkedTo.Num() == 0;
+			const bool bElseUnconnected = ElsePin && ElsePin->LinkedTo.Num() == 0;
 
-						bIsError = true;
-					}
-				}
+			// Only if BOTH branches are not connected
+			if(bThenUnconnected && bElseUnconnected)
+			{
+				FBlueprintSnapshotFinding& Finding = OutFindings.AddDefaulted_GetRef();
+				Finding.Text = FText::Format(
+					INVTEXT("Branch node in graph '{0}' has both 'Then' and 'Else' execution pins unconnected."),
+					FText::FromName(Graph.Name)
+				);
+				Finding.JumpLabel = FText::FromString("Jump to Branch");
+				Finding.Graph = GraphIndex;
+				Finding.Node = NodeIndex;
 			}
 		}
 	}
-
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
 }
 
 bool UEmptyBranchValidator::IsEnabled() const
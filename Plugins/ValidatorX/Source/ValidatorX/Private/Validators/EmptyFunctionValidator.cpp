@@ -7,6 +7,7 @@
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "BlueprintEditor.h"
 #include "Misc/DataValidation.h"
+#include "Library/BlueprintGraphIndex.h"
 
 UEmptyFunctionValidator::UEmptyFunctionValidator()
 {
@@ -24,30 +25,21 @@ bool UEmptyFunctionValidator::IsEnabled() const
 	return CDO->bIsEnabled && !bIsConfigDisabled;
 }
 
-EDataValidationResult UEmptyFunctionValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+EDataValidationResult UEmptyFunctionValidator::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
 	bIsError = false;
 
 	if (UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
+		const TSharedRef<const FBlueprintGraphIndex> GraphIndex = FBlueprintGraphIndexCache::Get().FindOrBuild(Blueprint);
+
 		for (UEdGraph* FunctionGraph : Blueprint->FunctionGraphs)
 		{
 			if(!FunctionGraph) continue;
 
 			if(FunctionGraph->GetFName() == UEdGraphSchema_K2::FN_UserConstructionScript) continue;
 
-			int32 UsefulNodeCount = 0;
-			for (UEdGraphNode* Node : FunctionGraph->Nodes)
-			{
-				if(!Node) continue;
-
-				if (Node->IsA<UK2Node_FunctionEntry>() || Node->IsA<UK2Node_FunctionResult>())
-				{
-					continue;
-				}
-
-				UsefulNodeCount++;
-			}
+			const int32 UsefulNodeCount = GraphIndex->GetCodeNodeCount(FunctionGraph);
 
 			if (UsefulNodeCount == 0)
 			{
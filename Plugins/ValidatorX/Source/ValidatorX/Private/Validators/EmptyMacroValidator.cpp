@@ -8,6 +8,7 @@
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "BlueprintEditor.h"
 #include "Misc/DataValidation.h"
+#include "Library/BlueprintGraphIndex.h"
 
 UEmptyMacroValidator::UEmptyMacroValidator()
 {
@@ -25,28 +26,19 @@ bool UEmptyMacroValidator::IsEnabled() const
 	return CDO->bIsEnabled && !bIsConfigDisabled;
 }
 
-EDataValidationResult UEmptyMacroValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+EDataValidationResult UEmptyMacroValidator::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
+		const TSharedRef<const FBlueprintGraphIndex> GraphIndex = FBlueprintGraphIndexCache::Get().FindOrBuild(Blueprint);
+
 		for(UEdGraph* MacroGraph : Blueprint->MacroGraphs)
 		{
 			if(!MacroGraph) continue;
 
-			int32 UsefulNodeCount = 0;
-			for(UEdGraphNode* Node : MacroGraph->Nodes)
-			{
-				if(!Node) continue;
-
-				if(Node->IsA<UK2Node_Tunnel>())
-				{
-					continue;
-				}
-
-				UsefulNodeCount++;
-			}
+			const int32 UsefulNodeCount = GraphIndex->GetCodeNodeCount(MacroGraph);
 
 			if(UsefulNodeCount == 0)
 			{
@@ -2,12 +2,11 @@
 
 
 #include "Validators/GlobalVariableNeverUsedValidator.h"
-#include "K2Node_VariableSet.h"
-#include "K2Node_VariableGet.h"
 #include "Misc/DataValidation.h"
 #include "BlueprintEditor.h"
 #include "SMyBlueprint.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "Library/BlueprintGraphIndex.h"
 
 UGlobalVariableNeverUsedValidator::UGlobalVariableNeverUsedValidator()
 {
@@ -25,7 +24,7 @@ bool UGlobalVariableNeverUsedValidator::CanValidateAsset_Implementation(const FA
 	return InAsset && InAsset->IsA<UBlueprint>();
 }
 
-EDataValidationResult UGlobalVariableNeverUsedValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+EDataValidationResult UGlobalVariableNeverUsedValidator::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
 	bIsError = false;
 
@@ -33,8 +32,7 @@ EDataValidationResult UGlobalVariableNeverUsedValidator::ValidateLoadedAsset_Imp
 	{
 		const TArray<FBPVariableDescription>& Variables = Blueprint->NewVariables;
 
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
+		const TSharedRef<const FBlueprintGraphIndex> GraphIndex = FBlueprintGraphIndexCache::Get().FindOrBuild(Blueprint);
 
 		for(const FBPVariableDescription& VarDesc : Variables)
 		{
@@ -55,32 +53,7 @@ EDataValidationResult UGlobalVariableNeverUsedValidator::ValidateLoadedAsset_Imp
 			// Use case 2: Explicitly used in graphs
 			if(!bUsed)
 			{
-				for(UEdGraph* Graph : AllGraphs)
-				{
-					if(!Graph) continue;
-
-					for(UEdGraphNode* Node : Graph->Nodes)
-					{
-						if(const UK2Node_VariableGet* VarGet = Cast<UK2Node_VariableGet>(Node))
-						{
-							if(VarGet->GetVarName() == VarDesc.VarName)
-							{
-								bUsed = true;
-								break;
-							}
-						}
-						else if(const UK2Node_VariableSet* VarSet = Cast<UK2Node_VariableSet>(Node))
-						{
-							if(VarSet->GetVarName() == VarDesc.VarName)
-							{
-								bUsed = true;
-								break;
-							}
-						}
-					}
-
-					if(bUsed) break;
-				}
+				bUsed = GraphIndex->IsVariableUsed(VarDesc.VarName);
 			}
 
 			// Unused variable
@@ -0,0 +1,303 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Validators/HardReferenceBudgetValidator.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_DynamicCast.h"
+#include "Misc/DataValidation.h"
+#include "Misc/PackageName.h"
+
+namespace HardReferenceBudget
+{
+	/** Direct references listed under a Blueprint over budget. */
+	constexpr int32 MaxContributors = 5;
+
+	/** Native packages are always resident, they cost nothing to reference. */
+	static bool IsNativePackage(FName PackageName)
+	{
+		return FPackageName::IsScriptPackage(PackageName.ToString());
+	}
+
+	static void GetHardDependencies(const IAssetRegistry& AssetRegistry, FName PackageName, TArray<FName>& OutDependencies)
+	{
+		OutDependencies.Reset();
+		AssetRegistry.GetDependencies(PackageName, OutDependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+	}
+
+	/**
+	 * Walks the hard package dependencies of a package once. The closure of each direct reference is walked in
+	 * turn and only adds the packages the earlier ones did not reach, so every package is tagged with the first
+	 * direct reference that pulls it in.
+	 */
+	static void GatherClosure(const IAssetRegistry& AssetRegistry, FName PackageName, FHardReferenceClosure& OutClosure)
+	{
+		OutClosure.PackageName = PackageName;
+
+		TArray<FName> Dependencies;
+		GetHardDependencies(AssetRegistry, PackageName, Dependencies);
+
+		for(const FName Dependency : Dependencies)
+		{
+			if(Dependency != PackageName && !IsNativePackage(Dependency))
+			{
+				OutClosure.DirectReferences.AddUnique(Dependency);
+			}
+		}
+
+		TArray<FName> Stack;
+
+		for(int32 ReferenceIndex = 0; ReferenceIndex < OutClosure.DirectReferences.Num(); ++ReferenceIndex)
+		{
+			const FName DirectReference = OutClosure.DirectReferences[ReferenceIndex];
+			if(OutClosure.Packages.Contains(DirectReference)) continue;
+
+			OutClosure.Packages.Add(DirectReference, ReferenceIndex);
+			Stack.Add(DirectReference);
+
+			while(Stack.Num() > 0)
+			{
+				GetHardDependencies(AssetRegistry, Stack.Pop(EAllowShrinking::No), Dependencies);
+
+				for(const FName Dependency : Dependencies)
+				{
+					if(Dependency == PackageName || IsNativePackage(Dependency) || OutClosure.Packages.Contains(Dependency)) continue;
+
+					OutClosure.Packages.Add(Dependency, ReferenceIndex);
+					Stack.Add(Dependency);
+				}
+			}
+		}
+	}
+
+	static int64 GetPackageSize(const IAssetRegistry& AssetRegistry, FName PackageName)
+	{
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+		return PackageData.IsSet() ? FMath::Max<int64>(PackageData->DiskSize, 0) : 0;
+	}
+
+	static bool IsHardObjectType(const FEdGraphPinType& PinType)
+	{
+		return PinType.PinCategory == UEdGraphSchema_K2::PC_Object
+			|| PinType.PinCategory == UEdGraphSchema_K2::PC_Class
+			|| PinType.PinCategory == UEdGraphSchema_K2::PC_Interface;
+	}
+
+	/** Records the first suggestion for the package of the object, earlier sources are the more actionable ones. */
+	static void AddSuggestion(const UObject* Object, FString&& Suggestion, TMap<FName, FString>& OutSuggestions)
+	{
+		if(!Object) return;
+
+		const FName PackageName = Object->GetOutermost()->GetFName();
+		if(!IsNativePackage(PackageName) && !OutSuggestions.Contains(PackageName))
+		{
+			OutSuggestions.Add(PackageName, MoveTemp(Suggestion));
+		}
+	}
+
+	/** Maps the referenced packages to what in the Blueprint references them and how to make that reference soft. */
+	static void GatherSuggestions(UBlueprint* Blueprint, TMap<FName, FString>& OutSuggestions)
+	{
+		AddSuggestion(Blueprint->ParentClass, FString::Printf(TEXT("Parent class '%s', a Blueprint parent is always loaded: keep its own references light."),
+			*GetNameSafe(Blueprint->ParentClass)), OutSuggestions);
+
+		for(const FBPVariableDescription& Variable : Blueprint->NewVariables)
+		{
+			if(IsHardObjectType(Variable.VarType))
+			{
+				AddSuggestion(Variable.VarType.PinSubCategoryObject.Get(), FString::Printf(TEXT("Variable '%s': make it a soft %s reference."),
+					*Variable.VarName.ToString(), Variable.VarType.PinCategory == UEdGraphSchema_K2::PC_Class ? TEXT("class") : TEXT("object")), OutSuggestions);
+			}
+		}
+
+		TArray<UEdGraph*> Graphs;
+		Blueprint->GetAllGraphs(Graphs);
+
+		// Casts are named before pins, their output pins carry the same type
+		TMap<FName, FString> PinSuggestions;
+
+		for(const UEdGraph* Graph : Graphs)
+		{
+			if(!Graph) continue;
+
+			for(const UEdGraphNode* Node : Graph->Nodes)
+			{
+				if(!Node) continue;
+
+				if(const UK2Node_DynamicCast* CastNode = Cast<UK2Node_DynamicCast>(Node))
+				{
+					AddSuggestion(CastNode->TargetType, FString::Printf(TEXT("Cast to '%s' in graph '%s': cast to a native base class or call through an interface."),
+						*GetNameSafe(CastNode->TargetType), *Graph->GetName()), OutSuggestions);
+				}
+
+				const FString NodeTitle = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
+
+				for(const UEdGraphPin* Pin : Node->Pins)
+				{
+					if(!Pin) continue;
+
+					AddSuggestion(Pin->DefaultObject, FString::Printf(TEXT("Default of pin '%s' on '%s' in graph '%s': pass a soft reference and load it when needed."),
+						*Pin->PinName.ToString(), *NodeTitle, *Graph->GetName()), PinSuggestions);
+
+					if(IsHardObjectType(Pin->PinType))
+					{
+						AddSuggestion(Pin->PinType.PinSubCategoryObject.Get(), FString::Printf(TEXT("Pin '%s' on '%s' in graph '%s': use a soft reference type."),
+							*Pin->PinName.ToString(), *NodeTitle, *Graph->GetName()), PinSuggestions);
+					}
+				}
+			}
+		}
+
+		for(TPair<FName, FString>& Pair : PinSuggestions)
+		{
+			if(!OutSuggestions.Contains(Pair.Key))
+			{
+				OutSuggestions.Add(Pair.Key, MoveTemp(Pair.Value));
+			}
+		}
+	}
+
+	struct FContributor
+	{
+		FName PackageName;
+		int64 Size;
+		int32 NumPackages;
+	};
+}
+
+UHardReferenceBudgetValidator::UHardReferenceBudgetValidator()
+{
+	SetValidationEnabled(true);
+}
+
+bool UHardReferenceBudgetValidator::CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const
+{
+	return InAsset && InAsset->IsA<UBlueprint>();
+}
+
+bool UHardReferenceBudgetValidator::IsEnabled() const
+{
+	static const UHardReferenceBudgetValidator* CDO = GetDefault<UHardReferenceBudgetValidator>();
+	return CDO->bIsEnabled && !bIsConfigDisabled;
+}
+
+void UHardReferenceBudgetValidator::GetAssetPrefilter(FValidatorAssetPrefilter& OutPrefilter) const
+{
+	Super::GetAssetPrefilter(OutPrefilter);
+	OutPrefilter.bRequiresGraphData = false;
+}
+
+void UHardReferenceBudgetValidator::GetCacheDependencies(const FAssetData& InAssetData, TArray<FName>& OutPackageNames) const
+{
+	const IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if(!AssetRegistry) return;
+
+	// A cache miss validates the package right after its key is computed, the validation takes the closure over
+	const TSharedRef<FHardReferenceClosure> Closure = MakeShared<FHardReferenceClosure>();
+	HardReferenceBudget::GatherClosure(*AssetRegistry, InAssetData.PackageName, *Closure);
+
+	OutPackageNames.Reserve(OutPackageNames.Num() + Closure->Packages.Num());
+	for(const TPair<FName, int32>& Pair : Closure->Packages)
+	{
+		OutPackageNames.Add(Pair.Key);
+	}
+
+	LastClosure = Closure;
+}
+
+EDataValidationResult UHardReferenceBudgetValidator::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+{
+	using namespace HardReferenceBudget;
+
+	bIsError = false;
+
+	UBlueprint* Blueprint = Cast<UBlueprint>(InAsset);
+	const IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if(!Blueprint || !AssetRegistry)
+	{
+		return EDataValidationResult::Valid;
+	}
+
+	const int64 SizeBudget = static_cast<int64>(SizeBudgetMB * 1024.0 * 1024.0);
+	const FName PackageName = Blueprint->GetOutermost()->GetFName();
+
+	TSharedPtr<const FHardReferenceClosure> Closure = MoveTemp(LastClosure);
+	if(!Closure.IsValid() || Closure->PackageName != PackageName)
+	{
+		const TSharedRef<FHardReferenceClosure> NewClosure = MakeShared<FHardReferenceClosure>();
+		GatherClosure(*AssetRegistry, PackageName, *NewClosure);
+		Closure = NewClosure;
+	}
+
+	// Each package counts toward the direct reference it was first reached through
+	TArray<FContributor> Contributors;
+	Contributors.Reserve(Closure->DirectReferences.Num());
+	for(const FName DirectReference : Closure->DirectReferences)
+	{
+		Contributors.Add(FContributor{ DirectReference, 0, 0 });
+	}
+
+	int64 ClosureSize = 0;
+	for(const TPair<FName, int32>& Pair : Closure->Packages)
+	{
+		const int64 PackageSize = GetPackageSize(*AssetRegistry, Pair.Key);
+		ClosureSize += PackageSize;
+
+		FContributor& Contributor = Contributors[Pair.Value];
+		Contributor.Size += PackageSize;
+		++Contributor.NumPackages;
+	}
+
+	const int32 NumPackages = Closure->Packages.Num();
+	const bool bOverSize = SizeBudget > 0 && ClosureSize > SizeBudget;
+	const bool bOverCount = PackageBudget > 0 && NumPackages > PackageBudget;
+	if(!bOverSize && !bOverCount)
+	{
+		return EDataValidationResult::Valid;
+	}
+
+	bIsError = true;
+
+	const FText Budget = bOverSize && bOverCount
+		? FText::Format(INVTEXT("the budgets of {0} packages and {1}"), FText::AsNumber(PackageBudget), FText::AsMemory(SizeBudget))
+		: bOverCount
+			? FText::Format(INVTEXT("the budget of {0} packages"), FText::AsNumber(PackageBudget))
+			: FText::Format(INVTEXT("the budget of {0}"), FText::AsMemory(SizeBudget));
+
+	Context.AddMessage(EMessageSeverity::Warning, FText::Format(
+		INVTEXT("Blueprint '{0}' loads {1} packages ({2}) through hard references, over {3}."),
+		FText::FromString(Blueprint->GetName()),
+		FText::AsNumber(NumPackages),
+		FText::AsMemory(ClosureSize),
+		Budget
+	));
+
+	// Direct references reached entirely through earlier ones pull in nothing of their own
+	Contributors.RemoveAll([] (const FContributor& Contributor) { return Contributor.NumPackages == 0; });
+
+	Contributors.Sort([] (const FContributor& A, const FContributor& B)
+		{
+			return A.Size != B.Size ? A.Size > B.Size : A.NumPackages > B.NumPackages;
+		});
+
+	TMap<FName, FString> Suggestions;
+	GatherSuggestions(Blueprint, Suggestions);
+
+	for(int32 Index = 0; Index < FMath::Min(Contributors.Num(), MaxContributors); ++Index)
+	{
+		const FContributor& Contributor = Contributors[Index];
+		const FString* Suggestion = Suggestions.Find(Contributor.PackageName);
+
+		Context.AddMessage(EMessageSeverity::Info, FText::Format(
+			INVTEXT("'{0}' is the first direct reference to pull in {1} across {2} packages. {3}"),
+			FText::FromName(Contributor.PackageName),
+			FText::AsMemory(Contributor.Size),
+			FText::AsNumber(Contributor.NumPackages),
+			Suggestion ? FText::FromString(*Suggestion)
+				: INVTEXT("Referenced by a component, default value or asset the graphs do not show: hold it in a soft reference and load it when needed.")
+		));
+	}
+
+	return EDataValidationResult::Invalid;
+}
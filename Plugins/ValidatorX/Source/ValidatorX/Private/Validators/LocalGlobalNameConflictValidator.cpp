@@ -7,6 +7,7 @@
 #include "BlueprintEditor.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "SMyBlueprint.h"
+#include "Library/BlueprintGraphIndex.h"
 
 ULocalGlobalNameConflictValidator::ULocalGlobalNameConflictValidator()
 {
@@ -25,32 +26,17 @@ bool ULocalGlobalNameConflictValidator::IsEnabled() const
 }
 
 
-EDataValidationResult ULocalGlobalNameConflictValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+EDataValidationResult ULocalGlobalNameConflictValidator::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TArray<UEdGraph*> AllGraphs = Blueprint->UbergraphPages;
-		AllGraphs.Append(Blueprint->FunctionGraphs);
-		AllGraphs.Append(Blueprint->MacroGraphs);
-		AllGraphs.Append(Blueprint->DelegateSignatureGraphs);
-		AllGraphs.Append(Blueprint->IntermediateGeneratedGraphs);
-		Blueprint->GetAllGraphs(AllGraphs);
-
-		for(UEdGraph* Graph : AllGraphs)
-		{
-			UK2Node_FunctionEntry* EntryNode = nullptr;
-
-			for(UEdGraphNode* Node : Graph->Nodes)
-			{
-				if(UK2Node_FunctionEntry* Entry = Cast<UK2Node_FunctionEntry>(Node))
-				{
-					EntryNode = Entry;
-					break;
-				}
-			}
+		const TSharedRef<const FBlueprintGraphIndex> GraphIndex = FBlueprintGraphIndexCache::Get().FindOrBuild(Blueprint);
 
+		for(UEdGraph* Graph : GraphIndex->Graphs)
+		{
+			UK2Node_FunctionEntry* EntryNode = GraphIndex->FunctionEntries.FindRef(Graph);
 			if(!EntryNode)
 			{
 				continue;
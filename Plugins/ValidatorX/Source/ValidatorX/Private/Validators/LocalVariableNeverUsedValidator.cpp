@@ -18,6 +18,7 @@
 #include "BlueprintEditor.h"
 #include "SMyBlueprint.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "Library/BlueprintGraphIndex.h"
 
 
 ULocalVariableNeverUsedValidator::ULocalVariableNeverUsedValidator()
@@ -36,54 +37,23 @@ bool ULocalVariableNeverUsedValidator::IsEnabled() const
     return CDO->bIsEnabled && !bIsConfigDisabled;
 }
 
-EDataValidationResult ULocalVariableNeverUsedValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+EDataValidationResult ULocalVariableNeverUsedValidator::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
     bIsError = false;
   
     if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
     {
-        const auto AllGraphs = Blueprint->FunctionGraphs;
+        const TSharedRef<const FBlueprintGraphIndex> GraphIndex = FBlueprintGraphIndexCache::Get().FindOrBuild(Blueprint);
     
-        for(UEdGraph* Graph : AllGraphs)
+        for(UEdGraph* Graph : Blueprint->FunctionGraphs)
         {
-            UK2Node_FunctionEntry* EntryNode = nullptr;
-
-            for(UEdGraphNode* Node : Graph->Nodes)
-            {
-                if(UK2Node_FunctionEntry* Entry = Cast<UK2Node_FunctionEntry>(Node))
-                {
-                    EntryNode = Entry;
-                    break;
-                }
-            }
+            UK2Node_FunctionEntry* EntryNode = GraphIndex->FunctionEntries.FindRef(Graph);
    
              if(!EntryNode)  continue;
      
              for(const FBPVariableDescription& LocalVar : EntryNode->LocalVariables)
              {
-                 bool bUsed = false;
-
-                 for(UEdGraphNode* Node : Graph->Nodes)
-                 {
-                     if(const UK2Node_VariableGet* VarGet = Cast<UK2Node_VariableGet>(Node))
-                     {
-                         if(VarGet->GetVarName() == LocalVar.VarName)
-                         {
-                             
-                             bUsed = true;
-                             break;
-                         }
-                     }
-                     else if(const UK2Node_VariableSet* VarSet = Cast<UK2Node_VariableSet>(Node))
-                     {
-                         if(VarSet->GetVarName() == LocalVar.VarName)
-                         {
-                             
-                             bUsed = true;
-                             break;
-                         }
-                     }
-                 }
+                 const bool bUsed = GraphIndex->IsVariableUsedInGraph(LocalVar.VarName, Graph);
      
                  if(!bUsed)
                  {
@@ -2,12 +2,9 @@
 
 
 #include "Validators/LongFunctionValidator.h"
-#include "K2Node_FunctionEntry.h"
-#include "K2Node_FunctionResult.h"
-#include "Subsystems/AssetEditorSubsystem.h"
-#include "BlueprintEditorModule.h"
+#include "Engine/Blueprint.h"
 #include "Misc/DataValidation.h"
-#include "Library/BPUtilsNodeFunctionLibrary.h"
+#include "Library/BlueprintGraphSnapshot.h"
 
 ULongFunctionValidator::ULongFunctionValidator()
 {
@@ -25,73 +22,31 @@ bool ULongFunctionValidator::IsEnabled() const
 	return CDO->bIsEnabled && !bIsConfigDisabled;
 }
 
-EDataValidationResult ULongFunctionValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+void ULongFunctionValidator::AnalyzeSnapshot(const FBlueprintGraphSnapshot& Snapshot, TArray<FBlueprintSnapshotFinding>& OutFindings) const
 {
 	constexpr int32 NodeLimit = 200;
-	bIsError = false;
 
-	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
+	for(int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
 	{
+		const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[GraphIndex];
 
-		TArray<UEdGraph*> AllGraphs = Blueprint->UbergraphPages;
-		AllGraphs.Append(Blueprint->FunctionGraphs);
-		AllGraphs.Append(Blueprint->MacroGraphs);
-		AllGraphs.Append(Blueprint->DelegateSignatureGraphs);
-		AllGraphs.Append(Blueprint->IntermediateGeneratedGraphs);
-
-		for(UEdGraph* Graph : AllGraphs)
-		{
-			if(!Graph) continue;
-
-			int32 NodeCount = 0;
-			for(UEdGraphNode* Node : Graph->Nodes)
-			{
-				if(Node && !Node->IsA<UK2Node_FunctionEntry>() && !Node->IsA<UK2Node_FunctionResult>())
-				{
-					NodeCount++;
-				}
-			}
-
+		// Only the graphs listed by the Blueprint itself, collapsed graphs are left out
+		if(Graph.Kind == EBlueprintSnapshotGraphKind::SubGraph) continue;
 
+		const int32 NodeCount = Graph.GetCodeNodeCount();
 
-			if(NodeCount > NodeLimit)
-			{
-				const FString GraphType = UBPUtilsNodeFunctionLibrary::GetGraphType(Blueprint, Graph);
-				const FText MessageText = FText::Format(
-					INVTEXT("'{0}' - '{1}' contains {2} nodes, which exceeds the recommended limit of {3}. Consider splitting it into smaller functions."),
-					FText::FromString(GraphType),
-					FText::FromString(Graph->GetName()),
-					FText::AsNumber(NodeCount),
-					FText::AsNumber(NodeLimit)
-				);
-				const FText JumpText = FText::Format(INVTEXT("Jump to '{0}' - {1}"), FText::FromString(Graph->GetName()), FText::FromString(GraphType));
-
-				TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
-				Message->AddToken(FActionToken::Create(
-					JumpText,
-					FText::FromString(""),
-					FSimpleDelegate::CreateLambda([=]
-						{
-							if(Blueprint && Graph)
-							{
-								if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
-								{
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-
-									if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-									{
-										if(IBlueprintEditor* BlueprintEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
-										{
-											BlueprintEditor->OpenGraphAndBringToFront(Graph, true);
-										}
-									}
-								}
-							}
-						})));
-				bIsError = true;
-			}
+		if(NodeCount > NodeLimit)
+		{
+			FBlueprintSnapshotFinding& Finding = OutFindings.AddDefaulted_GetRef();
+			Finding.Text = FText::Format(
+				INVTEXT("'{0}' - '{1}' contains {2} nodes, which exceeds the recommended limit of {3}. Consider splitting it into smaller functions."),
+				FText::FromString(Graph.TypeName),
+				FText::FromName(Graph.Name),
+				FText::AsNumber(NodeCount),
+				FText::AsNumber(NodeLimit)
+			);
+			Finding.JumpLabel = FText::Format(INVTEXT("Jump to '{0}' - {1}"), FText::FromName(Graph.Name), FText::FromString(Graph.TypeName));
+			Finding.Graph = GraphIndex;
 		}
 	}
-
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
 }
@@ -0,0 +1,229 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Validators/RepeatedPureEvaluationValidator.h"
+#include "Algo/AnyOf.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Misc/DataValidation.h"
+#include "Library/BlueprintGraphSnapshot.h"
+
+namespace RepeatedPureEvaluation
+{
+	/** Repeated cost from which a pure subgraph is worth caching, a plain pure call weighs 2. */
+	constexpr int32 MinRepeatedCost = 10;
+
+	/** Nodes that only read a value or reshape it, evaluating them again costs next to nothing. */
+	static const FName FreeNodeClasses[] =
+	{
+		TEXT("K2Node_VariableGet"),
+		TEXT("K2Node_Self"),
+		TEXT("K2Node_Literal"),
+		TEXT("K2Node_EnumLiteral"),
+		TEXT("K2Node_Knot"),
+		TEXT("K2Node_MakeStruct"),
+		TEXT("K2Node_BreakStruct"),
+		TEXT("K2Node_GetArrayItem")
+	};
+
+	static const TPair<FName, int32> NodeClassCosts[] =
+	{
+		{ TEXT("K2Node_DynamicCast"), 3 },
+		{ TEXT("K2Node_ClassDynamicCast"), 3 },
+		{ TEXT("K2Node_MakeArray"), 3 },
+		{ TEXT("K2Node_FormatText"), 5 }
+	};
+
+	static const TPair<FName, int32> FunctionCosts[] =
+	{
+		{ TEXT("Array_Find"), 10 },
+		{ TEXT("Array_Contains"), 10 },
+		{ TEXT("GetComponentByClass"), 10 },
+		{ TEXT("K2_GetComponentsByClass"), 20 },
+		{ TEXT("GetPlayerController"), 3 },
+		{ TEXT("GetPlayerPawn"), 3 },
+		{ TEXT("GetPlayerCharacter"), 3 },
+		{ TEXT("GetPlayerCameraManager"), 3 },
+		{ TEXT("GetGameMode"), 3 },
+		{ TEXT("GetGameState"), 3 },
+		{ TEXT("GetGameInstance"), 3 },
+		{ TEXT("Concat_StrStr"), 5 },
+		{ TEXT("JoinStringArray"), 5 }
+	};
+
+	/**
+	 * Name prefixes of the common UKismetMathLibrary functions: operators, conversions and small helpers. The
+	 * snapshot holds no owner class, so these weigh 1 instead of the 2 of other calls by name alone.
+	 */
+	static const TCHAR* const MathFunctionPrefixes[] =
+	{
+		TEXT("Add_"), TEXT("Subtract_"), TEXT("Multiply_"), TEXT("Divide_"), TEXT("Percent_"),
+		TEXT("Less_"), TEXT("LessEqual_"), TEXT("Greater_"), TEXT("GreaterEqual_"), TEXT("EqualEqual_"), TEXT("NotEqual_"),
+		TEXT("Not_"), TEXT("And_"), TEXT("Or_"), TEXT("Xor_"), TEXT("Boolean"), TEXT("Negate"),
+		TEXT("Conv_"), TEXT("Make"), TEXT("Break"), TEXT("Dot_"), TEXT("Cross_"), TEXT("Vector_"),
+		TEXT("Abs"), TEXT("Min"), TEXT("Max"), TEXT("FMin"), TEXT("FMax"), TEXT("Clamp"), TEXT("FClamp"), TEXT("Lerp"),
+		TEXT("Sqrt"), TEXT("Square"), TEXT("Sin"), TEXT("Cos"), TEXT("Tan"), TEXT("Round"), TEXT("Floor"), TEXT("FFloor"),
+		TEXT("Ceil"), TEXT("FCeil"), TEXT("FTrunc"), TEXT("VSize"), TEXT("Normal"), TEXT("SelectFloat"), TEXT("SelectVector")
+	};
+
+	/** @return Rough cost of evaluating the node once. */
+	static int32 GetNodeCost(const FBlueprintSnapshotNode& Node)
+	{
+		if(MakeArrayView(FreeNodeClasses).Contains(Node.ClassName)) return 0;
+
+		for(const TPair<FName, int32>& Entry : NodeClassCosts)
+		{
+			if(Node.ClassName == Entry.Key) return Entry.Value;
+		}
+
+		if(Node.Kind != EBlueprintSnapshotNodeKind::CallFunction) return 1;
+
+		for(const TPair<FName, int32>& Entry : FunctionCosts)
+		{
+			if(Node.MemberName == Entry.Key) return Entry.Value;
+		}
+
+		const FString FunctionString = Node.MemberName.ToString();
+		if(FunctionString.StartsWith(TEXT("BuildString_")) || (FunctionString.StartsWith(TEXT("Conv_")) && FunctionString.EndsWith(TEXT("ToString"))))
+		{
+			return 5;
+		}
+
+		const bool bIsMathFunction = !Node.bIsSelfMember &&
+			Algo::AnyOf(MathFunctionPrefixes, [&FunctionString] (const TCHAR* Prefix) { return FunctionString.StartsWith(Prefix, ESearchCase::CaseSensitive); });
+		return bIsMathFunction ? 1 : 2;
+	}
+
+	static FString GetNodeName(const FBlueprintSnapshotNode& Node)
+	{
+		if(!Node.MemberName.IsNone()) return Node.MemberName.ToString();
+
+		FString ClassName = Node.ClassName.ToString();
+		ClassName.RemoveFromStart(TEXT("K2Node_"));
+		return ClassName;
+	}
+
+	/**
+	 * Walks the data links of a pure node, each node once, so reroute cycles cannot loop.
+	 *
+	 * @param Direction         EGPD_Output to follow the readers of the node, EGPD_Input to follow what feeds it.
+	 * @param VisitLinkedNode   Called once per reached node, returns true to keep walking from it.
+	 */
+	template<typename FunctorType>
+	static void WalkDataLinks(const FBlueprintSnapshotGraph& Graph, int32 StartNode, EEdGraphPinDirection Direction, FunctorType&& VisitLinkedNode)
+	{
+		TArray<int32> Stack = { StartNode };
+		TSet<int32> Visited = { StartNode };
+
+		while(Stack.Num() > 0)
+		{
+			const int32 NodeIndex = Stack.Pop(EAllowShrinking::No);
+
+			for(const FBlueprintSnapshotPin& Pin : Graph.GetPins(Graph.Nodes[NodeIndex]))
+			{
+				if(Pin.Direction != Direction || Pin.Category == UEdGraphSchema_K2::PC_Exec) continue;
+
+				for(const int32 LinkedPin : Pin.LinkedTo)
+				{
+					const int32 LinkedNode = Graph.Pins[LinkedPin].Node;
+
+					bool bAlreadyVisited = false;
+					Visited.Add(LinkedNode, &bAlreadyVisited);
+
+					if(!bAlreadyVisited && VisitLinkedNode(LinkedNode))
+					{
+						Stack.Add(LinkedNode);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * @return True if one of the data outputs of the pure node is read by an impure node, directly or through
+	 * free nodes like reroutes and struct breaks.
+	 */
+	static bool FeedsExecNode(const FBlueprintSnapshotGraph& Graph, int32 PureNode)
+	{
+		bool bFeedsExecNode = false;
+		WalkDataLinks(Graph, PureNode, EGPD_Output, [&Graph, &bFeedsExecNode] (int32 LinkedNode)
+			{
+				const FBlueprintSnapshotNode& Node = Graph.Nodes[LinkedNode];
+				bFeedsExecNode = bFeedsExecNode || !Node.bIsPure;
+				return !bFeedsExecNode && GetNodeCost(Node) == 0;
+			});
+		return bFeedsExecNode;
+	}
+}
+
+URepeatedPureEvaluationValidator::URepeatedPureEvaluationValidator()
+{
+	SetValidationEnabled(true);
+}
+
+bool URepeatedPureEvaluationValidator::CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const
+{
+	return InAsset && InAsset->IsA<UBlueprint>();
+}
+
+bool URepeatedPureEvaluationValidator::IsEnabled() const
+{
+	static const URepeatedPureEvaluationValidator* CDO = GetDefault<URepeatedPureEvaluationValidator>();
+	return CDO->bIsEnabled && !bIsConfigDisabled;
+}
+
+void URepeatedPureEvaluationValidator::AnalyzeSnapshot(const FBlueprintGraphSnapshot& Snapshot, TArray<FBlueprintSnapshotFinding>& OutFindings) const
+{
+	using namespace RepeatedPureEvaluation;
+
+	for(int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
+	{
+		const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[GraphIndex];
+
+		for(int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
+		{
+			const FBlueprintSnapshotNode& Node = Graph.Nodes[NodeIndex];
+
+			// Nodes only feeding other pure nodes are counted in the subgraph of the node they feed
+			if(!Node.bIsPure || GetNodeCost(Node) == 0 || !FeedsExecNode(Graph, NodeIndex)) continue;
+
+			int32 NumConsumers = 0;
+			WalkDataLinks(Graph, NodeIndex, EGPD_Output, [&Graph, &NumConsumers] (int32 LinkedNode)
+				{
+					if(Graph.Nodes[LinkedNode].bIsPure) return true;
+
+					++NumConsumers;
+					return false;
+				});
+			if(NumConsumers < 2) continue;
+
+			int32 NumPureInputs = 0;
+			int32 SubgraphCost = GetNodeCost(Node);
+			WalkDataLinks(Graph, NodeIndex, EGPD_Input, [&Graph, &NumPureInputs, &SubgraphCost] (int32 LinkedNode)
+				{
+					const FBlueprintSnapshotNode& InputNode = Graph.Nodes[LinkedNode];
+					if(!InputNode.bIsPure) return false;
+
+					++NumPureInputs;
+					SubgraphCost += GetNodeCost(InputNode);
+					return true;
+				});
+
+			const int32 RepeatedCost = (NumConsumers - 1) * SubgraphCost;
+			if(RepeatedCost < MinRepeatedCost) continue;
+
+			FBlueprintSnapshotFinding& Finding = OutFindings.AddDefaulted_GetRef();
+			Finding.Text = FText::Format(
+				INVTEXT("Pure node '{0}' in graph '{1}' and the {2} pure nodes feeding it are evaluated once for each of {3} exec nodes, repeated cost {4}. Store the result in a local variable."),
+				FText::FromString(GetNodeName(Node)),
+				FText::FromName(Graph.Name),
+				FText::AsNumber(NumPureInputs),
+				FText::AsNumber(NumConsumers),
+				FText::AsNumber(RepeatedCost)
+			);
+			Finding.JumpLabel = INVTEXT("Jump to Node");
+			Finding.Graph = GraphIndex;
+			Finding.Node = NodeIndex;
+		}
+	}
+}
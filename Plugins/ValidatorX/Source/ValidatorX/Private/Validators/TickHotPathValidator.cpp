@@ -0,0 +1,507 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Validators/TickHotPathValidator.h"
+#include "Animation/AnimInstance.h"
+#include "Components/ActorComponent.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "GameFramework/Actor.h"
+#include "Misc/DataValidation.h"
+#include "Library/BlueprintGraphSnapshot.h"
+
+namespace TickHotPath
+{
+	/**
+	 * Events the engine calls every frame. Most are event nodes; BlueprintThreadSafeUpdateAnimation can only be
+	 * overridden as a function, so its entry is the FunctionEntry node of a function graph of that name.
+	 */
+	static const FName HighFrequencyEvents[] =
+	{
+		TEXT("ReceiveTick"),
+		TEXT("Tick"),
+		TEXT("BlueprintUpdateAnimation"),
+		TEXT("BlueprintThreadSafeUpdateAnimation")
+	};
+
+	/** Standard macros whose LoopBody pin runs once per iteration. */
+	static const FName LoopMacros[] =
+	{
+		TEXT("ForLoop"),
+		TEXT("ForLoopWithBreak"),
+		TEXT("ForEachLoop"),
+		TEXT("ForEachLoopWithBreak"),
+		TEXT("ReverseForEachLoop"),
+		TEXT("WhileLoop")
+	};
+
+	/** Iterations assumed for a loop body when estimating its cost. */
+	constexpr int32 LoopIterations = 10;
+
+	/**
+	 * A known-expensive node. Costs are rough relative weights per execution, a cast weighs 1.
+	 * Entries only flagged in loops are cheap once but add up per iteration.
+	 */
+	struct FExpensiveNode
+	{
+		const TCHAR* Name;
+		int32 Cost;
+		bool bOnlyInLoops;
+		const TCHAR* Reason;
+	};
+
+	static const FExpensiveNode ExpensiveFunctions[] =
+	{
+		{ TEXT("GetAllActorsOfClass"), 100, false, TEXT("iterates every actor of the world") },
+		{ TEXT("GetAllActorsOfClassWithTag"), 100, false, TEXT("iterates every actor of the world") },
+		{ TEXT("GetAllActorsWithTag"), 100, false, TEXT("iterates every actor of the world") },
+		{ TEXT("GetAllActorsWithInterface"), 100, false, TEXT("iterates every actor of the world") },
+		{ TEXT("GetAllWidgetsOfClass"), 100, false, TEXT("iterates every widget") },
+		{ TEXT("K2_GetComponentsByClass"), 20, false, TEXT("gathers components into a new array") },
+		{ TEXT("GetComponentsByClass"), 20, false, TEXT("gathers components into a new array") },
+		{ TEXT("GetComponentsByTag"), 20, false, TEXT("gathers components into a new array") },
+		{ TEXT("GetComponentsByInterface"), 20, false, TEXT("gathers components into a new array") },
+		{ TEXT("BeginDeferredActorSpawnFromClass"), 80, false, TEXT("spawns an actor") },
+		{ TEXT("SpawnEmitterAtLocation"), 40, false, TEXT("spawns a particle system") },
+		{ TEXT("SpawnEmitterAttached"), 40, false, TEXT("spawns a particle system") },
+		{ TEXT("SpawnSystemAtLocation"), 40, false, TEXT("spawns a particle system") },
+		{ TEXT("SpawnSystemAttached"), 40, false, TEXT("spawns a particle system") },
+		{ TEXT("SpawnSoundAtLocation"), 20, false, TEXT("spawns a sound") },
+		{ TEXT("SpawnSound2D"), 20, false, TEXT("spawns a sound") },
+		{ TEXT("SpawnDecalAtLocation"), 20, false, TEXT("spawns a decal") },
+		{ TEXT("Concat_StrStr"), 5, false, TEXT("builds a string") },
+		{ TEXT("JoinStringArray"), 5, false, TEXT("builds a string") },
+		{ TEXT("Array_Find"), 5, true, TEXT("searches the array linearly") },
+		{ TEXT("Array_Contains"), 5, true, TEXT("searches the array linearly") },
+		{ TEXT("Array_RemoveItem"), 5, true, TEXT("searches the array linearly") },
+		{ TEXT("Array_AddUnique"), 5, true, TEXT("searches the array linearly") }
+	};
+
+	static const FExpensiveNode ExpensiveNodeClasses[] =
+	{
+		{ TEXT("K2Node_SpawnActorFromClass"), 80, false, TEXT("spawns an actor") },
+		{ TEXT("K2Node_SpawnActor"), 80, false, TEXT("spawns an actor") },
+		{ TEXT("K2Node_AddComponent"), 60, false, TEXT("creates a component") },
+		{ TEXT("K2Node_CreateWidget"), 60, false, TEXT("creates a widget") },
+		{ TEXT("K2Node_FormatText"), 5, false, TEXT("builds a text") },
+		{ TEXT("K2Node_DynamicCast"), 1, true, TEXT("casts") },
+		{ TEXT("K2Node_ClassDynamicCast"), 1, true, TEXT("casts") }
+	};
+
+	/** @return Cost entry of the node, null if it is not known to be expensive. */
+	static const FExpensiveNode* FindExpensiveNode(const FBlueprintSnapshotNode& Node)
+	{
+		if(Node.Kind == EBlueprintSnapshotNodeKind::CallFunction)
+		{
+			for(const FExpensiveNode& Entry : ExpensiveFunctions)
+			{
+				if(Node.MemberName == Entry.Name) return &Entry;
+			}
+
+			// Conversions to string and the BuildString helpers allocate like Concat does
+			static const FExpensiveNode StringConversion{ TEXT("ToString"), 5, false, TEXT("builds a string") };
+
+			const FString FunctionName = Node.MemberName.ToString();
+			if(FunctionName.StartsWith(TEXT("BuildString_")) || (FunctionName.StartsWith(TEXT("Conv_")) && FunctionName.EndsWith(TEXT("ToString"))))
+			{
+				return &StringConversion;
+			}
+			return nullptr;
+		}
+
+		for(const FExpensiveNode& Entry : ExpensiveNodeClasses)
+		{
+			if(Node.ClassName == Entry.Name) return &Entry;
+		}
+		return nullptr;
+	}
+
+	static FString GetNodeName(const FBlueprintSnapshotNode& Node)
+	{
+		if(!Node.MemberName.IsNone()) return Node.MemberName.ToString();
+
+		FString ClassName = Node.ClassName.ToString();
+		ClassName.RemoveFromStart(TEXT("K2Node_"));
+		return ClassName;
+	}
+
+	struct FNodeKey
+	{
+		int32 Graph;
+		int32 Node;
+
+		bool operator==(const FNodeKey& Other) const
+		{
+			return Graph == Other.Graph && Node == Other.Node;
+		}
+
+		friend uint32 GetTypeHash(const FNodeKey& Key)
+		{
+			return HashCombine(::GetTypeHash(Key.Graph), ::GetTypeHash(Key.Node));
+		}
+	};
+
+	/** An executed node waiting to be visited, with the names of the events, functions, loops and collapsed graphs that lead to it. */
+	struct FWalkStep
+	{
+		FNodeKey Key;
+		bool bInLoop;
+		TArray<FString> Path;
+
+		/** Collapsed nodes and macro instances whose body is being walked, innermost last. */
+		TArray<FNodeKey> Callers;
+	};
+
+	/** A node is walked again when reached in a loop or from another instance of the macro it belongs to. */
+	struct FVisitKey
+	{
+		FNodeKey Key;
+		bool bInLoop;
+		TArray<FNodeKey> Callers;
+
+		bool operator==(const FVisitKey& Other) const
+		{
+			return Key == Other.Key && bInLoop == Other.bInLoop && Callers == Other.Callers;
+		}
+
+		friend uint32 GetTypeHash(const FVisitKey& VisitKey)
+		{
+			uint32 Hash = HashCombine(GetTypeHash(VisitKey.Key), ::GetTypeHash(VisitKey.bInLoop));
+			for(const FNodeKey& Caller : VisitKey.Callers)
+			{
+				Hash = HashCombine(Hash, GetTypeHash(Caller));
+			}
+			return Hash;
+		}
+	};
+
+	struct FHotNode
+	{
+		const FExpensiveNode* Entry;
+		int32 Cost;
+		bool bInLoop;
+		TArray<FString> Path;
+	};
+
+	/** Walks exec links from the per-frame roots of one snapshot and records the expensive nodes they reach. */
+	class FWalker
+	{
+	public:
+		explicit FWalker(const FBlueprintGraphSnapshot& InSnapshot)
+			: Snapshot(InSnapshot)
+		{
+			// Calls into the Blueprint's own functions and custom events continue the walk at their entry
+			for(int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
+			{
+				const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[GraphIndex];
+				for(int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
+				{
+					const FBlueprintSnapshotNode& Node = Graph.Nodes[NodeIndex];
+					if(Node.Kind == EBlueprintSnapshotNodeKind::FunctionEntry && Graph.Kind == EBlueprintSnapshotGraphKind::Function)
+					{
+						EntriesByName.Add(Graph.Name, FNodeKey{ GraphIndex, NodeIndex });
+					}
+					else if(Node.Kind == EBlueprintSnapshotNodeKind::Event)
+					{
+						EntriesByName.Add(Node.MemberName, FNodeKey{ GraphIndex, NodeIndex });
+					}
+				}
+			}
+		}
+
+		void AddRoots()
+		{
+			for(int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
+			{
+				const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[GraphIndex];
+				const bool bIsHighFrequencyFunction = Graph.Kind == EBlueprintSnapshotGraphKind::Function && MakeArrayView(HighFrequencyEvents).Contains(Graph.Name);
+
+				for(int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
+				{
+					const FBlueprintSnapshotNode& Node = Graph.Nodes[NodeIndex];
+
+					if(Node.Kind == EBlueprintSnapshotNodeKind::Event && MakeArrayView(HighFrequencyEvents).Contains(Node.MemberName))
+					{
+						Push(FNodeKey{ GraphIndex, NodeIndex }, false, { Node.MemberName.ToString() });
+					}
+					else if(Node.Kind == EBlueprintSnapshotNodeKind::FunctionEntry && bIsHighFrequencyFunction)
+					{
+						Push(FNodeKey{ GraphIndex, NodeIndex }, false, { Graph.Name.ToString() });
+					}
+					else if(Node.Kind == EBlueprintSnapshotNodeKind::CallFunction)
+					{
+						AddTimerRoot(GraphIndex, Node);
+					}
+				}
+			}
+		}
+
+		void Walk()
+		{
+			while(Steps.Num() > 0)
+			{
+				const FWalkStep Step = Steps.Pop(EAllowShrinking::No);
+				const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[Step.Key.Graph];
+				const FBlueprintSnapshotNode& Node = Graph.Nodes[Step.Key.Node];
+
+				Visit(Step.Key, Step.bInLoop, Step.Path);
+
+				// Collapsed nodes and the Blueprint's own macros run their body, the walk goes on after its exit tunnel
+				if(Node.BoundGraph != INDEX_NONE && !Step.Callers.Contains(Step.Key))
+				{
+					EnterBoundGraph(Step);
+					continue;
+				}
+
+				if(Node.Kind == EBlueprintSnapshotNodeKind::Tunnel && Step.Callers.Num() > 0)
+				{
+					LeaveBoundGraph(Step);
+				}
+
+				for(const FBlueprintSnapshotPin& Pin : Graph.GetPins(Node))
+				{
+					if(Pin.Direction != EGPD_Output || Pin.Category != UEdGraphSchema_K2::PC_Exec) continue;
+
+					const bool bLoopBody = Node.Kind == EBlueprintSnapshotNodeKind::MacroInstance &&
+						Pin.Name == TEXT("LoopBody") && MakeArrayView(LoopMacros).Contains(Node.MemberName);
+
+					TArray<FString> Path = Step.Path;
+					if(bLoopBody)
+					{
+						Path.Add(GetNodeName(Node));
+					}
+
+					for(const int32 LinkedPin : Pin.LinkedTo)
+					{
+						Push(FNodeKey{ Step.Key.Graph, Graph.Pins[LinkedPin].Node }, Step.bInLoop || bLoopBody, Path, Step.Callers);
+					}
+				}
+			}
+		}
+
+		/** Expensive nodes found, each with the most costly way it was reached. */
+		TMap<FNodeKey, FHotNode> HotNodes;
+
+	private:
+		/** Continues the walk of a collapsed node or macro instance at the input tunnel of its body. */
+		void EnterBoundGraph(const FWalkStep& Step)
+		{
+			const int32 BoundGraphIndex = Snapshot.Graphs[Step.Key.Graph].Nodes[Step.Key.Node].BoundGraph;
+			const FBlueprintSnapshotGraph& BoundGraph = Snapshot.Graphs[BoundGraphIndex];
+
+			TArray<FString> Path = Step.Path;
+			Path.Add(BoundGraph.Name.ToString());
+
+			TArray<FNodeKey> Callers = Step.Callers;
+			Callers.Add(Step.Key);
+
+			// The input tunnel has the exec outputs, the output tunnel the exec inputs
+			for(int32 NodeIndex = 0; NodeIndex < BoundGraph.Nodes.Num(); ++NodeIndex)
+			{
+				const FBlueprintSnapshotNode& Node = BoundGraph.Nodes[NodeIndex];
+				if(Node.Kind != EBlueprintSnapshotNodeKind::Tunnel) continue;
+
+				const bool bIsInputTunnel = BoundGraph.GetPins(Node).ContainsByPredicate([] (const FBlueprintSnapshotPin& Pin)
+					{
+						return Pin.Direction == EGPD_Output && Pin.Category == UEdGraphSchema_K2::PC_Exec;
+					});
+
+				if(bIsInputTunnel)
+				{
+					Push(FNodeKey{ BoundGraphIndex, NodeIndex }, Step.bInLoop, Path, Callers);
+				}
+			}
+		}
+
+		/** Resumes the walk after the innermost caller from the exec outputs matching the linked exec inputs of an output tunnel. */
+		void LeaveBoundGraph(const FWalkStep& Step)
+		{
+			const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[Step.Key.Graph];
+			const FBlueprintSnapshotNode& Node = Graph.Nodes[Step.Key.Node];
+
+			const FNodeKey Caller = Step.Callers.Last();
+			const FBlueprintSnapshotGraph& CallerGraph = Snapshot.Graphs[Caller.Graph];
+			const FBlueprintSnapshotNode& CallerNode = CallerGraph.Nodes[Caller.Node];
+
+			TArray<FNodeKey> Callers = Step.Callers;
+			Callers.Pop(EAllowShrinking::No);
+
+			for(const FBlueprintSnapshotPin& Pin : Graph.GetPins(Node))
+			{
+				if(Pin.Direction != EGPD_Input || Pin.Category != UEdGraphSchema_K2::PC_Exec || Pin.LinkedTo.Num() == 0) continue;
+
+				const FBlueprintSnapshotPin* CallerPin = CallerGraph.FindPin(CallerNode, Pin.Name);
+				if(!CallerPin || CallerPin->Direction != EGPD_Output) continue;
+
+				for(const int32 LinkedPin : CallerPin->LinkedTo)
+				{
+					Push(FNodeKey{ Caller.Graph, CallerGraph.Pins[LinkedPin].Node }, Step.bInLoop, Step.Path, Callers);
+				}
+			}
+		}
+
+		void AddTimerRoot(int32 GraphIndex, const FBlueprintSnapshotNode& Node)
+		{
+			const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[GraphIndex];
+
+			const bool bIsTimerByName = Node.MemberName == TEXT("K2_SetTimer");
+			if(!bIsTimerByName && Node.MemberName != TEXT("K2_SetTimerDelegate")) return;
+
+			// Only looping timers fire repeatedly
+			const FBlueprintSnapshotPin* LoopingPin = Graph.FindPin(Node, TEXT("bLooping"));
+			if(!LoopingPin || LoopingPin->LinkedTo.Num() > 0 || !LoopingPin->DefaultValue.ToBool()) return;
+
+			if(bIsTimerByName)
+			{
+				const FBlueprintSnapshotPin* FunctionNamePin = Graph.FindPin(Node, TEXT("FunctionName"));
+				if(const FNodeKey* Entry = FunctionNamePin ? EntriesByName.Find(FName(*FunctionNamePin->DefaultValue)) : nullptr)
+				{
+					Push(*Entry, false, { FString::Printf(TEXT("Timer %s"), *FunctionNamePin->DefaultValue) });
+				}
+				return;
+			}
+
+			if(const FBlueprintSnapshotPin* DelegatePin = Graph.FindPin(Node, TEXT("Delegate")))
+			{
+				for(const int32 LinkedPin : DelegatePin->LinkedTo)
+				{
+					const int32 EventIndex = Graph.Pins[LinkedPin].Node;
+					if(Graph.Nodes[EventIndex].Kind == EBlueprintSnapshotNodeKind::Event)
+					{
+						Push(FNodeKey{ GraphIndex, EventIndex }, false, { FString::Printf(TEXT("Timer %s"), *GetNodeName(Graph.Nodes[EventIndex])) });
+					}
+				}
+			}
+		}
+
+		void Push(const FNodeKey& Key, bool bInLoop, TArray<FString> Path, TArray<FNodeKey> Callers = {})
+		{
+			bool bAlreadyVisited = false;
+			Visited.Add(FVisitKey{ Key, bInLoop, Callers }, &bAlreadyVisited);
+
+			if(!bAlreadyVisited)
+			{
+				Steps.Add(FWalkStep{ Key, bInLoop, MoveTemp(Path), MoveTemp(Callers) });
+			}
+		}
+
+		/** Records the node if it is expensive, then visits the pure nodes feeding it and the functions it calls. */
+		void Visit(const FNodeKey& Key, bool bInLoop, const TArray<FString>& Path)
+		{
+			const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[Key.Graph];
+			const FBlueprintSnapshotNode& Node = Graph.Nodes[Key.Node];
+
+			if(const FExpensiveNode* Entry = FindExpensiveNode(Node))
+			{
+				if(bInLoop || !Entry->bOnlyInLoops)
+				{
+					const int32 Cost = Entry->Cost * (bInLoop ? LoopIterations : 1);
+
+					FHotNode* HotNode = HotNodes.Find(Key);
+					if(!HotNode || HotNode->Cost < Cost)
+					{
+						HotNodes.Add(Key, FHotNode{ Entry, Cost, bInLoop, Path });
+					}
+				}
+			}
+
+			if(Node.Kind == EBlueprintSnapshotNodeKind::CallFunction && Node.bIsSelfMember)
+			{
+				if(const FNodeKey* CalleeEntry = EntriesByName.Find(Node.MemberName))
+				{
+					TArray<FString> CalleePath = Path;
+					CalleePath.Add(Node.MemberName.ToString());
+					Push(*CalleeEntry, bInLoop, MoveTemp(CalleePath));
+				}
+			}
+
+			// Pure nodes run whenever a node reading their output does
+			for(const FBlueprintSnapshotPin& Pin : Graph.GetPins(Node))
+			{
+				if(Pin.Direction != EGPD_Input || Pin.Category == UEdGraphSchema_K2::PC_Exec) continue;
+
+				for(const int32 LinkedPin : Pin.LinkedTo)
+				{
+					const FNodeKey SourceKey{ Key.Graph, Graph.Pins[LinkedPin].Node };
+					if(!Graph.Nodes[SourceKey.Node].bIsPure) continue;
+
+					bool bAlreadyVisited = false;
+					Visited.Add(FVisitKey{ SourceKey, bInLoop, {} }, &bAlreadyVisited);
+					if(!bAlreadyVisited)
+					{
+						Visit(SourceKey, bInLoop, Path);
+					}
+				}
+			}
+		}
+
+		const FBlueprintGraphSnapshot& Snapshot;
+
+		TMap<FName, FNodeKey> EntriesByName;
+		TSet<FVisitKey> Visited;
+		TArray<FWalkStep> Steps;
+	};
+}
+
+UTickHotPathValidator::UTickHotPathValidator()
+{
+	SetValidationEnabled(true);
+}
+
+bool UTickHotPathValidator::CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const
+{
+	return InAsset && InAsset->IsA<UBlueprint>();
+}
+
+bool UTickHotPathValidator::IsEnabled() const
+{
+	static const UTickHotPathValidator* CDO = GetDefault<UTickHotPathValidator>();
+	return CDO->bIsEnabled && !bIsConfigDisabled;
+}
+
+void UTickHotPathValidator::GetAssetPrefilter(FValidatorAssetPrefilter& OutPrefilter) const
+{
+	Super::GetAssetPrefilter(OutPrefilter);
+
+	OutPrefilter.NativeParentClasses.Add(AActor::StaticClass());
+	OutPrefilter.NativeParentClasses.Add(UActorComponent::StaticClass());
+	OutPrefilter.NativeParentClasses.Add(UAnimInstance::StaticClass());
+
+	// UMG is not a dependency of this module
+	if(const UClass* UserWidgetClass = FindObject<UClass>(FTopLevelAssetPath(TEXT("/Script/UMG"), TEXT("UserWidget"))))
+	{
+		OutPrefilter.NativeParentClasses.Add(UserWidgetClass);
+	}
+}
+
+void UTickHotPathValidator::AnalyzeSnapshot(const FBlueprintGraphSnapshot& Snapshot, TArray<FBlueprintSnapshotFinding>& OutFindings) const
+{
+	using namespace TickHotPath;
+
+	FWalker Walker(Snapshot);
+	Walker.AddRoots();
+	Walker.Walk();
+
+	// Most expensive first
+	Walker.HotNodes.ValueSort([] (const FHotNode& A, const FHotNode& B) { return A.Cost > B.Cost; });
+
+	for(const TPair<FNodeKey, FHotNode>& Pair : Walker.HotNodes)
+	{
+		const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[Pair.Key.Graph];
+		const FHotNode& HotNode = Pair.Value;
+
+		FBlueprintSnapshotFinding& Finding = OutFindings.AddDefaulted_GetRef();
+		Finding.Text = FText::Format(
+			INVTEXT("'{0}' in graph '{1}' {2}{3} on a per-frame path, estimated cost {4}. Reached by: {5}"),
+			FText::FromString(GetNodeName(Graph.Nodes[Pair.Key.Node])),
+			FText::FromName(Graph.Name),
+			FText::FromString(FString(HotNode.Entry->Reason)),
+			HotNode.bInLoop ? INVTEXT(" in a loop") : FText::GetEmpty(),
+			FText::AsNumber(HotNode.Cost),
+			FText::FromString(FString::Join(HotNode.Path, TEXT(" > ")))
+		);
+		Finding.JumpLabel = INVTEXT("Jump to Node");
+		Finding.Graph = Pair.Key.Graph;
+		Finding.Node = Pair.Key.Node;
+	}
+}
@@ -18,6 +18,7 @@
 #include "BlueprintEditorModule.h"
 #include "BlueprintEditor.h"
 #include "SMyBlueprint.h"
+#include "Library/BlueprintGraphIndex.h"
 
 UUnboundEventDispatcherValidator::UUnboundEventDispatcherValidator()
 {
@@ -35,7 +36,7 @@ bool UUnboundEventDispatcherValidator::IsEnabled() const
 	return CDO->bIsEnabled && !bIsConfigDisabled;
 }
 
-EDataValidationResult UUnboundEventDispatcherValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+EDataValidationResult UUnboundEventDispatcherValidator::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
 	bIsError = false;
 
@@ -56,42 +57,8 @@ EDataValidationResult UUnboundEventDispatcherValidator::ValidateLoadedAsset_Impl
 			return EDataValidationResult::Valid;
 		}
 
-		TSet<FName> UsedDispatchers;
-
-
-		auto GatherUsed = [&UsedDispatchers] (const UEdGraph* Graph)
-			{
-				for(UEdGraphNode* Node : Graph->Nodes)
-				{
-					if(UK2Node* K2Node = Cast<UK2Node>(Node))
-					{
-						if(UK2Node_AddDelegate* Add = Cast<UK2Node_AddDelegate>(K2Node))
-						{
-							UsedDispatchers.Add(Add->GetPropertyName());
-						}
-						else if(UK2Node_RemoveDelegate* Remove = Cast<UK2Node_RemoveDelegate>(K2Node))
-						{
-							UsedDispatchers.Add(Remove->GetPropertyName());
-						}
-						else if(UK2Node_CallDelegate* Call = Cast<UK2Node_CallDelegate>(K2Node))
-						{
-							UsedDispatchers.Add(Call->GetPropertyName());
-						}
-						else if(UK2Node_AssignDelegate* Assign = Cast<UK2Node_AssignDelegate>(K2Node))
-						{
-							UsedDispatchers.Add(Assign->GetPropertyName());
-						}
-					}
-				}
-			};
-
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
-
-		for(UEdGraph* Graph : AllGraphs)
-		{
-			GatherUsed(Graph);
-		}
+		const TSharedRef<const FBlueprintGraphIndex> GraphIndex = FBlueprintGraphIndexCache::Get().FindOrBuild(Blueprint);
+		const TSet<FName>& UsedDispatchers = GraphIndex->DelegateUsages;
 
 		for(const FName& Dispatcher : AllDispatchers)
 		{
@@ -7,7 +7,8 @@
 #include "BlueprintEditor.h"
 #include "Misc/DataValidation.h"
 #include "SMyBlueprint.h"
-#include "Library/BPUtilsNodeFunctionLibrary.h"
+#include "Library/BlueprintGraphIndex.h"
+#include "Library/BlueprintClassHierarchy.h"
 
 
 UUnusedFunctionValidator::UUnusedFunctionValidator()
@@ -26,14 +27,25 @@ bool UUnusedFunctionValidator::IsEnabled() const
 	return CDO->bIsEnabled && !bIsConfigDisabled;
 }
 
-EDataValidationResult UUnusedFunctionValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+void UUnusedFunctionValidator::GetCacheDependencies(const FAssetData& InAssetData, TArray<FName>& OutPackageNames) const
+{
+	TArray<FTopLevelAssetPath> DerivedClassPaths;
+	FBlueprintClassHierarchy::Get().GetDerivedClassPaths(FBlueprintClassHierarchy::GetGeneratedClassPath(InAssetData), DerivedClassPaths);
+
+	for(const FTopLevelAssetPath& DerivedClassPath : DerivedClassPaths)
+	{
+		OutPackageNames.Add(DerivedClassPath.GetPackageName());
+	}
+}
+
+EDataValidationResult UUnusedFunctionValidator::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
+		const TSharedRef<const FBlueprintGraphIndex> GraphIndex = FBlueprintGraphIndexCache::Get().FindOrBuild(Blueprint);
+		TSharedPtr<const TSet<FName>> DescendantCalls;
 
 		for(UEdGraph* FunctionGraph : Blueprint->FunctionGraphs)
 		{
@@ -42,58 +54,17 @@ EDataValidationResult UUnusedFunctionValidator::ValidateLoadedAsset_Implementati
 			const FName FunctionName = FunctionGraph->GetFName();
 			if(FunctionName == UEdGraphSchema_K2::FN_UserConstructionScript) continue;
 
-			bool bIsFunctionUsed = false;
-
 			// 1. Search in this blueprint
-			for(UEdGraph* Graph : AllGraphs)
-			{
-				if(!Graph || Graph == FunctionGraph) continue;
-
-				for(UEdGraphNode* Node : Graph->Nodes)
-				{
-					if(const UK2Node_CallFunction* CallFunctionNode = Cast<UK2Node_CallFunction>(Node))
-					{
-						if(CallFunctionNode->FunctionReference.GetMemberName() == FunctionName)
-						{
-							bIsFunctionUsed = true;
-							break;
-						}
-					}
-				}
-				if(bIsFunctionUsed) break;
-			}
+			bool bIsFunctionUsed = GraphIndex->IsFunctionCalled(FunctionName, FunctionGraph);
 
-			// 2. Search in child blueprints 
-			if(!bIsFunctionUsed && Blueprint->GeneratedClass)
+			// 2. Search in child blueprints, gathered once for all functions and only if needed
+			if(!bIsFunctionUsed)
 			{
-				TArray<UClass*> DerivedClasses;
-				UBPUtilsNodeFunctionLibrary::GetAllDerivedBlueprintClasses(Blueprint->GeneratedClass, DerivedClasses, true);
-
-				for(UClass* ChildClass : DerivedClasses)
+				if(!DescendantCalls.IsValid())
 				{
-					UBlueprint* ChildBP = Cast<UBlueprint>(ChildClass->ClassGeneratedBy);
-					if(!ChildBP) continue;
-
-					TArray<UEdGraph*> ChildGraphs;
-					ChildBP->GetAllGraphs(ChildGraphs);
-
-					for(UEdGraph* Graph : ChildGraphs)
-					{
-						for(UEdGraphNode* Node : Graph->Nodes)
-						{
-							if(const UK2Node_CallFunction* CallFunctionNode = Cast<UK2Node_CallFunction>(Node))
-							{
-								if(CallFunctionNode->FunctionReference.GetMemberName() == FunctionName)
-								{
-									bIsFunctionUsed = true;
-									break;
-								}
-							}
-						}
-						if(bIsFunctionUsed) break;
-					}
-					if(bIsFunctionUsed) break;
+					DescendantCalls = FBlueprintGraphIndexCache::Get().FindOrBuildDescendantCalls(Blueprint);
 				}
+				bIsFunctionUsed = DescendantCalls->Contains(FunctionName);
 			}
 
 			if(!bIsFunctionUsed)
@@ -7,6 +7,7 @@
 #include "BlueprintEditor.h"
 #include "Misc/DataValidation.h"
 #include "SMyBlueprint.h"
+#include "Library/BlueprintGraphIndex.h"
 
 UUnusedMacroValidator::UUnusedMacroValidator()
 {
@@ -24,44 +25,20 @@ bool UUnusedMacroValidator::IsEnabled() const
 	return CDO->bIsEnabled && !bIsConfigDisabled;
 }
 
-EDataValidationResult UUnusedMacroValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+EDataValidationResult UUnusedMacroValidator::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
 	bIsError = false;
 
 	if (UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
+		const TSharedRef<const FBlueprintGraphIndex> GraphIndex = FBlueprintGraphIndexCache::Get().FindOrBuild(Blueprint);
 
 		for(UEdGraph* MacroGraph : Blueprint->MacroGraphs)
 		{
 			if(!MacroGraph) continue;
 
 			const FName MacroName = MacroGraph->GetFName();
-			bool bIsMacroUsed = false;
-
-			for (UEdGraph* Graph : AllGraphs)
-			{
-				if (!Graph || Graph == MacroGraph) continue;
-
-				for (UEdGraphNode* Node : Graph->Nodes)
-				{
-					if (const UK2Node_MacroInstance* MacroInstance = Cast<UK2Node_MacroInstance>(Node))
-					{
-						if (MacroInstance->GetMacroGraph() == MacroGraph)
-						{
-							bIsMacroUsed = true;
-							break;
-						}
-					}
-				}
-
-				if (bIsMacroUsed)
-				{
-					break;
-				}
-			}
-
+			const bool bIsMacroUsed = GraphIndex->IsMacroInstanced(MacroGraph, MacroGraph);
 
 			if(!bIsMacroUsed)
 			{
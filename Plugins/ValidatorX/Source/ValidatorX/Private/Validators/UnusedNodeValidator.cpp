@@ -16,6 +16,7 @@
 #include "BlueprintEditorModule.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "Library/BPUtilsNodeFunctionLibrary.h"
+#include "Library/BlueprintGraphIndex.h"
 
 UUnusedNodeValidator::UUnusedNodeValidator()
 {
@@ -33,33 +34,21 @@ bool UUnusedNodeValidator::IsEnabled() const
 	return CDO->bIsEnabled && !bIsConfigDisabled;
 }
 
-EDataValidationResult UUnusedNodeValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+EDataValidationResult UUnusedNodeValidator::ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
+		const TSharedRef<const FBlueprintGraphIndex> GraphIndex = FBlueprintGraphIndexCache::Get().FindOrBuild(Blueprint);
 
-		for(UEdGraph* Graph : AllGraphs)
+		for(UEdGraph* Graph : GraphIndex->Graphs)
 		{
-			if(!Graph) continue;
-
-			TArray<UEdGraphNode_Comment*> CommentNodes;
-			for(UEdGraphNode* Node : Graph->Nodes)
-			{
-				if(UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Node))
-				{
-					CommentNodes.Add(Comment);
-				}
-			}
-
 			for(UEdGraphNode* Node : Graph->Nodes)
 			{
 				if(!Node || Node->IsA<UEdGraphNode_Comment>()) continue;
 
-				if(UBPUtilsNodeFunctionLibrary::IsNodeInsideComment(Node, CommentNodes))
+				if(GraphIndex->IsNodeInsideComment(Graph, Node))
 				{
 					continue;
 				}
@@ -3,13 +3,43 @@
 
 #include "Widgets/SValidatorWidget.h"
 #include "BaseClasses/BlueprintValidatorBase.h"
+#include "ValidatorXManager.h"
 #include "Styling/SlateStyleRegistry.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+#include "Widgets/Notifications/SNotificationList.h"
 
 namespace ValidatorListColumns
 {
 	static const FName ColumnID_Type("Type");
 	static const FName ColumnID_Name("Name");
 	static const FName ColumnID_Button("Button");
+	static const FName ColumnID_Calls("Calls");
+	static const FName ColumnID_MeanMs("MeanMs");
+	static const FName ColumnID_MaxMs("MaxMs");
+	static const FName ColumnID_TotalMs("TotalMs");
+	static const FName ColumnID_Nodes("Nodes");
+	static const FName ColumnID_Messages("Messages");
+
+	/** @return Value of a stats column for a validator, 0 for the other columns. */
+	static double GetStatValue(const UBlueprintValidatorBase& Validator, const FName ColumnId)
+	{
+		const FValidatorXStats& Stats = Validator.GetStats();
+
+		if(ColumnId == ColumnID_Calls) return Stats.Calls;
+		if(ColumnId == ColumnID_MeanMs) return Stats.GetMeanSeconds() * 1000.0;
+		if(ColumnId == ColumnID_MaxMs) return Stats.MaxSeconds * 1000.0;
+		if(ColumnId == ColumnID_TotalMs) return Stats.TotalSeconds * 1000.0;
+		if(ColumnId == ColumnID_Nodes) return Stats.NodesVisited;
+		if(ColumnId == ColumnID_Messages) return Stats.MessagesEmitted;
+		return 0.0;
+	}
+
+	static bool IsTimeColumn(const FName ColumnId)
+	{
+		return ColumnId == ColumnID_MeanMs || ColumnId == ColumnID_MaxMs || ColumnId == ColumnID_TotalMs;
+	}
 }
 
 FString AddSpacesBeforeUppercase(const FString& Input)
@@ -140,6 +170,35 @@ public:
 				];
 		}
 
+		else if(Validator.IsValid())
+		{
+			const FName StatColumnId = ColumnId;
+			return SNew(SBox)
+				.Padding(4.0f)
+				.VAlign(VAlign_Center)
+				.HAlign(HAlign_Right)
+				[
+					SNew(STextBlock)
+						.Text_Lambda([this, StatColumnId]
+							{
+								if(!Validator.IsValid()) return FText::GetEmpty();
+
+								const double Value = ValidatorListColumns::GetStatValue(*Validator, StatColumnId);
+								return ValidatorListColumns::IsTimeColumn(StatColumnId)
+									? FText::FromString(FString::Printf(TEXT("%.2f"), Value))
+									: FText::AsNumber(static_cast<int64>(Value));
+							})
+						.ToolTipText_Lambda([this]
+							{
+								if(!Validator.IsValid()) return FText::GetEmpty();
+
+								const FValidatorXStats& Stats = Validator->GetStats();
+								return FText::FromString(FString::Printf(TEXT("%d calls, %d from cache, %d failed"), Stats.Calls, Stats.CacheHits, Stats.Failures));
+							})
+						.Font(LocalFont)
+				];
+		}
+
 		return SNullWidget::NullWidget;
 	}
 
@@ -183,6 +242,30 @@ void SValidatorWidget::Construct(const FArguments& InArgs)
 			SNew(SSeparator).Thickness(1.0f)
 		]
 
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(0.0f, 0.0f, 4.0f, 0.0f)
+			[
+				SNew(SButton)
+					.Text(FText::FromString("Export Stats"))
+					.ToolTipText(FText::FromString("Write the timing and counters of every validator to a CSV file"))
+					.OnClicked(this, &SValidatorWidget::OnExportStatsClicked)
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SButton)
+					.Text(FText::FromString("Reset Stats"))
+					.ToolTipText(FText::FromString("Clear the timing and counters of every validator"))
+					.OnClicked(this, &SValidatorWidget::OnResetStatsClicked)
+			]
+		]
+
 		+ SVerticalBox::Slot()
 		.Padding(4)
 		[
@@ -202,16 +285,27 @@ void SValidatorWidget::Construct(const FArguments& InArgs)
 							+ SHeaderRow::Column(ValidatorListColumns::ColumnID_Type)
 							.FillWidth(0.4f)
 							.FixedWidth(StaticCast<TOptional<float>>(200.0f))
+							.SortMode(this, &SValidatorWidget::GetColumnSortMode, ValidatorListColumns::ColumnID_Type)
+							.OnSort(this, &SValidatorWidget::OnColumnSortModeChanged)
 							[
 								SNew(STextBlock).Text(FText::FromString("Type")).Justification(ETextJustify::Center).Font(FontInfo)
 							]
 
 							+ SHeaderRow::Column(ValidatorListColumns::ColumnID_Name)
 							.FillWidth(0.4f)
+							.SortMode(this, &SValidatorWidget::GetColumnSortMode, ValidatorListColumns::ColumnID_Name)
+							.OnSort(this, &SValidatorWidget::OnColumnSortModeChanged)
 							[
 								SNew(STextBlock).Text(FText::FromString("Validator Name")).Justification(ETextJustify::Center).Font(FontInfo)
 							]
 
+							+ MakeStatColumn(ValidatorListColumns::ColumnID_Calls, "Calls", "Validation calls, including those answered from the cache")
+							+ MakeStatColumn(ValidatorListColumns::ColumnID_MeanMs, "Mean ms", "Mean time per call in milliseconds")
+							+ MakeStatColumn(ValidatorListColumns::ColumnID_MaxMs, "Max ms", "Longest call in milliseconds")
+							+ MakeStatColumn(ValidatorListColumns::ColumnID_TotalMs, "Total ms", "Time of all calls in milliseconds")
+							+ MakeStatColumn(ValidatorListColumns::ColumnID_Nodes, "Nodes", "Nodes in the graphs of the Blueprints analyzed outside of the cache")
+							+ MakeStatColumn(ValidatorListColumns::ColumnID_Messages, "Messages", "Messages reported, including replayed ones")
+
 							+ SHeaderRow::Column(ValidatorListColumns::ColumnID_Button)
 							.FixedWidth(StaticCast<TOptional<float>>(50.0f))
 							[
@@ -255,4 +349,75 @@ TSharedRef<ITableRow> SValidatorWidget::OnGenerateRowForList(TWeakObjectPtr<UBlu
 	return SNew(SValidatorTableRow, OwnerTable)
 		.Validator(InItem)
 		.Font(FontInfo);
-}
\ No newline at end of file
+}
+
+SHeaderRow::FColumn::FArguments SValidatorWidget::MakeStatColumn(const FName ColumnId, const FString& Label, const FString& ToolTip)
+{
+	return SHeaderRow::Column(ColumnId)
+		.FixedWidth(StaticCast<TOptional<float>>(110.0f))
+		.HAlignHeader(HAlign_Center)
+		.SortMode(this, &SValidatorWidget::GetColumnSortMode, ColumnId)
+		.OnSort(this, &SValidatorWidget::OnColumnSortModeChanged)
+		[
+			SNew(STextBlock).Text(FText::FromString(Label)).ToolTipText(FText::FromString(ToolTip)).Justification(ETextJustify::Center).Font(FontInfo)
+		];
+}
+
+EColumnSortMode::Type SValidatorWidget::GetColumnSortMode(const FName ColumnId) const
+{
+	return ColumnId == SortColumn ? SortMode : EColumnSortMode::None;
+}
+
+void SValidatorWidget::OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type InSortMode)
+{
+	SortColumn = ColumnId;
+	SortMode = InSortMode;
+
+	const bool bAscending = SortMode == EColumnSortMode::Ascending;
+
+	LocalValidators.Sort([this, bAscending] (const TWeakObjectPtr<UBlueprintValidatorBase>& A, const TWeakObjectPtr<UBlueprintValidatorBase>& B)
+		{
+			if(!A.IsValid() || !B.IsValid()) return B.IsValid();
+
+			if(SortColumn == ValidatorListColumns::ColumnID_Type || SortColumn == ValidatorListColumns::ColumnID_Name)
+			{
+				const FString KeyA = SortColumn == ValidatorListColumns::ColumnID_Type ? A->GetTypeValidator() : A->GetName();
+				const FString KeyB = SortColumn == ValidatorListColumns::ColumnID_Type ? B->GetTypeValidator() : B->GetName();
+				return bAscending ? KeyA < KeyB : KeyB < KeyA;
+			}
+
+			const double ValueA = ValidatorListColumns::GetStatValue(*A, SortColumn);
+			const double ValueB = ValidatorListColumns::GetStatValue(*B, SortColumn);
+			return bAscending ? ValueA < ValueB : ValueB < ValueA;
+		});
+
+	if(ListViewWidget.IsValid())
+	{
+		ListViewWidget->RequestListRefresh();
+	}
+}
+
+FReply SValidatorWidget::OnExportStatsClicked()
+{
+	const FString FileName = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("ValidatorX") /
+		FString::Printf(TEXT("ValidatorStats-%s.csv"), *FDateTime::Now().ToString()));
+
+	const bool bSaved = FValidatorXManager::Get().ExportStatsToCsv(FileName);
+
+	FNotificationInfo Info(FText::FromString(bSaved ? FString::Printf(TEXT("Validator stats exported to %s"), *FileName) : FString::Printf(TEXT("Failed to write %s"), *FileName)));
+	Info.ExpireDuration = 5.0f;
+	if(bSaved)
+	{
+		Info.Hyperlink = FSimpleDelegate::CreateLambda([FileName] { FPlatformProcess::ExploreFolder(*FileName); });
+		Info.HyperlinkText = FText::FromString("Show in Explorer");
+	}
+	FSlateNotificationManager::Get().AddNotification(Info);
+
+	return FReply::Handled();
+}
+
+FReply SValidatorWidget::OnResetStatsClicked()
+{
+	FValidatorXManager::Get().ResetStats();
+	return FReply::Handled();
+}
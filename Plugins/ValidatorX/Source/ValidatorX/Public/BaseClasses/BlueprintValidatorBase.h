@@ -5,8 +5,71 @@
 #include "CoreMinimal.h"
 #include "EditorValidatorBase.h"
 #include "Interface/ValidatorToggleInterface.h"
+#include "IO/IoHash.h"
+#include "Trace/Trace.h"
 #include "BlueprintValidatorBase.generated.h"
 
+struct FBlueprintGraphSnapshot;
+struct FBlueprintSnapshotFinding;
+
+/** Insights channel of the validator CPU scopes, enable with -trace=cpu,ValidatorX. */
+UE_TRACE_CHANNEL_EXTERN(ValidatorXChannel, VALIDATORX_API);
+
+/** Counters accumulated by every validation call of one validator since the editor started or the last reset. */
+struct FValidatorXStats
+{
+	int32 Calls = 0;
+
+	/** Calls answered from the validation cache. */
+	int32 CacheHits = 0;
+
+	/** Calls that reported the asset as invalid. */
+	int32 Failures = 0;
+
+	/** Nodes in the graphs of the Blueprints analyzed by calls that missed the cache. */
+	int64 NodesVisited = 0;
+
+	int32 MessagesEmitted = 0;
+
+	double TotalSeconds = 0.0;
+	double MaxSeconds = 0.0;
+
+	/** Time of the calls that missed the cache, what a validation costs when it actually runs. */
+	double UncachedSeconds = 0.0;
+	double MaxUncachedSeconds = 0.0;
+
+	double GetMeanSeconds() const
+	{
+		return Calls > 0 ? TotalSeconds / Calls : 0.0;
+	}
+
+	int32 GetUncachedCalls() const
+	{
+		return Calls - CacheHits;
+	}
+
+	double GetUncachedMeanSeconds() const
+	{
+		return GetUncachedCalls() > 0 ? UncachedSeconds / GetUncachedCalls() : 0.0;
+	}
+};
+
+/**
+ * What a validator can tell from the asset registry alone, so assets it could never flag are not loaded for it.
+ * Classes must be native, they are compared without loading anything.
+ */
+struct FValidatorAssetPrefilter
+{
+	/** Asset classes the validator applies to, derived classes included. */
+	TArray<const UClass*> AssetClasses;
+
+	/** When not empty, only Blueprints whose native parent class derives from one of these. */
+	TArray<const UClass*> NativeParentClasses;
+
+	/** Skip data-only Blueprints: they have no graph code, functions, dispatchers or variables of their own. */
+	bool bRequiresGraphData = true;
+};
+
 /**
  * 
  */
@@ -29,6 +92,141 @@ public:
 	virtual void ToggleValidationEnabled() override {}
 	virtual void SetValidationEnabled(bool bEnabled) override {}
 #pragma endregion
+
+	/**
+	 * Serves the result from the validation cache when the package and its dependencies are unchanged,
+	 * otherwise runs ValidateBlueprintAsset and caches what it reports. Validators override ValidateBlueprintAsset.
+	 * Every call is timed into the stats and traced on the ValidatorX channel. Assets rejected by the
+	 * prefilter, judged from their live state, are not validated.
+	 */
+	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override final;
+
+	/**
+	 * Performs the actual validation of a loaded asset, bypassing the validation cache.
+	 *
+	 * @param InAssetData   Asset metadata
+	 * @param InAsset       Loaded asset object
+	 * @param Context       Validation context for reporting issues
+	 * @return EDataValidationResult::Valid if valid, Invalid otherwise
+	 */
+	virtual EDataValidationResult ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context);
+
+	/** @return True if the validator implements AnalyzeSnapshot instead of ValidateBlueprintAsset, so its analysis can run on worker threads. */
+	virtual bool SupportsSnapshotAnalysis() const
+	{
+		return false;
+	}
+
+	/**
+	 * Analyzes a plain-data copy of the Blueprint graphs. May run on any thread, so it must only read
+	 * the snapshot and the validator's config.
+	 *
+	 * @param Snapshot      Graphs of the Blueprint
+	 * @param OutFindings   Problems found, reported as messages with jump actions on the game thread
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintGraphSnapshot& Snapshot, TArray<FBlueprintSnapshotFinding>& OutFindings) const {}
+
+	/**
+	 * Collects the packages, besides the asset's own, whose content can change this validator's result.
+	 * A cached result is only reused while all of them are unchanged.
+	 */
+	virtual void GetCacheDependencies(const FAssetData& InAssetData, TArray<FName>& OutPackageNames) const {}
+
+	/**
+	 * @return True if a run is known to take long whatever the asset, e.g. a walk of its whole reference closure.
+	 * Background validation leaves such validators out, they run on save or from the commandlet.
+	 */
+	virtual bool IsExpensive() const
+	{
+		return false;
+	}
+
+	/** Bump when the validator logic changes so results cached by older versions are discarded. */
+	virtual int32 GetCacheVersion() const
+	{
+		return 1;
+	}
+
+	/**
+	 * Runs this validator on one asset outside of the validator subsystem, e.g. from a commandlet.
+	 * The enable toggles are not checked.
+	 *
+	 * @param InCacheKey    Validation cache key the caller already computed for this validator and asset, unset if
+	 *                      it could not be computed. Null to compute it, which hashes every cache dependency.
+	 * @return NotValidated if the validator does not apply to the asset.
+	 */
+	EDataValidationResult ValidateAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext, const TOptional<FIoHash>* InCacheKey = nullptr)
+	{
+		TGuardValue<const TOptional<FIoHash>*> CacheKeyGuard(PrecomputedCacheKey, InCacheKey);
+		return CanValidateAsset(InAssetData, InAsset, InContext) ? ValidateLoadedAsset(InAssetData, InAsset, InContext) : EDataValidationResult::NotValidated;
+	}
+
+	const FValidatorXStats& GetStats() const
+	{
+		return Stats;
+	}
+
+	void ResetStats()
+	{
+		Stats = FValidatorXStats();
+	}
+
+	/**
+	 * Declares the registry-level prefilter of the validator, queried once. The default accepts Blueprints
+	 * that are not data-only.
+	 */
+	virtual void GetAssetPrefilter(FValidatorAssetPrefilter& OutPrefilter) const;
+
+	/**
+	 * Checks the asset against the prefilter using its registry tags only. Assets without the tags pass.
+	 *
+	 * @return False if the validator could never flag the asset, so it does not need to be loaded for it.
+	 */
+	bool PassesAssetPrefilter(const FAssetData& InAssetData) const;
+
+	/**
+	 * Checks a loaded asset against the prefilter using its live state, which the registry tags may not
+	 * reflect yet, e.g. a data-only Blueprint that was just given a graph and not saved.
+	 */
+	bool PassesAssetPrefilter(const UObject* InAsset) const;
+
+	/**
+	 * Like ValidateAsset, with the findings of a snapshot validator already analyzed, e.g. on a worker thread.
+	 * Goes through the validation cache and the stats like any other call.
+	 *
+	 * @param Snapshot  Snapshot the findings were analyzed from, their indices refer to it.
+	 */
+	EDataValidationResult ValidateAssetWithFindings(const FAssetData& InAssetData, UObject* InAsset, const FBlueprintGraphSnapshot& Snapshot,
+		TConstArrayView<FBlueprintSnapshotFinding> Findings, FDataValidationContext& InContext, const TOptional<FIoHash>* InCacheKey = nullptr);
+
 	bool bIsError = false;
 
+protected:
+	/** Set by ValidateBlueprintAsset when its result misses data that is still loading, so the result is not cached. */
+	bool bIsResultPartial = false;
+
+	/** Adds a message for every finding, with an action jumping to its graph or node. Game thread only. */
+	EDataValidationResult ReportSnapshotFindings(const FBlueprintGraphSnapshot& Snapshot, TConstArrayView<FBlueprintSnapshotFinding> Findings, FDataValidationContext& Context);
+
+private:
+	/** Findings handed to the next ValidateBlueprintAsset call by ValidateAssetWithFindings. */
+	struct FPendingFindings
+	{
+		const FBlueprintGraphSnapshot* Snapshot;
+		TConstArrayView<FBlueprintSnapshotFinding> Findings;
+	};
+
+	const FPendingFindings* PendingFindings = nullptr;
+
+	/** Cache key handed to the next ValidateWithCache call by ValidateAsset, null if it must be computed. */
+	const TOptional<FIoHash>* PrecomputedCacheKey = nullptr;
+
+	mutable TOptional<FValidatorAssetPrefilter> AssetPrefilter;
+
+	const FValidatorAssetPrefilter& GetCachedAssetPrefilter() const;
+
+	EDataValidationResult ValidateWithCache(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context, bool& bOutCacheHit);
+
+	FValidatorXStats Stats;
+
 };
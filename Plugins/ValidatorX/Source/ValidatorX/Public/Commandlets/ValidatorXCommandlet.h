@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ValidatorXCommandlet.generated.h"
+
+class UBlueprintValidatorBase;
+
+/**
+ * Validates every Blueprint under the given content paths with the ValidatorX validators, without the editor UI.
+ *
+ * Packages are loaded asynchronously one batch ahead of validation, and garbage is collected after each batch
+ * so memory stays bounded on large projects. Results are written as JSON and/or JUnit XML with per-asset and
+ * per-validator timings. Blueprints whose packages are unchanged since their last validation are answered from
+ * the validation cache without being loaded, unless -NoCache is given.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=ValidatorX [-Paths=/Game/A+/Game/B] [-Validators=UnusedFunctionValidator+...]
+ *                    [-BatchSize=256] [-Json=<File>] [-JUnit=<File>] [-NoCache] [-NoFail]
+ *
+ * Every ValidatorX validator runs unless -Validators restricts the set; the editor enable toggles are ignored.
+ * The commandlet returns 1 if any asset failed validation, unless -NoFail is given.
+ */
+UCLASS()
+class VALIDATORX_API UValidatorXCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UValidatorXCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/**
+	 * Creates one instance of every ValidatorX validator class, rooted for the duration of the run.
+	 *
+	 * @param ValidatorNames Class names to keep, e.g. UnusedFunctionValidator. Empty keeps every validator.
+	 */
+	static TArray<UBlueprintValidatorBase*> CreateValidators(const TArray<FString>& ValidatorNames);
+};
@@ -33,9 +33,34 @@ public:
 	 * @param OutDerived    The output array that will be filled with all matching derived Blueprint-generated classes.
 	 */
 	static void GetDerivedBlueprintClasses(const UClass* ParentClass, TArray<UClass*>& OutDerived);
-	
-	static void GetDerivedRegistryBlueprintClasses(const UClass* ParentClass, TArray<UClass*>& OutDerived);
-	
+
+	/**
+	 * Collects every Blueprint class derived from the specified parent class, loaded or not.
+	 *
+	 * The result comes from the ParentClass tags in the asset registry, so no package is loaded.
+	 * Descendants are transitive: children of derived Blueprints are included as well.
+	 *
+	 * @param ParentClass   The base class to search derived Blueprint classes from. Must not be null.
+	 * @param OutDerived    Receives the generated class path of every derived Blueprint.
+	 */
+	static void GetDerivedRegistryBlueprintClassPaths(const UClass* ParentClass, TArray<FSoftClassPath>& OutDerived);
+
+	/**
+	 * Resolves the registry descendants of the specified parent class to classes.
+	 *
+	 * @param ParentClass   The base class to search derived Blueprint classes from. Must not be null.
+	 * @param OutDerived    Receives the derived Blueprint-generated classes.
+	 * @param bLoadClasses  Loads the Blueprints that are not in memory yet. When false, only already loaded classes are returned.
+	 */
+	static void GetDerivedRegistryBlueprintClasses(const UClass* ParentClass, TArray<UClass*>& OutDerived, bool bLoadClasses = false);
+
+	/**
+	 * Collects the loaded derived Blueprint classes, falling back to the asset registry when none is loaded.
+	 *
+	 * @param ParentClass            The base class to search derived Blueprint classes from. Must not be null.
+	 * @param OutDerived             Receives the derived Blueprint-generated classes.
+	 * @param bSearchAssetRegistry   Loads the registry descendants if no derived class is in memory.
+	 */
 	static void GetAllDerivedBlueprintClasses(const UClass* ParentClass, TArray<UClass*>& OutDerived, bool bSearchAssetRegistry = true);
 
 
@@ -50,6 +75,26 @@ public:
 	static bool IsNodeInsideComment(UEdGraphNode* Node, const TArray<UEdGraphNode_Comment*>& CommentNodes);
 	static bool HasExecutionOutputConnections(const UEdGraphNode* Node);
 
+	/** @return True if the node has no exec pins and runs whenever a node reading its outputs runs. */
+	static bool IsPureNode(const UEdGraphNode* Node);
+
+	/**
+	 * Follows the data outputs of a pure node, through any pure nodes they feed, to the impure nodes reading them.
+	 * Each of these re-evaluates the node, so their count is how often it runs per pass over the graph.
+	 *
+	 * @param PureNode      Node to start from
+	 * @param OutConsumers  Receives every distinct impure node, in link order
+	 */
+	static void GetPureExecConsumers(const UEdGraphNode* PureNode, TArray<UEdGraphNode*>& OutConsumers);
+
+	/**
+	 * Follows the data inputs of a node back through the pure nodes feeding it, transitively.
+	 *
+	 * @param Node              Node to start from, not included itself
+	 * @param OutPureNodes      Receives every distinct pure node evaluated together with the node
+	 */
+	static void GetPureInputNodes(const UEdGraphNode* Node, TArray<UEdGraphNode*>& OutPureNodes);
+
 	static FString GetGraphType(UBlueprint* Blueprint, UEdGraph* Graph);
 
 	static bool IsBoolVariableSetInThisOrParentBPs(UBlueprint* Blueprint, FName VarName, FString* OutSourceInfo = nullptr);
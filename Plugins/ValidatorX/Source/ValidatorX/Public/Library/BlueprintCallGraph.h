@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/TopLevelAssetPath.h"
+#include "UObject/UObjectGlobals.h"
+
+class UBlueprint;
+class UPackage;
+struct FAssetData;
+
+/** A function or macro graph of a Blueprint, identified without loading it. */
+struct VALIDATORX_API FBlueprintCallable
+{
+	/** Blueprint asset that owns the graph. */
+	FTopLevelAssetPath Blueprint;
+
+	/** Name of the function or macro graph. */
+	FName Graph;
+
+	bool operator==(const FBlueprintCallable& Other) const
+	{
+		return Blueprint == Other.Blueprint && Graph == Other.Graph;
+	}
+
+	friend uint32 GetTypeHash(const FBlueprintCallable& Callable)
+	{
+		return HashCombine(GetTypeHash(Callable.Blueprint), GetTypeHash(Callable.Graph));
+	}
+
+	/** @return "Blueprint.Graph", e.g. "BP_Enemy.TakeDamage". */
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("%s.%s"), *Blueprint.GetAssetName().ToString(), *Graph.ToString());
+	}
+};
+
+/** Functions and macros that reach each other through calls: a strongly connected component of the call graph. */
+struct FBlueprintCallCluster
+{
+	/** Members sorted by name. */
+	TArray<FBlueprintCallable> Members;
+};
+
+/**
+ * Call graph of the function and macro graphs of every Blueprint in the project, including function and macro
+ * libraries, with its recursive clusters.
+ *
+ * Calls between Blueprints are also hard package dependencies, so only the Blueprints whose packages form a
+ * dependency cycle in the asset registry can share a recursive cluster. The first query requests those in
+ * batches of asynchronous loads and each is read when its load completes, so the editor never waits on them;
+ * queries answered before all of them are read are partial. Commandlets load them synchronously. The call
+ * edges of every Blueprint are kept after it is unloaded, and only the Blueprints that changed are read again.
+ * The clusters are recomputed with an iterative Tarjan pass after any change.
+ * All methods must be called on the game thread.
+ */
+class VALIDATORX_API FBlueprintCallGraph
+{
+	FBlueprintCallGraph() {}
+	FBlueprintCallGraph(const FBlueprintCallGraph&) = delete;
+	FBlueprintCallGraph& operator=(const FBlueprintCallGraph&) = delete;
+
+public:
+	static FBlueprintCallGraph& Get()
+	{
+		static FBlueprintCallGraph Instance;
+		return Instance;
+	}
+
+	/** Subscribes to the editor and asset registry events that make call edges stale. */
+	void Initialize();
+
+	/** Unsubscribes from all events and drops the graph. */
+	void Shutdown();
+
+	/**
+	 * Collects the recursive clusters one of the Blueprint's functions or macros belongs to. A function that only
+	 * calls itself forms a cluster of its own.
+	 *
+	 * @param Blueprint Blueprint to query. Must not be null.
+	 * @param OutClusters Receives each cluster once.
+	 * @return False if Blueprints of the dependency cycles are still loading, so clusters through them may be missing.
+	 */
+	bool GetRecursiveClusters(UBlueprint* Blueprint, TArray<TSharedRef<const FBlueprintCallCluster>>& OutClusters);
+
+	/**
+	 * Collects the Blueprint packages that form a hard dependency cycle with the given package, from the asset
+	 * registry only. These are the packages whose calls can make the package's functions recursive.
+	 */
+	void GetDependencyCyclePackages(FName PackageName, TArray<FName>& OutPackageNames);
+
+private:
+	/** Call edges read from one Blueprint. */
+	struct FBlueprintCalls
+	{
+		/** Function and macro graphs of the Blueprint. */
+		TArray<FName> Graphs;
+
+		/** Caller graph of the Blueprint and the callable it calls. */
+		TArray<TPair<FName, FBlueprintCallable>> Calls;
+	};
+
+	void EnsurePackageCycles();
+	void EnsureCandidatesLoaded();
+	void RequestQueuedLoads();
+	void OnCandidateLoaded(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result);
+	void UpdateBlueprint(UBlueprint* Blueprint);
+	void UpdateClusters();
+
+	static FBlueprintCalls ReadCalls(UBlueprint* Blueprint);
+
+	void OnObjectModified(UObject* Object);
+	void OnBlueprintPreCompile(UBlueprint* Blueprint);
+	void OnUndoRedo();
+	void OnAssetChanged(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	TMap<FTopLevelAssetPath, FBlueprintCalls> CallsByBlueprint;
+
+	/** Blueprints whose calls changed since they were read. */
+	TSet<FTopLevelAssetPath> StaleBlueprints;
+
+	/** Blueprint packages in a hard dependency cycle, and the index of their cycle in PackageCycles. */
+	TMap<FName, int32> PackageCycleByPackage;
+	TArray<TArray<FName>> PackageCycles;
+
+	/** Packages of dependency cycles waiting for a load request, and those whose load is in flight. */
+	TArray<FName> QueuedLoads;
+	TSet<FName> InFlightLoads;
+
+	/** Number of packages read since the queue was last empty, and when that started. */
+	int32 NumLoadsRead = 0;
+	double LoadStartTime = 0.0;
+
+	TArray<TSharedRef<const FBlueprintCallCluster>> Clusters;
+	TMap<FTopLevelAssetPath, TArray<int32>> ClustersByBlueprint;
+
+	bool bArePackageCyclesDirty = true;
+	bool bAreCandidatesDirty = true;
+	bool bAreClustersDirty = true;
+
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+	FDelegateHandle UndoRedoHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+};
@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/TopLevelAssetPath.h"
+
+struct FAssetData;
+
+/**
+ * Parent to children map of every Blueprint class in the asset registry.
+ *
+ * The map is built from the ParentClass/NativeParentClass tags of the Blueprint assets, so no package is
+ * loaded to answer a query. It is built on the first query and kept in sync with asset registry events.
+ * All methods must be called on the game thread.
+ */
+class VALIDATORX_API FBlueprintClassHierarchy
+{
+	FBlueprintClassHierarchy() {}
+	FBlueprintClassHierarchy(const FBlueprintClassHierarchy&) = delete;
+	FBlueprintClassHierarchy& operator=(const FBlueprintClassHierarchy&) = delete;
+
+public:
+	static FBlueprintClassHierarchy& Get()
+	{
+		static FBlueprintClassHierarchy Instance;
+		return Instance;
+	}
+
+	/** Subscribes to the asset registry events that keep the map in sync. */
+	void Initialize();
+
+	/** Unsubscribes from the asset registry and drops the map. */
+	void Shutdown();
+
+	/**
+	 * Collects the Blueprint classes derived from a class, directly or through other Blueprints.
+	 *
+	 * @param ParentClassPath Native or Blueprint generated class to search from.
+	 * @param OutDerived Receives the generated class path of every descendant, parents before their children.
+	 */
+	void GetDerivedClassPaths(const FTopLevelAssetPath& ParentClassPath, TArray<FTopLevelAssetPath>& OutDerived);
+
+	/**
+	 * Collects the Blueprint classes a class derives from, stopping at the first native class.
+	 *
+	 * @param ClassPath Blueprint generated class to search from.
+	 * @param OutAncestors Receives the generated class path of every Blueprint ancestor, nearest parent first.
+	 */
+	void GetAncestorClassPaths(const FTopLevelAssetPath& ClassPath, TArray<FTopLevelAssetPath>& OutAncestors);
+
+	/** @return Generated class path of a Blueprint asset, invalid if the asset has no parent class tag. */
+	static FTopLevelAssetPath GetGeneratedClassPath(const FAssetData& AssetData);
+
+private:
+	void EnsureBuilt();
+	void AddAsset(const FAssetData& AssetData);
+	void RemoveClass(const FTopLevelAssetPath& ClassPath);
+
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnFilesLoaded();
+
+	/** @return Parent class path stored in the tags of a Blueprint asset. */
+	static FTopLevelAssetPath GetParentClassPath(const FAssetData& AssetData);
+
+	TMap<FTopLevelAssetPath, TArray<FTopLevelAssetPath>> ChildrenByParent;
+	TMap<FTopLevelAssetPath, FTopLevelAssetPath> ParentByClass;
+	TMap<FSoftObjectPath, FTopLevelAssetPath> ClassByAsset;
+
+	bool bIsBuilt = false;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle FilesLoadedHandle;
+};
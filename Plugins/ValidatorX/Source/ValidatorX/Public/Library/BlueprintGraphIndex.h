@@ -0,0 +1,215 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Library/GraphBoundsIndex.h"
+#include "Library/BlueprintGraphSnapshot.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class UEdGraphNode_Comment;
+class UK2Node_FunctionEntry;
+
+/** A node together with the graph it was found in. */
+struct FBlueprintGraphNodeRef
+{
+	UEdGraph* Graph = nullptr;
+	UEdGraphNode* Node = nullptr;
+};
+
+/** The first set node of a variable within a class chain, with the Blueprint it belongs to. */
+struct FBlueprintVariableSetSource
+{
+	UBlueprint* Blueprint = nullptr;
+	FBlueprintGraphNodeRef SetNode;
+};
+
+/**
+ * Facts about every graph of one Blueprint, gathered in a single walk over its nodes.
+ *
+ * Validators query the index instead of calling GetAllGraphs and casting every node themselves,
+ * so validating a Blueprint walks its graphs once no matter how many validators are enabled.
+ * Instances are immutable once built; get them through FBlueprintGraphIndexCache.
+ */
+struct VALIDATORX_API FBlueprintGraphIndex
+{
+	/** Every graph of the Blueprint, including collapsed sub graphs. */
+	TArray<UEdGraph*> Graphs;
+
+	/** Call function nodes, keyed by the called member name. */
+	TMap<FName, TArray<FBlueprintGraphNodeRef>> CallSitesByFunction;
+
+	/** Macro instance nodes, keyed by the instanced macro graph. */
+	TMap<const UEdGraph*, TArray<FBlueprintGraphNodeRef>> MacroInstancesByGraph;
+
+	/** Call function and macro instance nodes of each graph, in node order. */
+	TMap<const UEdGraph*, TArray<UEdGraphNode*>> CallNodesByGraph;
+
+	/** Variable get nodes, keyed by variable name. */
+	TMap<FName, TArray<FBlueprintGraphNodeRef>> VariableGets;
+
+	/** Variable set nodes, keyed by variable name. */
+	TMap<FName, TArray<FBlueprintGraphNodeRef>> VariableSets;
+
+	/** Delegate properties that are bound, unbound, assigned or called anywhere in the Blueprint. */
+	TSet<FName> DelegateUsages;
+
+	/** Branch nodes of every graph. */
+	TArray<FBlueprintGraphNodeRef> Branches;
+
+	/** Comment boxes of every graph that has any. */
+	TMap<const UEdGraph*, TArray<UEdGraphNode_Comment*>> CommentsByGraph;
+
+	/** Bounds of the comment boxes of every graph that has any, indexed in the order of CommentsByGraph. */
+	TMap<const UEdGraph*, FGraphBoundsIndex> CommentBoundsByGraph;
+
+	/** Entry node of every function graph. */
+	TMap<const UEdGraph*, UK2Node_FunctionEntry*> FunctionEntries;
+
+	/** Nodes of each graph besides function entry/result nodes and the entry/exit tunnels of macros and collapsed graphs. */
+	TMap<const UEdGraph*, int32> CodeNodeCounts;
+
+	/** Total number of nodes visited while building the index. */
+	int32 NumNodes = 0;
+
+	/**
+	 * @param FunctionName Member name of the function.
+	 * @param IgnoredGraph Calls made from this graph do not count, e.g. recursive calls of the function itself.
+	 * @return True if any graph calls the function.
+	 */
+	bool IsFunctionCalled(FName FunctionName, const UEdGraph* IgnoredGraph = nullptr) const;
+
+	/**
+	 * @param MacroGraph Macro to look for.
+	 * @param IgnoredGraph Instances placed in this graph do not count.
+	 * @return True if any graph instances the macro.
+	 */
+	bool IsMacroInstanced(const UEdGraph* MacroGraph, const UEdGraph* IgnoredGraph = nullptr) const;
+
+	/** @return True if the variable is read or written in any graph. */
+	bool IsVariableUsed(FName VarName) const;
+
+	/** @return True if the variable is read or written inside the given graph. */
+	bool IsVariableUsedInGraph(FName VarName, const UEdGraph* Graph) const;
+
+	/** @return Comment boxes of the graph, empty if it has none. */
+	const TArray<UEdGraphNode_Comment*>& GetComments(const UEdGraph* Graph) const;
+
+	/** @return True if the position of the node lies inside one of the comment boxes of the graph, edges included. */
+	bool IsNodeInsideComment(const UEdGraph* Graph, const UEdGraphNode* Node) const;
+
+	/** @return Number of nodes in the graph besides function entry/result and entry/exit tunnel nodes. */
+	int32 GetCodeNodeCount(const UEdGraph* Graph) const;
+
+	/**
+	 * Walks every graph of the Blueprint once and collects the facts.
+	 *
+	 * @param Blueprint Blueprint to index. Must not be null.
+	 */
+	static TSharedRef<const FBlueprintGraphIndex> Build(UBlueprint* Blueprint);
+};
+
+/**
+ * Graph indices and snapshots of the Blueprints validated so far, the functions called by their descendants
+ * and the variables written by their ancestors.
+ *
+ * An index stays valid until its Blueprint changes: any Modify() on the Blueprint or on one of its
+ * graphs and nodes, a compile, or an undo/redo drops it and the next query rebuilds it. A change to
+ * a Blueprint also drops every merged set it was part of, so compiling a child refreshes the descendant
+ * call sets of its parents and compiling a parent refreshes the variable write sets of its children.
+ * All methods must be called on the game thread.
+ */
+class VALIDATORX_API FBlueprintGraphIndexCache
+{
+	FBlueprintGraphIndexCache() {}
+	FBlueprintGraphIndexCache(const FBlueprintGraphIndexCache&) = delete;
+	FBlueprintGraphIndexCache& operator=(const FBlueprintGraphIndexCache&) = delete;
+
+public:
+	static FBlueprintGraphIndexCache& Get()
+	{
+		static FBlueprintGraphIndexCache Instance;
+		return Instance;
+	}
+
+	/** Subscribes to the editor events that invalidate cached indices. */
+	void Initialize();
+
+	/** Unsubscribes from the editor events and drops every cached index. */
+	void Shutdown();
+
+	/**
+	 * @param Blueprint Blueprint to query. Must not be null.
+	 * @return Cached index of the Blueprint, built on the first query after a change.
+	 */
+	TSharedRef<const FBlueprintGraphIndex> FindOrBuild(UBlueprint* Blueprint);
+
+	/**
+	 * @param Blueprint Blueprint to query. Must not be null.
+	 * @return Cached snapshot of the Blueprint graphs, captured on the first query after a change.
+	 */
+	TSharedRef<const FBlueprintGraphSnapshot> FindOrCaptureSnapshot(UBlueprint* Blueprint);
+
+	/**
+	 * Member names called from any graph of any Blueprint derived from the given one.
+	 *
+	 * The set is the union of the graph indices of the whole descendant family, built once, so checking
+	 * whether a child calls a function is a single lookup.
+	 *
+	 * @param Blueprint Blueprint whose descendants are gathered. Must not be null.
+	 * @return Cached call set, built on the first query after a change in the family.
+	 */
+	TSharedRef<const TSet<FName>> FindOrBuildDescendantCalls(UBlueprint* Blueprint);
+
+	/**
+	 * Variables set from any graph of the Blueprint or of any Blueprint it derives from, each with its first
+	 * set node, looking at the Blueprint before its ancestors.
+	 *
+	 * The map merges the map of the parent Blueprint, which is cached in turn, so siblings share the
+	 * walk of their common ancestors and checking whether a variable is ever written is a single lookup.
+	 *
+	 * @param Blueprint Blueprint whose class chain is gathered. Must not be null.
+	 * @return Cached write map, built on the first query after a change in the chain.
+	 */
+	TSharedRef<const TMap<FName, FBlueprintVariableSetSource>> FindOrBuildHierarchyVariableSets(UBlueprint* Blueprint);
+
+	/** Drops the cached index and snapshot of a Blueprint and the merged sets that depend on it. */
+	void Invalidate(const UBlueprint* Blueprint);
+
+	/** Drops every cached index and snapshot. */
+	void Reset();
+
+private:
+	void OnObjectModified(UObject* Object);
+	void OnBlueprintPreCompile(UBlueprint* Blueprint);
+
+	/** Names gathered from the graph indices of several Blueprints. */
+	struct FMergedNames
+	{
+		/** Blueprints whose graphs were merged into the set. */
+		TArray<TObjectKey<UBlueprint>> Members;
+
+		TSharedRef<const TSet<FName>> Names;
+	};
+
+	/** Variable set nodes gathered from the graph indices of a class chain. */
+	struct FMergedVariableSets
+	{
+		/** Blueprints whose graphs were merged into the map. */
+		TArray<TObjectKey<UBlueprint>> Members;
+
+		TSharedRef<const TMap<FName, FBlueprintVariableSetSource>> Sources;
+	};
+
+	TMap<TObjectKey<UBlueprint>, TSharedRef<const FBlueprintGraphIndex>> Indices;
+	TMap<TObjectKey<UBlueprint>, TSharedRef<const FBlueprintGraphSnapshot>> Snapshots;
+	TMap<TObjectKey<UBlueprint>, FMergedNames> DescendantCalls;
+	TMap<TObjectKey<UBlueprint>, FMergedVariableSets> HierarchyVariableSets;
+
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+	FDelegateHandle UndoRedoHandle;
+};
@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Logging/TokenizedMessage.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+
+/** What a snapshot node is, for the node classes the validators care about. */
+enum class EBlueprintSnapshotNodeKind : uint8
+{
+	Other,
+	FunctionEntry,
+	FunctionResult,
+	/** Entry or exit of a macro or collapsed graph, not a macro instance or composite. */
+	Tunnel,
+	Event,
+	CallFunction,
+	MacroInstance,
+	VariableGet,
+	VariableSet,
+	Delegate,
+	Branch,
+	Comment
+};
+
+/** Where a snapshot graph lives in its Blueprint. */
+enum class EBlueprintSnapshotGraphKind : uint8
+{
+	Ubergraph,
+	Function,
+	Macro,
+	DelegateSignature,
+	Intermediate,
+	/** Collapsed graphs and other graphs nested in the ones above. */
+	SubGraph
+};
+
+struct FBlueprintSnapshotPin
+{
+	FName Name;
+	FName Category;
+	EEdGraphPinDirection Direction = EGPD_Input;
+	FString DefaultValue;
+
+	/** Index of the owning node in the graph. */
+	int32 Node = INDEX_NONE;
+
+	/** Indices of the linked pins in the pins of the graph. */
+	TArray<int32> LinkedTo;
+};
+
+struct FBlueprintSnapshotNode
+{
+	EBlueprintSnapshotNodeKind Kind = EBlueprintSnapshotNodeKind::Other;
+	FName ClassName;
+
+	/** Called function, accessed variable or delegate, instanced macro graph or implemented event. */
+	FName MemberName;
+
+	/** True if the member belongs to the Blueprint itself or one of its parents. */
+	bool bIsSelfMember = false;
+
+	bool bIsPure = false;
+
+	/** Index of the graph holding the body of a collapsed node or of an instance of the Blueprint's own macro, INDEX_NONE otherwise. */
+	int32 BoundGraph = INDEX_NONE;
+
+	FIntPoint Position = FIntPoint::ZeroValue;
+
+	/** Size of comment boxes, zero for the other nodes. */
+	FIntPoint Size = FIntPoint::ZeroValue;
+
+	/** The pins of the node are Pins[FirstPin, FirstPin + NumPins) of the graph. */
+	int32 FirstPin = 0;
+	int32 NumPins = 0;
+
+	/** Node the snapshot was taken from. Only resolve it on the game thread. */
+	TWeakObjectPtr<UEdGraphNode> Source;
+};
+
+struct VALIDATORX_API FBlueprintSnapshotGraph
+{
+	FName Name;
+	EBlueprintSnapshotGraphKind Kind = EBlueprintSnapshotGraphKind::SubGraph;
+
+	/** Display name of the kind, as UBPUtilsNodeFunctionLibrary::GetGraphType returns it. */
+	FString TypeName;
+
+	TArray<FBlueprintSnapshotNode> Nodes;
+	TArray<FBlueprintSnapshotPin> Pins;
+
+	/** Graph the snapshot was taken from. Only resolve it on the game thread. */
+	TWeakObjectPtr<UEdGraph> Source;
+
+	TConstArrayView<FBlueprintSnapshotPin> GetPins(const FBlueprintSnapshotNode& Node) const
+	{
+		return MakeArrayView(Pins).Mid(Node.FirstPin, Node.NumPins);
+	}
+
+	/** @return Pin of the node with the given name, null if there is none. */
+	const FBlueprintSnapshotPin* FindPin(const FBlueprintSnapshotNode& Node, FName PinName) const;
+
+	/** @return Number of nodes besides function entry/result nodes and plain tunnels, like FBlueprintGraphIndex::GetCodeNodeCount. */
+	int32 GetCodeNodeCount() const;
+};
+
+/**
+ * Plain-data copy of every graph of one Blueprint: node kinds, pins and links, member references and positions.
+ *
+ * Capturing walks the live graphs once on the game thread. The snapshot never touches UObjects afterwards,
+ * so any number of snapshots can be analyzed in parallel on worker threads; only the Source pointers must
+ * wait until the results are back on the game thread. Instances are immutable once captured; get them
+ * through FBlueprintGraphIndexCache::FindOrCaptureSnapshot to share them between validators.
+ */
+struct VALIDATORX_API FBlueprintGraphSnapshot
+{
+	FName BlueprintName;
+
+	TArray<FBlueprintSnapshotGraph> Graphs;
+
+	/** Blueprint the snapshot was taken from. Only resolve it on the game thread. */
+	TWeakObjectPtr<UBlueprint> Blueprint;
+
+	/**
+	 * Copies the graphs of the Blueprint. Game thread only.
+	 *
+	 * @param InBlueprint Blueprint to copy. Must not be null.
+	 */
+	static TSharedRef<const FBlueprintGraphSnapshot> Capture(UBlueprint* InBlueprint);
+};
+
+/** A problem found by analyzing a snapshot, turned into a validation message back on the game thread. */
+struct FBlueprintSnapshotFinding
+{
+	EMessageSeverity::Type Severity = EMessageSeverity::Warning;
+	FText Text;
+
+	/** Label of the action jumping to the graph or node, no action if empty. */
+	FText JumpLabel;
+
+	/** Graph and node of the snapshot the finding is about, INDEX_NONE for the whole graph or Blueprint. */
+	int32 Graph = INDEX_NONE;
+	int32 Node = INDEX_NONE;
+};
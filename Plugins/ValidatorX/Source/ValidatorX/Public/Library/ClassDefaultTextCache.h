@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UBlueprint;
+class UClass;
+class FProperty;
+
+/**
+ * Default values of class properties exported as text, e.g. to compare them with pin defaults.
+ *
+ * Values are exported from the class default object on the first query and shared by every graph and
+ * Blueprint validated afterwards. The values of a class and of every class derived from it are dropped
+ * when it is compiled or its default object is modified, and everything is dropped on undo/redo.
+ * All methods must be called on the game thread.
+ */
+class VALIDATORX_API FClassDefaultTextCache
+{
+	FClassDefaultTextCache() {}
+	FClassDefaultTextCache(const FClassDefaultTextCache&) = delete;
+	FClassDefaultTextCache& operator=(const FClassDefaultTextCache&) = delete;
+
+public:
+	static FClassDefaultTextCache& Get()
+	{
+		static FClassDefaultTextCache Instance;
+		return Instance;
+	}
+
+	/** Subscribes to the editor events that invalidate cached values. */
+	void Initialize();
+
+	/** Unsubscribes from the editor events and drops every cached value. */
+	void Shutdown();
+
+	/**
+	 * @param Class     Class whose default object holds the value. Must not be null.
+	 * @param Property  Property of the class or one of its super classes. Must not be null.
+	 * @return Exported default value, empty if the class has no default object yet. Valid until the next call.
+	 */
+	const FString& FindOrExport(UClass* Class, const FProperty* Property);
+
+	/** Drops the values of a class and of the cached classes derived from it. */
+	void Invalidate(const UClass* Class);
+
+	/** Drops every cached value. */
+	void Reset();
+
+private:
+	void OnObjectModified(UObject* Object);
+	void OnBlueprintPreCompile(UBlueprint* Blueprint);
+
+	TMap<TObjectKey<UClass>, TMap<FName, FString>> DefaultTextsByClass;
+
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+	FDelegateHandle UndoRedoHandle;
+};
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Static index of axis aligned rectangles in graph space, e.g. the bounds of the comment boxes of a graph,
+ * answering which rectangles contain a point.
+ *
+ * The rectangles are stored in a segment tree over their X edges; every tree node keeps the Y ranges of the
+ * rectangles spanning it sorted by their minimum, with a running maximum. A point query visits one node per
+ * tree level and binary searches each, so it costs O(log² n) instead of a test against every rectangle.
+ * Rectangle edges count as inside. Build once, then query any number of times.
+ */
+struct VALIDATORX_API FGraphBoundsIndex
+{
+	/** Replaces the indexed rectangles. Query results refer to positions in this array. */
+	void Build(TArray<FBox2D> InBounds);
+
+	/** @return True if any rectangle contains the point. */
+	bool ContainsPoint(const FVector2D& Point) const;
+
+	/** Collects the positions of all the rectangles that contain the point, in no particular order. */
+	void FindContaining(const FVector2D& Point, TArray<int32>& OutBoundsIndices) const;
+
+	const TArray<FBox2D>& GetBounds() const
+	{
+		return Bounds;
+	}
+
+	int32 Num() const
+	{
+		return Bounds.Num();
+	}
+
+private:
+	struct FSpan
+	{
+		double MinY;
+		double MaxY;
+
+		/** Largest MaxY of this span and every span before it in the node. */
+		double RunningMaxY;
+
+		int32 BoundsIndex;
+	};
+
+	/** @return Tree node of the leaf holding the X coordinate, INDEX_NONE if it is outside all rectangles. */
+	int32 FindLeaf(double X) const;
+
+	/** @return Number of leading spans of the node whose MinY is not above Y. */
+	static int32 CountSpansStartingAtOrBelow(const TArray<FSpan>& Spans, double Y);
+
+	TArray<FBox2D> Bounds;
+
+	/** Distinct X edges, sorted. Leaf 2i is exactly Edges[i], leaf 2i+1 lies strictly between Edges[i] and Edges[i+1]. */
+	TArray<double> Edges;
+
+	/** Bottom-up segment tree: node 1 is the root, the children of node i are 2i and 2i+1, leaves start at NumLeaves. */
+	TArray<TArray<FSpan>> Nodes;
+	int32 NumLeaves = 0;
+};
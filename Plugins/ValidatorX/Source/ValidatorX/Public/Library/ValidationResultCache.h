@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+#include "Logging/TokenizedMessage.h"
+#include "Misc/DataValidation.h"
+
+class UBlueprintValidatorBase;
+struct FAssetData;
+
+/** A message reported by a validator, as stored in the validation cache. */
+struct FCachedValidationMessage
+{
+	EMessageSeverity::Type Severity = EMessageSeverity::Info;
+	FString Text;
+
+	/** Labels of the action tokens, e.g. "Jump to Node", in the order the validator added them. */
+	TArray<FString> ActionLabels;
+};
+
+/** Last result of one validator on one package. */
+struct FCachedValidationResult
+{
+	/** Hash of everything the result depends on, see FValidationResultCache::ComputeKey. */
+	FIoHash Key;
+	EDataValidationResult Result = EDataValidationResult::NotValidated;
+	TArray<FCachedValidationMessage> Messages;
+};
+
+/**
+ * Disk backed cache of validator results, so unchanged Blueprints are not validated again across editor sessions
+ * and commandlet runs.
+ *
+ * A result is keyed by the saved hash of the package, the saved hashes of the packages the validator declares as
+ * dependencies, and the validator class, version and config. Packages with unsaved changes are never cached.
+ * All methods must be called on the game thread.
+ */
+class VALIDATORX_API FValidationResultCache
+{
+	FValidationResultCache() {}
+	FValidationResultCache(const FValidationResultCache&) = delete;
+	FValidationResultCache& operator=(const FValidationResultCache&) = delete;
+
+public:
+	static FValidationResultCache& Get()
+	{
+		static FValidationResultCache Instance;
+		return Instance;
+	}
+
+	/** Enables or disables both lookups and stores. The cache is enabled by default. */
+	void SetEnabled(bool bEnabled)
+	{
+		bIsEnabled = bEnabled;
+	}
+
+	bool IsEnabled() const
+	{
+		return bIsEnabled;
+	}
+
+	/**
+	 * Computes the key a result of the validator on the asset is cached under.
+	 *
+	 * @return False if the result cannot be cached, e.g. the package has unsaved changes or the cache is disabled.
+	 */
+	bool ComputeKey(const UBlueprintValidatorBase& Validator, const FAssetData& AssetData, FIoHash& OutKey) const;
+
+	/** @return Cached result of the validator on the package, null if there is none for this key. */
+	const FCachedValidationResult* Find(FName PackageName, FName ValidatorName, const FIoHash& Key);
+
+	/** Stores a result along with the issues the validator reported for it. */
+	void Store(FName PackageName, FName ValidatorName, const FIoHash& Key, EDataValidationResult Result, TConstArrayView<FDataValidationContext::FIssue> Issues);
+
+	/**
+	 * Adds the cached messages to a validation context. Their action tokens validate the asset again when clicked
+	 * and run the matching action of the fresh message, so jump to and fix actions behave as they did originally.
+	 */
+	void Replay(UBlueprintValidatorBase& Validator, const FAssetData& AssetData, const FCachedValidationResult& Cached, FDataValidationContext& Context) const;
+
+	/** Writes the cache to disk if it changed since it was loaded. */
+	void Save();
+
+private:
+	void EnsureLoaded();
+
+	/**
+	 * Gets the saved hash of a package, zero if the package does not exist on disk.
+	 *
+	 * @return False if the package has unsaved changes, so its saved hash does not describe its content.
+	 */
+	static bool GetPackageHash(FName PackageName, FIoHash& OutHash);
+
+	static FString GetCacheFilePath();
+
+	TMap<FName, TMap<FName, FCachedValidationResult>> ResultsByPackage;
+
+	bool bIsEnabled = true;
+	bool bIsLoaded = false;
+	bool bIsDirty = false;
+};
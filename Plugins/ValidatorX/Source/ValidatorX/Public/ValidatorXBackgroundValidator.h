@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
+#include "AssetRegistry/AssetData.h"
+
+class UBlueprint;
+class UBlueprintValidatorBase;
+class UPackage;
+class FObjectPostSaveContext;
+class FTokenizedMessage;
+
+/**
+ * Validates Blueprints in the background after they are compiled in their editor or saved.
+ *
+ * Requests are coalesced per Blueprint and wait for a short quiet period, so repeated compiles validate once.
+ * Work runs on the core ticker one validator at a time within a per-frame time budget; a validator expected to
+ * overrun what is left of the budget waits for the next frame, and validators that are expensive or usually take
+ * longer than the whole budget when their result is not cached are left out. The messages of each validator are
+ * shown in the ValidatorX message log as soon as it finishes; the first result of a validation replaces the
+ * messages of the previous one. Only the validators enabled in the ValidatorX window run. Controlled by the
+ * ValidatorX.AutoValidate console variables.
+ */
+class VALIDATORX_API FValidatorXBackgroundValidator
+{
+	FValidatorXBackgroundValidator() {}
+	FValidatorXBackgroundValidator(const FValidatorXBackgroundValidator&) = delete;
+	FValidatorXBackgroundValidator& operator=(const FValidatorXBackgroundValidator&) = delete;
+
+public:
+	static FValidatorXBackgroundValidator& Get()
+	{
+		static FValidatorXBackgroundValidator Instance;
+		return Instance;
+	}
+
+	static const FName MessageLogName;
+
+	/** Registers the message log listing and subscribes to compile and save events. Does nothing in commandlets. */
+	void Initialize();
+
+	/** Unsubscribes from all events and drops queued work. */
+	void Shutdown();
+
+	/** Queues a Blueprint, or postpones it if it is already queued. */
+	void Enqueue(UBlueprint* Blueprint);
+
+private:
+	/** A Blueprint being validated, one validator per step. */
+	struct FActiveValidation
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+
+		/** Registry view of the Blueprint, captured when its validation starts. */
+		FAssetData AssetData;
+
+		TArray<TWeakObjectPtr<UBlueprintValidatorBase>> Validators;
+		int32 NextValidator = 0;
+		double StartTime = 0.0;
+
+		/** Set once a validator produced a result and the messages of the previous validation were dropped. */
+		bool bHasReplacedMessages = false;
+
+		int32 NumMessages = 0;
+	};
+
+	bool Tick(float DeltaTime);
+
+	/** @return False if no queued Blueprint is due yet. */
+	bool StartNextDue(double Now);
+
+	/** Runs the next validator of the active Blueprint and publishes its messages, or ends the validation once all ran. */
+	void RunNextValidator();
+
+	/**
+	 * @param bIsFirstInFrame True if nothing ran in this frame yet, validators never measured only run then.
+	 * @return False if the next validator of the active Blueprint usually takes longer than the given time when its result is not cached.
+	 */
+	bool CanRunNextValidatorWithin(double Seconds, bool bIsFirstInFrame) const;
+
+	/** Replaces the message log content with the messages of every validated Blueprint, in one update. */
+	void PublishMessages();
+
+	void OnBlueprintPreCompile(UBlueprint* Blueprint);
+	void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+
+	/** Queued Blueprints and the time they become due. */
+	TMap<TObjectKey<UBlueprint>, double> DueTimes;
+
+	TOptional<FActiveValidation> Active;
+
+	/** Messages of the latest validation of each Blueprint, what the message log shows. */
+	TMap<TObjectKey<UBlueprint>, TArray<TSharedRef<FTokenizedMessage>>> MessagesByBlueprint;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+	FDelegateHandle PackageSavedHandle;
+};
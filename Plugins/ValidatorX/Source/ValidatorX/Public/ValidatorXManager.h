@@ -34,6 +34,16 @@ public:
 		return Validators;
 	}
 
+	/** Clears the timing and counters of every registered validator. */
+	void ResetStats();
+
+	/**
+	 * Writes the timing and counters of every registered validator as CSV, one row per validator.
+	 *
+	 * @return False if the file could not be written.
+	 */
+	bool ExportStatsToCsv(const FString& FileName) const;
+
 private:
 	TArray<TWeakObjectPtr<UBlueprintValidatorBase>> Validators;
 
@@ -45,12 +45,15 @@ public:
 	 * @param Context       Validation context for reporting issues
 	 * @return EDataValidationResult::Passed if valid, Failed/Invalid otherwise
 	 */
-	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+	virtual EDataValidationResult ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+
+	/** Calls from the Blueprints in a dependency cycle with this one can close a recursive cluster, so their packages are dependencies. */
+	virtual void GetCacheDependencies(const FAssetData& InAssetData, TArray<FName>& OutPackageNames) const override;
 
 
 private:
+	/** Reports every recursive cluster of the project call graph that one of the Blueprint's functions or macros belongs to. */
 	bool HasCircularDependency(UBlueprint* Blueprint, FDataValidationContext& Context);
-	bool DetectCycle(const FName& StartName, TMap<FName, TArray<FName>>& GraphMap, TSet<FName>& Visited, TSet<FName>& Stack, TArray<FName>& OutCyclePath);
 	UEdGraph* FindGraphByName(UBlueprint* Blueprint, const FName& GraphName);
 
 };
@@ -55,6 +55,6 @@ public:
 	 * @param Context       Validation context for reporting issues
 	 * @return EDataValidationResult::Passed if valid, Failed/Invalid otherwise
 	 */
-	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+	virtual EDataValidationResult ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
 
 };
@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "HardReferenceBudgetValidator.generated.h"
+
+/** Transitive hard package references of one package, gathered in a single walk of the asset registry. */
+struct FHardReferenceClosure
+{
+	FName PackageName;
+
+	/** Hard dependencies of the package itself, native packages excluded. */
+	TArray<FName> DirectReferences;
+
+	/** Every package of the closure, with the index in DirectReferences of the first direct reference it was reached through. */
+	TMap<FName, int32> Packages;
+};
+
+/**
+ * Measures what loading a Blueprint drags into memory: the transitive closure of its hard package references
+ * in the asset registry, in bytes on disk and in packages. Blueprints over the SizeBudgetMB or PackageBudget
+ * config budgets are flagged, with the direct references pulling in the most and what in the Blueprint
+ * creates them, e.g. a cast or an object variable that could be soft instead.
+ */
+UCLASS()
+class VALIDATORX_API UHardReferenceBudgetValidator : public UBlueprintValidatorBase
+{
+	GENERATED_BODY()
+
+public:
+	UHardReferenceBudgetValidator();
+
+	virtual void SetValidationEnabled(bool bEnabled) override
+	{
+		static UHardReferenceBudgetValidator* CDO = GetMutableDefault<UHardReferenceBudgetValidator>();
+		if(bIsConfigDisabled)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Validator is disabled by config!"));
+			return;
+		}
+
+		CDO->bIsEnabled = bEnabled;
+		SaveConfig();
+	}
+
+	virtual FString GetTypeValidator() const override
+	{
+		return TEXT("Performance");
+	}
+
+	/**
+	 * Checks if the validator is currently enabled.
+	 *
+	 * @return True if validation is active
+	 */
+	virtual bool IsEnabled() const override;
+
+	/**
+	 * Checks whether this validator can validate the given asset.
+	 *
+	 * @param InAssetData   Asset metadata (path, type, etc.)
+	 * @param InObject      Loaded asset object (null if not loaded)
+	 * @param InContext     Validation context for error/warning accumulation
+	 * @return True if this validator should process the asset
+	 */
+	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const override;
+
+	/**
+	 * Performs validation on a loaded asset.
+	 *
+	 * @param InAssetData   Asset metadata
+	 * @param InAsset       Loaded asset object
+	 * @param Context       Validation context for reporting issues
+	 * @return EDataValidationResult::Valid if valid, Invalid otherwise
+	 */
+	virtual EDataValidationResult ValidateBlueprintAsset(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+
+	/** Data-only Blueprints reference assets through their defaults too. */
+	virtual void GetAssetPrefilter(FValidatorAssetPrefilter& OutPrefilter) const override;
+
+	/** Walks the whole hard reference closure of the Blueprint through the asset registry. */
+	virtual bool IsExpensive() const override
+	{
+		return true;
+	}
+
+	/** Every package of the closure, a change in any of them can add or drop references. */
+	virtual void GetCacheDependencies(const FAssetData& InAssetData, TArray<FName>& OutPackageNames) const override;
+
+private:
+	/** Disk size in MB of the packages a Blueprint loads through hard references above which it is flagged. 0 disables the limit. */
+	UPROPERTY(Config, EditAnywhere, Category = "Budget", meta = (ClampMin = "0"))
+	float SizeBudgetMB = 64.0f;
+
+	/** Number of packages a Blueprint loads through hard references above which it is flagged. 0 disables the limit. */
+	UPROPERTY(Config, EditAnywhere, Category = "Budget", meta = (ClampMin = "0"))
+	int32 PackageBudget = 400;
+
+	/** Closure walked by the last GetCacheDependencies call, taken by the validation of the same package that follows it. */
+	mutable TSharedPtr<const FHardReferenceClosure> LastClosure;
+};
@@ -48,14 +48,17 @@ public:
 	 */
 	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const override;
 
+	virtual bool SupportsSnapshotAnalysis() const override
+	{
+		return true;
+	}
+
 	/**
-	 * Performs validation on a loaded asset.
+	 * Analyzes a snapshot of the Blueprint graphs, on any thread.
 	 *
-	 * @param InAssetData   Asset metadata
-	 * @param InAsset       Loaded asset object
-	 * @param Context       Validation context for reporting issues
-	 * @return EDataValidationResult::Passed if valid, Failed/Invalid otherwise
+	 * @param Snapshot      Graphs of the Blueprint
+	 * @param OutFindings   Problems found
 	 */
-	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+	virtual void AnalyzeSnapshot(const FBlueprintGraphSnapshot& Snapshot, TArray<FBlueprintSnapshotFinding>& OutFindings) const override;
 	
 };
@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "RepeatedPureEvaluationValidator.generated.h"
+
+/**
+ * Flags pure nodes whose result is read by several exec nodes. A pure node, and every pure node feeding it,
+ * runs again for each exec node reading its outputs, so an expensive getter wired to five nodes runs five times.
+ * Candidates are weighted by a rough cost of the whole pure subgraph and reported for caching in a local variable.
+ */
+UCLASS()
+class VALIDATORX_API URepeatedPureEvaluationValidator : public UBlueprintValidatorBase
+{
+	GENERATED_BODY()
+
+public:
+	URepeatedPureEvaluationValidator();
+
+	virtual void SetValidationEnabled(bool bEnabled) override
+	{
+		static URepeatedPureEvaluationValidator* CDO = GetMutableDefault<URepeatedPureEvaluationValidator>();
+		if(bIsConfigDisabled)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Validator is disabled by config!"));
+			return;
+		}
+
+		CDO->bIsEnabled = bEnabled;
+		SaveConfig();
+	}
+
+	virtual FString GetTypeValidator() const override
+	{
+		return TEXT("Performance");
+	}
+
+	/**
+	 * Checks if the validator is currently enabled.
+	 *
+	 * @return True if validation is active
+	 */
+	virtual bool IsEnabled() const override;
+
+	/**
+	 * Checks whether this validator can validate the given asset.
+	 *
+	 * @param InAssetData   Asset metadata (path, type, etc.)
+	 * @param InObject      Loaded asset object (null if not loaded)
+	 * @param InContext     Validation context for error/warning accumulation
+	 * @return True if this validator should process the asset
+	 */
+	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const override;
+
+	virtual bool SupportsSnapshotAnalysis() const override
+	{
+		return true;
+	}
+
+	/** Findings name nodes by their member instead of their title since the snapshot port. */
+	virtual int32 GetCacheVersion() const override
+	{
+		return 2;
+	}
+
+	/**
+	 * Analyzes a snapshot of the Blueprint graphs, on any thread.
+	 *
+	 * @param Snapshot      Graphs of the Blueprint
+	 * @param OutFindings   Problems found
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintGraphSnapshot& Snapshot, TArray<FBlueprintSnapshotFinding>& OutFindings) const override;
+};
@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "TickHotPathValidator.generated.h"
+
+/**
+ * Flags known-expensive nodes that run every frame: nodes reachable through exec links from Tick,
+ * animation update events and looping timers, following calls into the Blueprint's own functions and
+ * custom events. Each message carries a rough relative cost, multiplied when the node runs in a loop
+ * body, and the path that reaches it.
+ */
+UCLASS()
+class VALIDATORX_API UTickHotPathValidator : public UBlueprintValidatorBase
+{
+	GENERATED_BODY()
+
+public:
+	UTickHotPathValidator();
+
+	virtual void SetValidationEnabled(bool bEnabled) override
+	{
+		static UTickHotPathValidator* CDO = GetMutableDefault<UTickHotPathValidator>();
+		if(bIsConfigDisabled)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Validator is disabled by config!"));
+			return;
+		}
+
+		CDO->bIsEnabled = bEnabled;
+		SaveConfig();
+	}
+
+	virtual FString GetTypeValidator() const override
+	{
+		return TEXT("Performance");
+	}
+
+	/**
+	 * Checks if the validator is currently enabled.
+	 *
+	 * @return True if validation is active
+	 */
+	virtual bool IsEnabled() const override;
+
+	/**
+	 * Checks whether this validator can validate the given asset.
+	 *
+	 * @param InAssetData   Asset metadata (path, type, etc.)
+	 * @param InObject      Loaded asset object (null if not loaded)
+	 * @param InContext     Validation context for error/warning accumulation
+	 * @return True if this validator should process the asset
+	 */
+	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const override;
+
+	/** Only Blueprints deriving from classes with per-frame events: actors, components, anim instances and widgets. */
+	virtual void GetAssetPrefilter(FValidatorAssetPrefilter& OutPrefilter) const override;
+
+	virtual bool SupportsSnapshotAnalysis() const override
+	{
+		return true;
+	}
+
+	/** The walk enters collapsed graphs and the Blueprint's own macros since version 2. */
+	virtual int32 GetCacheVersion() const override
+	{
+		return 2;
+	}
+
+	/**
+	 * Analyzes a snapshot of the Blueprint graphs, on any thread.
+	 *
+	 * @param Snapshot      Graphs of the Blueprint
+	 * @param OutFindings   Problems found
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintGraphSnapshot& Snapshot, TArray<FBlueprintSnapshotFinding>& OutFindings) const override;
+};
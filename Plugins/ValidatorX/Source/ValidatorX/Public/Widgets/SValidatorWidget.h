@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SHeaderRow.h"
 
 class UBlueprintValidatorBase;
 /**
@@ -28,4 +29,21 @@ private:
 	FSlateFontInfo FontInfo;
 
 	TSharedRef<ITableRow> OnGenerateRowForList(TWeakObjectPtr<UBlueprintValidatorBase> InItem, const TSharedRef<STableViewBase>& OwnerTable);
+
+	/** Header column showing one of the counters of FValidatorXStats. */
+	SHeaderRow::FColumn::FArguments MakeStatColumn(const FName ColumnId, const FString& Label, const FString& ToolTip);
+
+	EColumnSortMode::Type GetColumnSortMode(const FName ColumnId) const;
+
+	/** Sorts the validators once by the clicked column; the stats keep updating in place afterwards. */
+	void OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type InSortMode);
+
+	/** Writes the stats of all validators to a timestamped CSV file in Saved/ValidatorX. */
+	FReply OnExportStatsClicked();
+
+	FReply OnResetStatsClicked();
+
+	FName SortColumn;
+
+	EColumnSortMode::Type SortMode = EColumnSortMode::None;
 };